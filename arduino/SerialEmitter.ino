@@ -2,17 +2,96 @@
  * @file SerialEmitter.ino
  * @brief Simula lecturas de sensores y las envía por el puerto serial.
  *
- * Formato de salida:
+ * Formato de texto (PROTOCOLO_BINARIO = 0):
  *   T-001,45.3
  *   P-105,82
  *
+ * Formato binario (PROTOCOLO_BINARIO = 1): tramas de ProtocoloBinario.h con
+ * varias lecturas cada una. Byte 0xA5, cantidad, secuencia (uint16), y por
+ * lectura id (uint16), tipo ('T' float / 'P' int32) y valor de 4 bytes, todo
+ * en little-endian, seguido del CRC-16/CCITT-FALSE. El host reconoce ambos
+ * formatos sin configuración.
+ *
  * Ajusta los identificadores para que coincidan con los creados en la aplicación C++.
  */
+#define PROTOCOLO_BINARIO 0
+
 const char* ID_TEMP = "T-001";
 const char* ID_PRES = "P-105";
+/// Parte numérica de los identificadores para el formato binario.
+const uint16_t NUM_TEMP = 1;
+const uint16_t NUM_PRES = 105;
 unsigned long ultimoEnvio = 0;
 const unsigned long intervaloMs = 2000;
 
+#if PROTOCOLO_BINARIO
+/// Lecturas que se agrupan antes de enviar una trama.
+const uint8_t LECTURAS_POR_TRAMA = 8;
+/// Espera máxima antes de enviar una trama incompleta.
+const unsigned long latenciaMaximaMs = 10000;
+
+uint8_t trama[4 + LECTURAS_POR_TRAMA * 7 + 2];
+uint8_t lecturasEnTrama = 0;
+uint16_t secuencia = 0;
+unsigned long inicioTrama = 0;
+
+uint16_t crc16(const uint8_t* datos, size_t cantidad)
+{
+  uint16_t crc = 0xFFFF;
+  for (size_t i = 0; i < cantidad; ++i)
+  {
+    crc ^= (uint16_t)datos[i] << 8;
+    for (uint8_t bit = 0; bit < 8; ++bit)
+    {
+      crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+    }
+  }
+  return crc;
+}
+
+void enviarTrama()
+{
+  if (lecturasEnTrama == 0)
+  {
+    return;
+  }
+
+  size_t longitud = 4 + lecturasEnTrama * 7;
+  trama[0] = 0xA5;
+  trama[1] = lecturasEnTrama;
+  trama[2] = secuencia & 0xFF;
+  trama[3] = secuencia >> 8;
+  uint16_t crc = crc16(trama + 1, longitud - 1);
+  trama[longitud] = crc & 0xFF;
+  trama[longitud + 1] = crc >> 8;
+  Serial.write(trama, longitud + 2);
+
+  ++secuencia;
+  lecturasEnTrama = 0;
+}
+
+/// Agrega una lectura; los 4 bytes del valor se copian tal cual (AVR y ARM son little-endian).
+void agregarLectura(uint16_t id, char tipo, const void* valor)
+{
+  if (lecturasEnTrama == 0)
+  {
+    inicioTrama = millis();
+  }
+
+  uint8_t* destino = trama + 4 + lecturasEnTrama * 7;
+  destino[0] = id & 0xFF;
+  destino[1] = id >> 8;
+  destino[2] = (uint8_t)tipo;
+  memcpy(destino + 3, valor, 4);
+  ++lecturasEnTrama;
+
+  if (lecturasEnTrama == LECTURAS_POR_TRAMA)
+  {
+    enviarTrama();
+  }
+}
+#endif
+
 void setup()
 {
   Serial.begin(9600);
@@ -27,6 +106,11 @@ void loop()
     float lecturaTemp = 40.0 + (random(-50, 50) / 10.0);
     int lecturaPres = 80 + random(-5, 6);
 
+#if PROTOCOLO_BINARIO
+    int32_t presion = lecturaPres;
+    agregarLectura(NUM_TEMP, 'T', &lecturaTemp);
+    agregarLectura(NUM_PRES, 'P', &presion);
+#else
     Serial.print(ID_TEMP);
     Serial.print(",");
     Serial.println(lecturaTemp, 1);
@@ -34,7 +118,15 @@ void loop()
     Serial.print(ID_PRES);
     Serial.print(",");
     Serial.println(lecturaPres);
+#endif
 
     ultimoEnvio = ahora;
   }
+
+#if PROTOCOLO_BINARIO
+  if (lecturasEnTrama > 0 && ahora - inicioTrama >= latenciaMaximaMs)
+  {
+    enviarTrama();
+  }
+#endif
 }
@@ -0,0 +1,254 @@
+/**
+ * @file BenchAgregadosSimd.cpp
+ * @brief Escenario agregados_simd: núcleos de ListaSensorContigua por nivel SIMD frente a recorrer ListaSensor.
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include "Escenarios.h"
+#include "MedicionBench.h"
+#include "AgregadosSimd.h"
+#include "ListaSensor.h"
+#include "ListaSensorContigua.h"
+
+namespace
+{
+/// Resultados de una pasada por los cuatro agregados.
+template <typename T>
+struct Agregados
+{
+    double suma = 0.0;
+    T minimo = T();
+    T maximo = T();
+    std::size_t mayores = 0;
+    double varianza = 0.0;
+};
+
+/// Nanosegundos por lectura de cada agregado.
+struct Tiempos
+{
+    double suma = 0.0;
+    double extremos = 0.0;
+    double conteo = 0.0;
+    double varianza = 0.0;
+};
+
+/// Lectura pseudoaleatoria reproducible en el rango típico de cada sensor.
+template <typename T>
+T generarLectura(unsigned int& semilla)
+{
+    semilla = semilla * 1103515245u + 12345u;
+    unsigned int azar = (semilla >> 8) % 100000u;
+    if (std::is_same<T, float>::value)
+    {
+        return static_cast<T>(static_cast<float>(azar) / 1000.0f);
+    }
+    return static_cast<T>(azar);
+}
+
+/// Umbral aproximadamente en el percentil 75 del rango generado.
+template <typename T>
+T umbralPrueba()
+{
+    return std::is_same<T, float>::value ? static_cast<T>(75.0f) : static_cast<T>(75000);
+}
+
+/// Agregados recorriendo los nodos de la lista enlazada (lo que ListaSensor puede hacer sin mantenerlos).
+template <typename T>
+Tiempos medirLista(const ListaSensor<T>& lista, long long repeticiones, Agregados<T>& resultado)
+{
+    double n = static_cast<double>(lista.contar());
+    Tiempos tiempos;
+    Cronometro cronometro;
+    for (long long r = 0; r < repeticiones; ++r)
+    {
+        double suma = 0.0;
+        for (Nodo<T>* nodo = lista.obtenerCabeza(); nodo; nodo = nodo->siguiente)
+        {
+            suma += static_cast<double>(nodo->dato);
+        }
+        resultado.suma = suma;
+    }
+    tiempos.suma = cronometro.segundos() * 1e9 / (n * repeticiones);
+
+    cronometro.reiniciar();
+    for (long long r = 0; r < repeticiones; ++r)
+    {
+        T minimo = lista.obtenerCabeza()->dato;
+        T maximo = minimo;
+        for (Nodo<T>* nodo = lista.obtenerCabeza(); nodo; nodo = nodo->siguiente)
+        {
+            minimo = (nodo->dato < minimo) ? nodo->dato : minimo;
+            maximo = (maximo < nodo->dato) ? nodo->dato : maximo;
+        }
+        resultado.minimo = minimo;
+        resultado.maximo = maximo;
+    }
+    tiempos.extremos = cronometro.segundos() * 1e9 / (n * repeticiones);
+
+    T umbral = umbralPrueba<T>();
+    cronometro.reiniciar();
+    for (long long r = 0; r < repeticiones; ++r)
+    {
+        std::size_t mayores = 0;
+        for (Nodo<T>* nodo = lista.obtenerCabeza(); nodo; nodo = nodo->siguiente)
+        {
+            mayores += (nodo->dato > umbral) ? 1 : 0;
+        }
+        resultado.mayores = mayores;
+    }
+    tiempos.conteo = cronometro.segundos() * 1e9 / (n * repeticiones);
+
+    cronometro.reiniciar();
+    for (long long r = 0; r < repeticiones; ++r)
+    {
+        double media = lista.promedio();
+        double total = 0.0;
+        for (Nodo<T>* nodo = lista.obtenerCabeza(); nodo; nodo = nodo->siguiente)
+        {
+            double desviacion = static_cast<double>(nodo->dato) - media;
+            total += desviacion * desviacion;
+        }
+        resultado.varianza = total / n;
+    }
+    tiempos.varianza = cronometro.segundos() * 1e9 / (n * repeticiones);
+    return tiempos;
+}
+
+/// Agregados de la lista contigua con el nivel SIMD activo.
+template <typename T>
+Tiempos medirContigua(const ListaSensorContigua<T>& lista, long long repeticiones, Agregados<T>& resultado)
+{
+    double n = static_cast<double>(lista.contar());
+    Tiempos tiempos;
+    Cronometro cronometro;
+    for (long long r = 0; r < repeticiones; ++r)
+    {
+        resultado.suma = lista.obtenerSuma();
+    }
+    tiempos.suma = cronometro.segundos() * 1e9 / (n * repeticiones);
+
+    cronometro.reiniciar();
+    for (long long r = 0; r < repeticiones; ++r)
+    {
+        lista.obtenerExtremos(resultado.minimo, resultado.maximo);
+    }
+    tiempos.extremos = cronometro.segundos() * 1e9 / (n * repeticiones);
+
+    T umbral = umbralPrueba<T>();
+    cronometro.reiniciar();
+    for (long long r = 0; r < repeticiones; ++r)
+    {
+        resultado.mayores = lista.contarMayoresQue(umbral);
+    }
+    tiempos.conteo = cronometro.segundos() * 1e9 / (n * repeticiones);
+
+    cronometro.reiniciar();
+    for (long long r = 0; r < repeticiones; ++r)
+    {
+        resultado.varianza = lista.varianza();
+    }
+    tiempos.varianza = cronometro.segundos() * 1e9 / (n * repeticiones);
+    return tiempos;
+}
+
+/// Compara con la referencia; las sumas de float toleran el cambio de orden de la suma.
+template <typename T>
+bool coinciden(const Agregados<T>& referencia, const Agregados<T>& otro)
+{
+    double tolerancia = std::is_same<T, float>::value ? 1e-9 : 0.0;
+    double escala = std::fabs(referencia.suma) + 1.0;
+    double escalaVarianza = std::fabs(referencia.varianza) + 1.0;
+    return std::fabs(referencia.suma - otro.suma) <= tolerancia * escala && referencia.minimo == otro.minimo &&
+           referencia.maximo == otro.maximo && referencia.mayores == otro.mayores &&
+           std::fabs(referencia.varianza - otro.varianza) <= (tolerancia + 1e-12) * escalaVarianza;
+}
+
+void imprimirFila(const char* tipo, long long cantidad, const char* implementacion, const Tiempos& tiempos,
+                  const Tiempos& base, bool correcto)
+{
+    std::printf("%-6s %11lld %-9s %9.3f %9.3f %9.3f %9.3f   x%-6.1f %s\n", tipo, cantidad, implementacion,
+                tiempos.suma, tiempos.extremos, tiempos.conteo, tiempos.varianza,
+                (base.suma + base.extremos + base.conteo + base.varianza) /
+                    (tiempos.suma + tiempos.extremos + tiempos.conteo + tiempos.varianza),
+                correcto ? "" : "DIFERENCIA");
+}
+
+/// Mide un tamaño: la lista enlazada y la contigua con cada nivel soportado.
+template <typename T>
+bool medirTamano(const char* tipo, long long cantidad, long long lecturasPorMedicion)
+{
+    long long repeticiones = lecturasPorMedicion / cantidad;
+    repeticiones = (repeticiones < 1) ? 1 : repeticiones;
+
+    Agregados<T> referencia;
+    Tiempos base;
+    {
+        ListaSensor<T> enlazada;
+        unsigned int semilla = 7u;
+        for (long long i = 0; i < cantidad; ++i)
+        {
+            enlazada.insertarAlFinal(generarLectura<T>(semilla));
+        }
+        base = medirLista(enlazada, repeticiones, referencia);
+    }
+    imprimirFila(tipo, cantidad, "lista", base, base, true);
+
+    ListaSensorContigua<T> contigua;
+    unsigned int semilla = 7u;
+    for (long long i = 0; i < cantidad; ++i)
+    {
+        contigua.insertarAlFinal(generarLectura<T>(semilla));
+    }
+
+    bool correcto = true;
+    NivelSimd niveles[] = {NivelSimd::Escalar, NivelSimd::Sse41, NivelSimd::Avx2};
+    for (NivelSimd nivel : niveles)
+    {
+        if (static_cast<int>(nivel) > static_cast<int>(AgregadosSimd::nivelDetectado()))
+        {
+            break;
+        }
+        AgregadosSimd::establecerNivel(nivel);
+        Agregados<T> resultado;
+        Tiempos tiempos = medirContigua(contigua, repeticiones, resultado);
+        bool coincide = coinciden(referencia, resultado);
+        correcto = correcto && coincide;
+        imprimirFila(tipo, cantidad, AgregadosSimd::nombreNivel(nivel), tiempos, base, coincide);
+    }
+    AgregadosSimd::establecerNivel(AgregadosSimd::nivelDetectado());
+    return correcto;
+}
+}
+
+int benchAgregadosSimd(int argc, char** argv)
+{
+    long long exponenteMinimo = leerOpcionEntera(argc, argv, "--exponente-min", 3);
+    long long exponenteMaximo = leerOpcionEntera(argc, argv, "--exponente-max", 7);
+    long long lecturasPorMedicion = leerOpcionEntera(argc, argv, "--lecturas-medicion", 50000000);
+    if (exponenteMinimo < 1 || exponenteMaximo < exponenteMinimo || exponenteMaximo > 9 || lecturasPorMedicion <= 0)
+    {
+        std::fprintf(stderr, "Se requiere 1 <= --exponente-min <= --exponente-max <= 9 y --lecturas-medicion positivo\n");
+        return 1;
+    }
+
+    std::printf("nivel detectado: %s   (ns por lectura; x = aceleracion total frente a la lista)\n",
+                AgregadosSimd::nombreNivel(AgregadosSimd::nivelDetectado()));
+    std::printf("%-6s %11s %-9s %9s %9s %9s %9s\n", "tipo", "lecturas", "impl", "suma", "min/max", "conteo",
+                "varianza");
+
+    bool correcto = true;
+    long long cantidad = 1;
+    for (long long e = 0; e < exponenteMinimo; ++e)
+    {
+        cantidad *= 10;
+    }
+    for (long long e = exponenteMinimo; e <= exponenteMaximo; ++e, cantidad *= 10)
+    {
+        correcto = medirTamano<float>("float", cantidad, lecturasPorMedicion) && correcto;
+        correcto = medirTamano<int>("int", cantidad, lecturasPorMedicion) && correcto;
+    }
+    std::printf("resultados iguales a la lista: %s\n", correcto ? "si" : "no");
+    return correcto ? 0 : 1;
+}
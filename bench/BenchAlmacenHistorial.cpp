@@ -0,0 +1,256 @@
+/**
+ * @file BenchAlmacenHistorial.cpp
+ * @brief Escenario almacen_historial: escritura en columnas mapeadas, reinicio perezoso y recuperación tras una caída.
+ */
+
+#include <csignal>
+#include <cstdio>
+#include <dirent.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "Escenarios.h"
+#include "MedicionBench.h"
+#include "AlmacenHistorial.h"
+#include "ColumnaPersistente.h"
+#include "ListaGeneral.h"
+#include "RegistroAsincrono.h"
+
+namespace
+{
+/// Borra la raíz del almacén de una corrida anterior (dos niveles: sensor y segmentos).
+void borrarAlmacen(const char* raiz)
+{
+    DIR* directorio = opendir(raiz);
+    if (!directorio)
+    {
+        return;
+    }
+    while (struct dirent* entrada = readdir(directorio))
+    {
+        if (entrada->d_name[0] == '.')
+        {
+            continue;
+        }
+        char sensor[512];
+        std::snprintf(sensor, sizeof(sensor), "%s/%s", raiz, entrada->d_name);
+        DIR* segmentos = opendir(sensor);
+        if (segmentos)
+        {
+            while (struct dirent* segmento = readdir(segmentos))
+            {
+                if (segmento->d_name[0] != '.')
+                {
+                    char ruta[800];
+                    std::snprintf(ruta, sizeof(ruta), "%s/%s", sensor, segmento->d_name);
+                    unlink(ruta);
+                }
+            }
+            closedir(segmentos);
+        }
+        rmdir(sensor);
+    }
+    closedir(directorio);
+    rmdir(raiz);
+}
+
+/// Valor sintético de la lectura i: temperaturas con un decimal y presiones enteras.
+float valorTemperatura(long long i)
+{
+    return static_cast<float>(i % 1000) / 10.0f;
+}
+
+int valorPresion(long long i)
+{
+    return static_cast<int>(i % 200000);
+}
+
+/// Nombre del sensor s; los pares son de temperatura y los impares de presión.
+void nombreSensor(long long s, char* destino, std::size_t tam)
+{
+    std::snprintf(destino, tam, "%c-%03lld", (s % 2 == 0) ? 'T' : 'P', s);
+}
+}
+
+int benchAlmacenHistorial(int argc, char** argv)
+{
+    long long lecturas = leerOpcionEntera(argc, argv, "--lecturas", 100000000);
+    long long sensores = leerOpcionEntera(argc, argv, "--sensores", 8);
+    long long lecturasCaida = leerOpcionEntera(argc, argv, "--lecturas-caida", 3000000);
+    const char* raiz = leerOpcionTexto(argc, argv, "--directorio", "/tmp/gestion_bench_almacen");
+    if (lecturas <= 0 || sensores < 2 || sensores > 1000 || lecturasCaida <= 0)
+    {
+        std::fprintf(stderr, "--lecturas y --lecturas-caida deben ser positivos y --sensores estar entre 2 y 1000\n");
+        return 1;
+    }
+
+    RegistroAsincrono& registro = RegistroAsincrono::instancia();
+    NivelLog nivelAnterior = registro.obtenerNivelMinimo();
+    registro.establecerNivelMinimo(NivelLog::Error);
+    borrarAlmacen(raiz);
+
+    std::printf("lecturas=%lld  sensores=%lld  directorio=%s\n", lecturas, sensores, raiz);
+    bool correcto = true;
+
+    // 1. Escritura: las lecturas se reparten por turnos entre las columnas de los sensores.
+    //    Se mide la columna sola; una lista en memoria de 100M lecturas no es lo que se evalúa aquí.
+    double sumaEscrita = 0.0;
+    {
+        AlmacenHistorial almacen;
+        if (!almacen.abrir(raiz))
+        {
+            return 1;
+        }
+        ColumnaPersistente** destinos = new ColumnaPersistente*[sensores];
+        char nombre[16];
+        for (long long s = 0; s < sensores; ++s)
+        {
+            nombreSensor(s, nombre, sizeof(nombre));
+            char ruta[256];
+            std::snprintf(ruta, sizeof(ruta), "%s/%s", raiz, nombre);
+            destinos[s] = new ColumnaPersistente();
+            correcto = destinos[s]->abrir(ruta, nombre, (s % 2 == 0) ? 'T' : 'P') && correcto;
+        }
+
+        std::int64_t marca = marcaTiempoActual();
+        Cronometro cronometro;
+        for (long long i = 0; i < lecturas; ++i)
+        {
+            long long s = i % sensores;
+            if (s % 2 == 0)
+            {
+                destinos[s]->agregar(valorTemperatura(i), marca + i);
+            }
+            else
+            {
+                destinos[s]->agregar(valorPresion(i), marca + i);
+            }
+        }
+        double segundosAnexo = cronometro.segundos();
+
+        cronometro.reiniciar();
+        for (long long s = 0; s < sensores; ++s)
+        {
+            correcto = destinos[s]->sincronizar() && correcto;
+        }
+        double segundosSincronia = cronometro.segundos();
+
+        double megabytes = static_cast<double>(lecturas) * 12.0 / 1e6;
+        std::printf("%-28s %10.3f s %12.2f Mlecturas/s %10.1f MB/s\n", "anexar (memoria mapeada)", segundosAnexo,
+                    lecturas / segundosAnexo / 1e6, megabytes / segundosAnexo);
+        std::printf("%-28s %10.3f s %12.2f Mlecturas/s %10.1f MB/s\n", "sincronizar (msync)", segundosSincronia,
+                    lecturas / segundosSincronia / 1e6, megabytes / segundosSincronia);
+
+        // Se suma por sensor, en el mismo orden en que se leerá después.
+        for (long long s = 0; s < sensores; ++s)
+        {
+            double sumaSensor = 0.0;
+            for (long long i = s; i < lecturas; i += sensores)
+            {
+                sumaSensor += (s % 2 == 0) ? static_cast<double>(valorTemperatura(i)) : valorPresion(i);
+            }
+            sumaEscrita += sumaSensor;
+        }
+        for (long long s = 0; s < sensores; ++s)
+        {
+            delete destinos[s];
+        }
+        delete[] destinos;
+    }
+
+    // 2. Reinicio: restaurar la lista solo abre y mapea; luego se leen todas las lecturas para comparar.
+    {
+        AlmacenHistorial almacen;
+        ListaGeneral lista;
+        almacen.abrir(raiz);
+        Cronometro cronometro;
+        int restaurados = almacen.restaurar(lista);
+        double segundosRestaurar = cronometro.segundos();
+
+        long long persistidas = 0;
+        double sumaLeida = 0.0;
+        cronometro.reiniciar();
+        char nombre[16];
+        for (long long s = 0; s < sensores; ++s)
+        {
+            nombreSensor(s, nombre, sizeof(nombre));
+            SensorBase* sensor = lista.buscarPorNombre(nombre);
+            if (!sensor)
+            {
+                correcto = false;
+                continue;
+            }
+            persistidas += static_cast<long long>(sensor->lecturasPersistidas());
+        }
+        // Mapear de nuevo en columnas propias evita cargar las listas en memoria.
+        for (long long s = 0; s < sensores; ++s)
+        {
+            nombreSensor(s, nombre, sizeof(nombre));
+            char ruta[256];
+            std::snprintf(ruta, sizeof(ruta), "%s/%s", raiz, nombre);
+            ColumnaPersistente columna;
+            columna.abrir(ruta, nombre, (s % 2 == 0) ? 'T' : 'P');
+            double sumaSensor = 0.0;
+            if (s % 2 == 0)
+            {
+                columna.recorrer<float>(0, columna.contar(), [&sumaSensor](std::int64_t, float valor)
+                {
+                    sumaSensor += valor;
+                });
+            }
+            else
+            {
+                columna.recorrer<int>(0, columna.contar(), [&sumaSensor](std::int64_t, int valor)
+                {
+                    sumaSensor += valor;
+                });
+            }
+            sumaLeida += sumaSensor;
+        }
+        double segundosLectura = cronometro.segundos();
+
+        correcto = correcto && restaurados == sensores && persistidas == lecturas && sumaLeida == sumaEscrita;
+        std::printf("%-28s %10.3f s   (%d sensores, %lld lecturas sin cargar)\n", "reinicio perezoso",
+                    segundosRestaurar, restaurados, persistidas);
+        std::printf("%-28s %10.3f s %12.2f Mlecturas/s   suma %s\n", "leer todas las lecturas", segundosLectura,
+                    lecturas / segundosLectura / 1e6, (sumaLeida == sumaEscrita) ? "igual" : "DISTINTA");
+        lista.liberar();
+    }
+
+    // 3. Caída: un proceso hijo anexa sin sincronizar y muere con SIGKILL.
+    {
+        char ruta[256];
+        std::snprintf(ruta, sizeof(ruta), "%s/caida", raiz);
+        std::fflush(stdout);
+        pid_t hijo = fork();
+        if (hijo == 0)
+        {
+            ColumnaPersistente columna;
+            if (!columna.abrir(ruta, "caida", 'P'))
+            {
+                _exit(1);
+            }
+            for (long long i = 0; i < lecturasCaida; ++i)
+            {
+                columna.agregar(valorPresion(i), 1 + i);
+            }
+            raise(SIGKILL);
+        }
+        int estado = 0;
+        waitpid(hijo, &estado, 0);
+
+        Cronometro cronometro;
+        ColumnaPersistente columna;
+        bool abierta = columna.abrir(ruta, "caida", 'P');
+        double segundosRecuperar = cronometro.segundos();
+        bool recuperadaCompleta = abierta && columna.contar() == static_cast<std::size_t>(lecturasCaida) &&
+                                  WIFSIGNALED(estado);
+        correcto = correcto && recuperadaCompleta;
+        std::printf("%-28s %10.3f s   (%zu de %lld lecturas tras SIGKILL)\n", "recuperar cola", segundosRecuperar,
+                    columna.contar(), lecturasCaida);
+    }
+
+    std::printf("historial persistente correcto: %s\n", correcto ? "si" : "no");
+    borrarAlmacen(raiz);
+    registro.establecerNivelMinimo(nivelAnterior);
+    return correcto ? 0 : 1;
+}
@@ -0,0 +1,181 @@
+/**
+ * @file BenchAnalisisLineas.cpp
+ * @brief Escenario analisis_lineas: compara el análisis con copias y atof/atoi contra vistas y from_chars.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+#include "Escenarios.h"
+#include "MedicionBench.h"
+#include "AnalizadorLineas.h"
+#include "LectorSerial.h"
+
+namespace
+{
+/// Corpus en memoria: líneas contiguas separadas por '\0' con su longitud.
+struct Corpus
+{
+    char* texto;
+    std::size_t* inicios;
+    std::size_t* longitudes;
+    long long lineas;
+};
+
+/// Genera lecturas T/P mezcladas con variantes de espacios y ~1 % de líneas malformadas.
+Corpus generarCorpus(long long lineas)
+{
+    static const char* const plantillas[] = {
+        "T-%03d,%d.%d", "P-%03d,%d", " T-%03d , %d.%d ", "P-%03d, %d", "T-%03d,\t-%d.%d", "P-%03d ,+%d",
+    };
+    static const char* const malformadas[] = {"T-001", ",45.3", "P-002,abc", "T-003,"};
+
+    Corpus corpus;
+    corpus.texto = new char[static_cast<std::size_t>(lineas) * 32];
+    corpus.inicios = new std::size_t[lineas];
+    corpus.longitudes = new std::size_t[lineas];
+    corpus.lineas = lineas;
+
+    unsigned int semilla = 12345u;
+    std::size_t posicion = 0;
+    for (long long i = 0; i < lineas; ++i)
+    {
+        semilla = semilla * 1103515245u + 12345u;
+        unsigned int azar = semilla >> 8;
+        char* destino = corpus.texto + posicion;
+        int escritos;
+        if (azar % 100 == 0)
+        {
+            escritos = std::snprintf(destino, 32, "%s", malformadas[(azar >> 7) % 4]);
+        }
+        else
+        {
+            int plantilla = static_cast<int>((azar >> 7) % 6);
+            escritos = std::snprintf(destino, 32, plantillas[plantilla], static_cast<int>(azar % 1000),
+                                     static_cast<int>((azar >> 10) % 200), static_cast<int>((azar >> 3) % 10));
+        }
+        corpus.inicios[i] = posicion;
+        corpus.longitudes[i] = static_cast<std::size_t>(escritos);
+        posicion += static_cast<std::size_t>(escritos) + 1;
+    }
+    return corpus;
+}
+
+void liberarCorpus(Corpus& corpus)
+{
+    delete[] corpus.texto;
+    delete[] corpus.inicios;
+    delete[] corpus.longitudes;
+}
+
+/// Ruta anterior: copia id y valor en buffers y convierte con atof/atoi.
+long long analizarConCopias(const Corpus& corpus, double& acumulado)
+{
+    long long validas = 0;
+    for (long long i = 0; i < corpus.lineas; ++i)
+    {
+        const char* linea = corpus.texto + corpus.inicios[i];
+        char id[TAM_ID];
+        char valor[40];
+        if (!descomponerLineaSerial(linea, id, TAM_ID, valor, sizeof(valor)))
+        {
+            continue;
+        }
+        acumulado += (id[0] == 'T') ? std::atof(valor) : std::atoi(valor);
+        ++validas;
+    }
+    return validas;
+}
+
+/// Ruta actual: vistas al buffer y conversión estricta con from_chars.
+long long analizarConVistas(const Corpus& corpus, double& acumulado)
+{
+    long long validas = 0;
+    for (long long i = 0; i < corpus.lineas; ++i)
+    {
+        LineaSerial campos;
+        if (!analizarLineaSerial(corpus.texto + corpus.inicios[i], corpus.longitudes[i], campos))
+        {
+            continue;
+        }
+        if (campos.id[0] == 'T')
+        {
+            float valor;
+            if (!convertirValor(campos.valor, valor))
+            {
+                continue;
+            }
+            acumulado += valor;
+        }
+        else
+        {
+            int valor;
+            if (!convertirValor(campos.valor, valor))
+            {
+                continue;
+            }
+            acumulado += valor;
+        }
+        ++validas;
+    }
+    return validas;
+}
+
+void imprimirResultado(const char* nombre, long long lineas, long long validas, double segundos, double acumulado)
+{
+    double lineasPorSegundo = (segundos > 0.0) ? lineas / segundos : 0.0;
+    std::printf("%-10s lineas=%lld  validas=%lld  tiempo=%.3f s  lineas/s=%.0f  (suma=%.1f)\n",
+                nombre, lineas, validas, segundos, lineasPorSegundo, acumulado);
+}
+}
+
+int benchAnalisisLineas(int argc, char** argv)
+{
+    long long lineas = leerOpcionEntera(argc, argv, "--lineas", 5000000);
+    long long repeticiones = leerOpcionEntera(argc, argv, "--repeticiones", 3);
+    if (lineas <= 0 || repeticiones <= 0)
+    {
+        std::fprintf(stderr, "--lineas y --repeticiones deben ser positivos\n");
+        return 1;
+    }
+
+    Corpus corpus = generarCorpus(lineas);
+
+    double mejorCopias = 0.0;
+    double mejorVistas = 0.0;
+    long long validasCopias = 0;
+    long long validasVistas = 0;
+    double sumaCopias = 0.0;
+    double sumaVistas = 0.0;
+    for (long long r = 0; r < repeticiones; ++r)
+    {
+        Cronometro cronometro;
+        sumaCopias = 0.0;
+        validasCopias = analizarConCopias(corpus, sumaCopias);
+        double segundos = cronometro.segundos();
+        if (r == 0 || segundos < mejorCopias)
+        {
+            mejorCopias = segundos;
+        }
+
+        cronometro.reiniciar();
+        sumaVistas = 0.0;
+        validasVistas = analizarConVistas(corpus, sumaVistas);
+        segundos = cronometro.segundos();
+        if (r == 0 || segundos < mejorVistas)
+        {
+            mejorVistas = segundos;
+        }
+    }
+
+    imprimirResultado("copias", lineas, validasCopias, mejorCopias, sumaCopias);
+    imprimirResultado("vistas", lineas, validasVistas, mejorVistas, sumaVistas);
+    if (mejorVistas > 0.0)
+    {
+        std::printf("aceleracion=%.2fx\n", mejorCopias / mejorVistas);
+    }
+
+    liberarCorpus(corpus);
+    return 0;
+}
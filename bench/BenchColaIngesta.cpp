@@ -0,0 +1,269 @@
+/**
+ * @file BenchColaIngesta.cpp
+ * @brief Escenario cola_ingesta: lectores que insertan directamente frente a lectores que publican en ColaIngesta.
+ *
+ * Cada puerto simulado es un pipe con un hilo emisor y un hilo lector con
+ * su propio MotorIngesta, como en la ingesta concurrente del menú. Se reporta
+ * cuánto tardan los lectores en vaciar sus puertos (lo que decide si el buffer
+ * del kernel se llena) y cuánto tarda la ingesta completa. Con la política
+ * Descartar se cuenta además cuántas lecturas se perdieron cuando el consumidor
+ * no alcanzó a los lectores.
+ */
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdint>
+#include <thread>
+#include <unistd.h>
+#include "Escenarios.h"
+#include "MedicionBench.h"
+#include "ColaIngesta.h"
+#include "ListaGeneral.h"
+#include "MotorIngesta.h"
+#include "RegistroAsincrono.h"
+#include "SensorPresion.h"
+#include "SensorTemperatura.h"
+
+namespace
+{
+/// Escribe las líneas del puerto en bloques y cierra el pipe al terminar.
+void emitirPuerto(int fd, int puerto, long long lineas)
+{
+    const long long lineasPorBloque = 1024;
+    char* bloque = new char[32 * lineasPorBloque];
+    long long enviadas = 0;
+    while (enviadas < lineas)
+    {
+        std::size_t usados = 0;
+        long long enBloque = 0;
+        while (enBloque < lineasPorBloque && enviadas + enBloque < lineas)
+        {
+            long long n = enviadas + enBloque;
+            int longitud = (n % 2 == 0) ? std::snprintf(bloque + usados, 32, "T-%03d,%lld.%lld\n", puerto, 20 + n % 15, n % 10)
+                                        : std::snprintf(bloque + usados, 32, "P-%03d,%lld\n", puerto, 900 + n % 200);
+            usados += static_cast<std::size_t>(longitud);
+            ++enBloque;
+        }
+
+        const char* cursor = bloque;
+        while (usados > 0)
+        {
+            ssize_t escritos = write(fd, cursor, usados);
+            if (escritos < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (escritos < 0)
+            {
+                enviadas = lineas;
+                break;
+            }
+            cursor += escritos;
+            usados -= static_cast<std::size_t>(escritos);
+        }
+        enviadas += enBloque;
+    }
+    close(fd);
+    delete[] bloque;
+}
+
+/// Opciones comunes a todas las corridas.
+struct Configuracion
+{
+    int puertos;
+    long long lineas;
+    std::size_t capacidad;
+};
+
+/// Lo que reporta cada corrida.
+struct Resultado
+{
+    bool valido = false;
+    double segundosLectores = 0.0;
+    double segundosTotal = 0.0;
+    long long registradas = 0;
+    std::uint64_t descartadas = 0;
+    std::uint64_t esperas = 0;
+    double loteMedio = 0.0;
+    double esperaP50 = 0.0;
+    double esperaP99 = 0.0;
+};
+
+/// Ingiere todos los puertos con inserción directa (cola == nullptr) o a través de la cola.
+Resultado ingerir(const Configuracion& configuracion, ColaIngesta* cola)
+{
+    Resultado resultado;
+    AuxiliarCli cli;
+    ListaGeneral lista;
+    char nombre[24];
+    int puertos = configuracion.puertos;
+    MotorIngesta** motores = new MotorIngesta*[puertos];
+    int* escritura = new int[puertos];
+    int abiertos = 0;
+    for (; abiertos < puertos; ++abiertos)
+    {
+        int extremos[2];
+        if (pipe(extremos) != 0)
+        {
+            break;
+        }
+        std::snprintf(nombre, sizeof(nombre), "T-%03d", abiertos);
+        lista.insertar(new SensorTemperatura(nombre));
+        std::snprintf(nombre, sizeof(nombre), "P-%03d", abiertos);
+        lista.insertar(new SensorPresion(nombre));
+
+        escritura[abiertos] = extremos[1];
+        motores[abiertos] = new MotorIngesta(lista, cli);
+        motores[abiertos]->establecerCola(cola);
+        std::snprintf(nombre, sizeof(nombre), "puerto-%d", abiertos);
+        motores[abiertos]->agregarDescriptor(extremos[0], nombre);
+    }
+
+    if (abiertos == puertos)
+    {
+        ConsumidorIngesta* consumidor = cola ? new ConsumidorIngesta(*cola) : nullptr;
+        if (consumidor && !consumidor->enEjecucion())
+        {
+            // Sin hilo consumidor nadie vaciaría la cola; se mide la inserción directa.
+            std::fprintf(stderr, "no se pudo crear el hilo consumidor; se inserta directamente\n");
+            delete consumidor;
+            consumidor = nullptr;
+            for (int i = 0; i < puertos; ++i)
+            {
+                motores[i]->establecerCola(nullptr);
+            }
+        }
+        // Sin cola varios lectores insertan a la vez; con cola solo el consumidor escribe en los sensores.
+        lista.establecerIngestaConcurrente(consumidor == nullptr);
+
+        std::thread* lectores = new std::thread[puertos];
+        std::thread* emisores = new std::thread[puertos];
+        Cronometro cronometro;
+        for (int i = 0; i < puertos; ++i)
+        {
+            MotorIngesta* motor = motores[i];
+            lectores[i] = std::thread([motor]() { motor->ejecutar(); });
+            emisores[i] = std::thread(emitirPuerto, escritura[i], i, configuracion.lineas);
+        }
+        for (int i = 0; i < puertos; ++i)
+        {
+            emisores[i].join();
+            lectores[i].join();
+        }
+        resultado.segundosLectores = cronometro.segundos();
+        if (consumidor)
+        {
+            consumidor->detener();
+        }
+        AuxiliarCli::sincronizar();
+        resultado.segundosTotal = cronometro.segundos();
+
+        if (consumidor)
+        {
+            resultado.registradas = static_cast<long long>(consumidor->obtenerRegistradas());
+            resultado.descartadas = cola->obtenerDescartadas();
+            resultado.esperas = cola->obtenerEsperas();
+            std::uint64_t lotes = consumidor->obtenerLotes();
+            resultado.loteMedio =
+                (lotes > 0) ? static_cast<double>(cola->obtenerPublicadas()) / static_cast<double>(lotes) : 0.0;
+            resultado.esperaP50 = static_cast<double>(consumidor->obtenerEsperaEnCola().percentil(50.0)) / 1e3;
+            resultado.esperaP99 = static_cast<double>(consumidor->obtenerEsperaEnCola().percentil(99.0)) / 1e3;
+            delete consumidor;
+        }
+        else
+        {
+            for (int i = 0; i < puertos; ++i)
+            {
+                resultado.registradas += motores[i]->obtenerLineasTotales();
+            }
+        }
+        resultado.valido = true;
+        delete[] lectores;
+        delete[] emisores;
+    }
+    else
+    {
+        for (int i = 0; i < abiertos; ++i)
+        {
+            close(escritura[i]);
+        }
+    }
+
+    for (int i = 0; i < abiertos; ++i)
+    {
+        delete motores[i];
+    }
+    delete[] motores;
+    delete[] escritura;
+    lista.establecerIngestaConcurrente(false);
+    lista.liberarEnBloque();
+    AuxiliarCli::sincronizar();
+    return resultado;
+}
+
+/**
+ * @brief Corre un modo con los logs silenciados e imprime su fila.
+ * @return true si cada línea se registró o, con Descartar, se registró o se contó como descartada.
+ */
+bool medirModo(const char* etiqueta, const Configuracion& configuracion, ColaIngesta* cola)
+{
+    RegistroAsincrono& registro = RegistroAsincrono::instancia();
+    NivelLog nivelAnterior = registro.obtenerNivelMinimo();
+    registro.establecerNivelMinimo(NivelLog::Error);
+    Resultado resultado;
+    {
+        RedireccionSalida descarte("/dev/null");
+        resultado = ingerir(configuracion, cola);
+    }
+    registro.establecerNivelMinimo(nivelAnterior);
+
+    if (!resultado.valido)
+    {
+        std::fprintf(stderr, "%s: no se pudieron crear los pipes\n", etiqueta);
+        return false;
+    }
+    long long esperadas = configuracion.lineas * configuracion.puertos;
+    bool completo = (resultado.registradas + static_cast<long long>(resultado.descartadas) == esperadas);
+    std::printf("%-18s %10.3f %10.3f %12.0f %9llu %11llu %8.1f %11.1f %11.1f   %s\n", etiqueta,
+                resultado.segundosLectores, resultado.segundosTotal,
+                static_cast<double>(resultado.registradas) / resultado.segundosTotal,
+                static_cast<unsigned long long>(resultado.esperas),
+                static_cast<unsigned long long>(resultado.descartadas), resultado.loteMedio, resultado.esperaP50,
+                resultado.esperaP99, completo ? "completo" : "INCOMPLETO");
+    return completo;
+}
+}
+
+int benchColaIngesta(int argc, char** argv)
+{
+    Configuracion configuracion;
+    configuracion.puertos = static_cast<int>(leerOpcionEntera(argc, argv, "--puertos", 4));
+    configuracion.lineas = leerOpcionEntera(argc, argv, "--lineas", 250000);
+    long long capacidad = leerOpcionEntera(argc, argv, "--capacidad", static_cast<long long>(ColaIngesta::CAPACIDAD_PREDETERMINADA));
+    if (configuracion.puertos <= 0 || configuracion.puertos > MotorIngesta::MAX_FUENTES || configuracion.lineas <= 0 ||
+        capacidad <= 0)
+    {
+        std::fprintf(stderr, "--puertos debe estar entre 1 y %d; --lineas y --capacidad deben ser positivos\n",
+                     MotorIngesta::MAX_FUENTES);
+        return 1;
+    }
+    configuracion.capacidad = static_cast<std::size_t>(capacidad);
+
+    std::printf("puertos=%d  lineas por puerto=%lld  capacidad de cola=%zu\n", configuracion.puertos,
+                configuracion.lineas, configuracion.capacidad);
+    std::printf("%-18s %10s %10s %12s %9s %11s %8s %11s %11s\n", "modo", "lectores_s", "total_s", "lecturas/s",
+                "esperas", "descartadas", "lote", "cola_p50_us", "cola_p99_us");
+
+    bool correcto = medirModo("directo", configuracion, nullptr);
+
+    ColaIngesta* esperando = new ColaIngesta(configuracion.capacidad, PoliticaCola::Esperar);
+    correcto = medirModo("cola (esperar)", configuracion, esperando) && correcto;
+    delete esperando;
+
+    ColaIngesta* descartando = new ColaIngesta(configuracion.capacidad, PoliticaCola::Descartar);
+    correcto = medirModo("cola (descartar)", configuracion, descartando) && correcto;
+    delete descartando;
+
+    std::printf("resultado: %s\n", correcto ? "correcto" : "FALLO");
+    return correcto ? 0 : 1;
+}
@@ -0,0 +1,196 @@
+/**
+ * @file BenchConsultasDesordenadas.cpp
+ * @brief Escenario consultas_desordenadas: resumirRango() cuando parte de las lecturas llega con marcas atrasadas.
+ *
+ * Una fracción de las lecturas llega con un retraso de hasta --retraso-ms y
+ * una de cada 100000 con una marca de cualquier momento anterior. Se mide
+ * el costo por consulta en historiales de tamaño creciente; si el índice
+ * recorriera la lista al ver una marca fuera de orden, el costo crecería en
+ * proporción a las lecturas. Con --lecturas chicas el ancho de la consulta,
+ * el retraso y la frecuencia de marcas arbitrarias se reducen para que el
+ * tamaño menor siga teniendo varias consultas y varias marcas arbitrarias.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include "Escenarios.h"
+#include "MedicionBench.h"
+#include "ListaSensor.h"
+
+namespace
+{
+/// Separación entre marcas consecutivas de las lecturas sintéticas (1 ms).
+constexpr std::int64_t PASO_NS = 1000000;
+/// Lecturas que abarca cada consulta (1 minuto) cuando el tamaño menor lo permite.
+constexpr long long LECTURAS_POR_CONSULTA = 60000;
+/// Cada cuántas lecturas llega una con una marca arbitrariamente vieja, salvo en tamaños chicos.
+constexpr long long PERIODO_MUY_ATRASADAS = 100000;
+/// Menor cantidad de lecturas del primer tamaño; por debajo no queda ni una consulta de dos lecturas.
+constexpr long long LECTURAS_MINIMAS = 16;
+
+/// Generador xorshift64 para marcas, valores e intervalos reproducibles.
+std::uint64_t siguienteAleatorio(std::uint64_t& estado)
+{
+    estado ^= estado << 13;
+    estado ^= estado >> 7;
+    estado ^= estado << 17;
+    return estado;
+}
+
+/// Opciones de la corrida.
+struct Configuracion
+{
+    long long consultas;
+    int porcentajeAtrasadas;
+    std::int64_t retrasoNs;
+    /// Ancho de cada consulta; a lo sumo un cuarto del tamaño menor.
+    std::int64_t anchoNs;
+    long long periodoMuyAtrasadas;
+};
+
+/// Llena la lista con lecturas de 1 ms; si desordenar, atrasa parte de las marcas.
+void llenar(ListaSensor<int>& lista, long long lecturas, bool desordenar, const Configuracion& configuracion,
+            std::uint64_t& estado)
+{
+    for (long long i = 0; i < lecturas; ++i)
+    {
+        std::int64_t marca = i * PASO_NS;
+        if (desordenar)
+        {
+            if (i > 0 && i % configuracion.periodoMuyAtrasadas == 0)
+            {
+                marca = static_cast<std::int64_t>(siguienteAleatorio(estado) % static_cast<std::uint64_t>(marca));
+            }
+            else if (static_cast<int>(siguienteAleatorio(estado) % 100) < configuracion.porcentajeAtrasadas)
+            {
+                marca -= static_cast<std::int64_t>(siguienteAleatorio(estado) %
+                                                   static_cast<std::uint64_t>(configuracion.retrasoNs));
+            }
+        }
+        lista.insertarAlFinal(static_cast<int>(siguienteAleatorio(estado) % 200000), marca);
+    }
+}
+
+/// Resumen de [desde, hasta) visitando cada nodo, como haría la lista sin índice.
+ResumenRango<int> resumirRecorriendo(const ListaSensor<int>& lista, std::int64_t desde, std::int64_t hasta)
+{
+    ResumenRango<int> resumen;
+    for (const Nodo<int>* actual = lista.obtenerCabeza(); actual; actual = actual->siguiente)
+    {
+        if (actual->marca >= desde && actual->marca < hasta)
+        {
+            resumen.agregar(actual->dato);
+        }
+    }
+    return resumen;
+}
+
+bool mismosResumenes(const ResumenRango<int>& a, const ResumenRango<int>& b)
+{
+    return a.cantidad == b.cantidad && a.suma == b.suma &&
+           (a.cantidad == 0 || (a.minimo == b.minimo && a.maximo == b.maximo));
+}
+
+/**
+ * @brief Microsegundos por consulta de anchoNs; compara una muestra con el recorrido completo.
+ * @param iguales Queda en false si algún resumen de la muestra difiere.
+ */
+double medirConsultas(const ListaSensor<int>& lista, long long lecturas, const Configuracion& configuracion,
+                      std::uint64_t& estado, bool& iguales)
+{
+    long long consultas = configuracion.consultas;
+    std::int64_t ancho = configuracion.anchoNs;
+    std::int64_t extension = lecturas * PASO_NS;
+    std::uint64_t margen = static_cast<std::uint64_t>(extension - ancho) + 1;
+    std::int64_t* inicios = new std::int64_t[consultas];
+    for (long long q = 0; q < consultas; ++q)
+    {
+        inicios[q] = static_cast<std::int64_t>(siguienteAleatorio(estado) % margen);
+    }
+
+    ResumenRango<int>* conIndice = new ResumenRango<int>[consultas];
+    Cronometro cronometro;
+    for (long long q = 0; q < consultas; ++q)
+    {
+        conIndice[q] = lista.resumirRango(inicios[q], inicios[q] + ancho);
+    }
+    double segundos = cronometro.segundos();
+
+    long long muestra = (consultas < 50) ? consultas : 50;
+    for (long long q = 0; q < muestra; ++q)
+    {
+        iguales = mismosResumenes(resumirRecorriendo(lista, inicios[q], inicios[q] + ancho), conIndice[q]) &&
+                  iguales;
+    }
+
+    delete[] inicios;
+    delete[] conIndice;
+    return segundos / static_cast<double>(consultas) * 1e6;
+}
+}
+
+int benchConsultasDesordenadas(int argc, char** argv)
+{
+    long long lecturasMax = leerOpcionEntera(argc, argv, "--lecturas", 4000000);
+    Configuracion configuracion;
+    configuracion.consultas = leerOpcionEntera(argc, argv, "--consultas", 20000);
+    configuracion.porcentajeAtrasadas = static_cast<int>(leerOpcionEntera(argc, argv, "--atrasadas", 5));
+    configuracion.retrasoNs = leerOpcionEntera(argc, argv, "--retraso-ms", 500) * PASO_NS;
+    if (lecturasMax / 16 < LECTURAS_MINIMAS || configuracion.consultas <= 0 ||
+        configuracion.porcentajeAtrasadas < 0 || configuracion.porcentajeAtrasadas > 100 ||
+        configuracion.retrasoNs <= 0)
+    {
+        std::fprintf(stderr, "--lecturas debe ser al menos %lld, --consultas y --retraso-ms positivos y "
+                             "--atrasadas entre 0 y 100\n",
+                     16 * LECTURAS_MINIMAS);
+        return 1;
+    }
+
+    // El tamaño menor debe contener al menos cuatro consultas y dos marcas arbitrarias; si no, se escalan.
+    long long menor = lecturasMax / 16;
+    long long lecturasPorConsulta = (menor / 4 < LECTURAS_POR_CONSULTA) ? menor / 4 : LECTURAS_POR_CONSULTA;
+    configuracion.anchoNs = lecturasPorConsulta * PASO_NS;
+    configuracion.periodoMuyAtrasadas = (menor / 2 < PERIODO_MUY_ATRASADAS) ? menor / 2 : PERIODO_MUY_ATRASADAS;
+    if (configuracion.retrasoNs > configuracion.anchoNs)
+    {
+        configuracion.retrasoNs = configuracion.anchoNs;
+    }
+
+    std::printf("consultas=%lld de %lld ms  atrasadas=%d%% hasta %lld ms  una de cada %lld con marca arbitraria\n",
+                configuracion.consultas, lecturasPorConsulta, configuracion.porcentajeAtrasadas,
+                static_cast<long long>(configuracion.retrasoNs / PASO_NS), configuracion.periodoMuyAtrasadas);
+    std::printf("%-10s %14s %16s   %s\n", "lecturas", "ordenadas (us)", "desordenadas (us)", "resultado");
+
+    std::uint64_t estado = 0x9E3779B97F4A7C15ULL;
+    bool iguales = true;
+    double primera = 0.0;
+    double ultima = 0.0;
+    const long long tamanos[] = {lecturasMax / 16, lecturasMax / 4, lecturasMax};
+    for (long long lecturas : tamanos)
+    {
+        bool igualesTamano = true;
+        ListaSensor<int> ordenada;
+        llenar(ordenada, lecturas, false, configuracion, estado);
+        double microsOrdenada = medirConsultas(ordenada, lecturas, configuracion, estado, igualesTamano);
+        ordenada.limpiar();
+
+        ListaSensor<int> desordenada;
+        llenar(desordenada, lecturas, true, configuracion, estado);
+        double microsDesordenada =
+            medirConsultas(desordenada, lecturas, configuracion, estado, igualesTamano);
+
+        std::printf("%-10lld %14.2f %16.2f   %s\n", lecturas, microsOrdenada, microsDesordenada,
+                    igualesTamano ? "igual" : "DISTINTO");
+        iguales = iguales && igualesTamano;
+        primera = (lecturas == tamanos[0]) ? microsDesordenada : primera;
+        ultima = microsDesordenada;
+    }
+
+    // Recorrer la lista haría crecer el costo 16 veces entre el primer y el último tamaño.
+    double crecimiento = (primera > 0.0) ? ultima / primera : 0.0;
+    bool sublineal = crecimiento < 8.0;
+    std::printf("\ncrecimiento del costo con 16x lecturas: %.2fx (%s)\n", crecimiento,
+                sublineal ? "sublineal" : "LINEAL");
+    std::printf("consultas por intervalo correctas: %s\n", iguales ? "si" : "no");
+    return (iguales && sublineal) ? 0 : 1;
+}
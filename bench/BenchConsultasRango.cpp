@@ -0,0 +1,172 @@
+/**
+ * @file BenchConsultasRango.cpp
+ * @brief Escenario consultas_rango: resumirRango() con índice temporal frente a recorrer la lista.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include "Escenarios.h"
+#include "MedicionBench.h"
+#include "ListaSensor.h"
+
+namespace
+{
+/// Separación entre marcas consecutivas de las lecturas sintéticas (1 ms).
+constexpr std::int64_t PASO_NS = 1000000;
+
+/// Generador xorshift64 para intervalos y valores reproducibles.
+std::uint64_t siguienteAleatorio(std::uint64_t& estado)
+{
+    estado ^= estado << 13;
+    estado ^= estado >> 7;
+    estado ^= estado << 17;
+    return estado;
+}
+
+/// Resumen de [desde, hasta) visitando cada nodo, como haría la lista sin índice.
+ResumenRango<int> resumirRecorriendo(const ListaSensor<int>& lista, std::int64_t desde, std::int64_t hasta)
+{
+    ResumenRango<int> resumen;
+    for (const Nodo<int>* actual = lista.obtenerCabeza(); actual; actual = actual->siguiente)
+    {
+        if (actual->marca >= desde && actual->marca < hasta)
+        {
+            resumen.agregar(actual->dato);
+        }
+    }
+    return resumen;
+}
+
+bool mismosResumenes(const ResumenRango<int>& a, const ResumenRango<int>& b)
+{
+    return a.cantidad == b.cantidad && a.suma == b.suma &&
+           (a.cantidad == 0 || (a.minimo == b.minimo && a.maximo == b.maximo));
+}
+
+/**
+ * @brief Mide consultas de un ancho dado con ambos métodos y compara sus resultados.
+ * @return false si algún resumen difiere.
+ */
+bool medirAncho(const char* etiqueta, const ListaSensor<int>& lista, std::int64_t extension, std::int64_t ancho,
+                long long consultas, std::uint64_t& estado)
+{
+    std::int64_t* inicios = new std::int64_t[consultas];
+    for (long long q = 0; q < consultas; ++q)
+    {
+        std::uint64_t margen = static_cast<std::uint64_t>(extension - ancho) + 1;
+        inicios[q] = static_cast<std::int64_t>(siguienteAleatorio(estado) % margen);
+    }
+
+    ResumenRango<int>* conIndice = new ResumenRango<int>[consultas];
+    Cronometro cronometro;
+    for (long long q = 0; q < consultas; ++q)
+    {
+        conIndice[q] = lista.resumirRango(inicios[q], inicios[q] + ancho);
+    }
+    double segundosIndice = cronometro.segundos();
+
+    // Recorrer la lista completa es lento; se mide y se compara en una muestra de las consultas.
+    long long muestra = (consultas < 200) ? consultas : 200;
+    bool iguales = true;
+    cronometro.reiniciar();
+    for (long long q = 0; q < muestra; ++q)
+    {
+        ResumenRango<int> recorrido = resumirRecorriendo(lista, inicios[q], inicios[q] + ancho);
+        iguales = iguales && mismosResumenes(recorrido, conIndice[q]);
+    }
+    double segundosRecorrido = cronometro.segundos();
+
+    double microsIndice = segundosIndice / static_cast<double>(consultas) * 1e6;
+    double microsRecorrido = segundosRecorrido / static_cast<double>(muestra) * 1e6;
+    std::printf("%-22s %12.2f %14.2f %11.0fx   %s\n", etiqueta, microsIndice, microsRecorrido,
+                (microsIndice > 0.0) ? microsRecorrido / microsIndice : 0.0, iguales ? "igual" : "DISTINTO");
+
+    delete[] inicios;
+    delete[] conIndice;
+    return iguales;
+}
+
+/// Recorre los anchos de consulta sobre el estado actual de la lista.
+bool medirAnchos(const ListaSensor<int>& lista, std::int64_t extension, long long consultas, std::uint64_t& estado)
+{
+    struct Ancho
+    {
+        const char* etiqueta;
+        std::int64_t nanosegundos;
+    };
+    const Ancho anchos[] = {
+        {"1 s", 1000 * PASO_NS},
+        {"5 min", 300000 * PASO_NS},
+        {"mitad del historial", extension / 2},
+        {"historial completo", extension},
+    };
+
+    bool correcto = true;
+    std::printf("%-22s %12s %14s %12s\n", "ancho", "indice (us)", "recorrer (us)", "aceleracion");
+    for (const Ancho& ancho : anchos)
+    {
+        if (ancho.nanosegundos <= extension)
+        {
+            correcto = medirAncho(ancho.etiqueta, lista, extension, ancho.nanosegundos, consultas, estado) && correcto;
+        }
+    }
+    return correcto;
+}
+}
+
+int benchConsultasRango(int argc, char** argv)
+{
+    long long lecturas = leerOpcionEntera(argc, argv, "--lecturas", 4000000);
+    long long consultas = leerOpcionEntera(argc, argv, "--consultas", 100000);
+    if (lecturas < 2 || consultas <= 0)
+    {
+        std::fprintf(stderr, "--lecturas debe ser al menos 2 y --consultas positivo\n");
+        return 1;
+    }
+
+    std::uint64_t estado = 0x9E3779B97F4A7C15ULL;
+    std::int64_t extension = lecturas * PASO_NS;
+    ListaSensor<int> lista;
+    Cronometro cronometro;
+    for (long long i = 0; i < lecturas; ++i)
+    {
+        lista.insertarAlFinal(static_cast<int>(siguienteAleatorio(estado) % 200000), i * PASO_NS);
+    }
+    std::printf("lecturas=%lld  consultas=%lld  (una lectura por ms)\n", lecturas, consultas);
+    std::printf("insertar con marca e indice: %.3f s\n\n", cronometro.segundos());
+
+    bool correcto = medirAnchos(lista, extension, consultas, estado);
+
+    // Bajas: la cabeza y lecturas intermedias (incluidos extremos) dejan tramos con huecos.
+    int valor = 0;
+    for (long long i = 0; i < lecturas / 100; ++i)
+    {
+        lista.extraerPrimero(valor);
+    }
+    for (int i = 0; i < 50; ++i)
+    {
+        int minimo = 0;
+        int maximo = 0;
+        lista.obtenerMinimo(minimo);
+        lista.obtenerMaximo(maximo);
+        lista.eliminarPrimeraCoincidencia(minimo);
+        lista.eliminarPrimeraCoincidencia(maximo);
+    }
+    std::printf("\ntras %lld bajas:\n", lecturas / 100 + 100);
+    correcto = medirAnchos(lista, extension, consultas, estado) && correcto;
+
+    // Empalme al inicio: el índice se invalida y la primera consulta lo rehace.
+    ListaSensor<int> anteriores;
+    for (long long i = 0; i < lecturas / 100; ++i)
+    {
+        anteriores.insertarAlFinal(static_cast<int>(siguienteAleatorio(estado) % 200000), i * PASO_NS);
+    }
+    lista.empalmarDespues(nullptr, anteriores);
+    cronometro.reiniciar();
+    lista.resumirRango(0, 1);
+    std::printf("\ntras empalmar al inicio: reconstruir indice %.3f s\n", cronometro.segundos());
+    correcto = medirAnchos(lista, extension, consultas, estado) && correcto;
+
+    std::printf("\nconsultas por intervalo correctas: %s\n", correcto ? "si" : "no");
+    return correcto ? 0 : 1;
+}
@@ -0,0 +1,225 @@
+/**
+ * @file BenchDecodificacionBinaria.cpp
+ * @brief Escenario decodificacion_binaria: texto ID,valor frente a tramas binarias con 1, 8 y 32 lecturas.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+#include "Escenarios.h"
+#include "MedicionBench.h"
+#include "AnalizadorLineas.h"
+#include "LectorSerial.h"
+#include "ListaGeneral.h"
+#include "ProtocoloBinario.h"
+#include "RegistroAsincrono.h"
+#include "SensorPresion.h"
+#include "SensorTemperatura.h"
+
+namespace
+{
+/// Flujo de bytes en memoria tal como llegaría por el puerto.
+struct Flujo
+{
+    char* datos;
+    std::size_t bytes;
+};
+
+/// Lectura sintética: mitad temperaturas con un decimal, mitad presiones enteras.
+LecturaBinaria generarLectura(unsigned int& semilla, long long sensores)
+{
+    semilla = semilla * 1103515245u + 12345u;
+    unsigned int azar = semilla >> 8;
+    LecturaBinaria lectura;
+    lectura.id = static_cast<std::uint16_t>((azar >> 4) % (sensores / 2));
+    if (azar & 1u)
+    {
+        lectura.tipo = 'T';
+        lectura.valor = static_cast<float>(static_cast<int>(azar % 1000)) / 10.0f;
+    }
+    else
+    {
+        lectura.tipo = 'P';
+        lectura.valor = static_cast<int>(azar % 200000);
+    }
+    return lectura;
+}
+
+Flujo generarTexto(long long lecturas, long long sensores)
+{
+    Flujo flujo;
+    flujo.datos = new char[static_cast<std::size_t>(lecturas) * 24];
+    flujo.bytes = 0;
+    unsigned int semilla = 99u;
+    for (long long i = 0; i < lecturas; ++i)
+    {
+        LecturaBinaria lectura = generarLectura(semilla, sensores);
+        char* destino = flujo.datos + flujo.bytes;
+        int escritos = (lectura.tipo == 'T')
+                           ? std::snprintf(destino, 24, "T-%03u,%.1f\n", static_cast<unsigned>(lectura.id), lectura.valor)
+                           : std::snprintf(destino, 24, "P-%03u,%d\n", static_cast<unsigned>(lectura.id),
+                                           static_cast<int>(lectura.valor));
+        flujo.bytes += static_cast<std::size_t>(escritos);
+    }
+    return flujo;
+}
+
+Flujo generarTramas(long long lecturas, long long sensores, std::size_t porTrama)
+{
+    Flujo flujo;
+    std::size_t tramas = static_cast<std::size_t>((lecturas + porTrama - 1) / porTrama);
+    flujo.datos = new char[tramas * TAM_MAX_TRAMA];
+    flujo.bytes = 0;
+    unsigned int semilla = 99u;
+    LecturaBinaria lote[MAX_LECTURAS_TRAMA];
+    std::uint16_t secuencia = 0;
+    for (long long i = 0; i < lecturas;)
+    {
+        std::size_t cantidad = 0;
+        for (; cantidad < porTrama && i < lecturas; ++cantidad, ++i)
+        {
+            lote[cantidad] = generarLectura(semilla, sensores);
+        }
+        flujo.bytes += codificarTrama(lote, cantidad, secuencia++,
+                                      reinterpret_cast<unsigned char*>(flujo.datos + flujo.bytes));
+    }
+    return flujo;
+}
+
+/**
+ * @brief Separa el flujo en elementos, resuelve el sensor y convierte el valor, sin registrarlo.
+ *
+ * Así se mide solo la decodificación y la búsqueda; el costo de guardar la
+ * lectura es el mismo para ambos formatos.
+ */
+long long decodificar(const Flujo& flujo, const ListaGeneral& lista, double& suma)
+{
+    BufferLineas buffer;
+    TramaBinaria trama;
+    char* linea = nullptr;
+    std::size_t longitud = 0;
+    long long resueltas = 0;
+    std::size_t posicion = 0;
+    while (posicion < flujo.bytes)
+    {
+        posicion += buffer.alimentar(flujo.datos + posicion, flujo.bytes - posicion);
+        ElementoEntrada elemento;
+        while ((elemento = buffer.siguienteElemento(linea, longitud, trama)) != ElementoEntrada::Ninguno)
+        {
+            if (elemento == ElementoEntrada::Trama)
+            {
+                for (std::size_t i = 0; i < trama.cantidad; ++i)
+                {
+                    if (lista.buscarPorId(trama.lecturas[i].tipo, trama.lecturas[i].id))
+                    {
+                        suma += trama.lecturas[i].valor;
+                        ++resueltas;
+                    }
+                }
+                continue;
+            }
+
+            LineaSerial campos;
+            if (!analizarLineaSerial(linea, longitud, campos) ||
+                !lista.buscarPorNombre(campos.id.data(), campos.id.size()))
+            {
+                continue;
+            }
+            if (campos.id[0] == 'T')
+            {
+                float valor = 0.0f;
+                if (convertirValor(campos.valor, valor))
+                {
+                    suma += valor;
+                    ++resueltas;
+                }
+            }
+            else
+            {
+                int valor = 0;
+                if (convertirValor(campos.valor, valor))
+                {
+                    suma += valor;
+                    ++resueltas;
+                }
+            }
+        }
+    }
+    return resueltas;
+}
+}
+
+int benchDecodificacionBinaria(int argc, char** argv)
+{
+    long long lecturas = leerOpcionEntera(argc, argv, "--lecturas", 5000000);
+    long long sensores = leerOpcionEntera(argc, argv, "--sensores", 200);
+    long long repeticiones = leerOpcionEntera(argc, argv, "--repeticiones", 3);
+    if (lecturas <= 0 || sensores < 2 || sensores > 2000 || repeticiones <= 0)
+    {
+        std::fprintf(stderr, "--lecturas y --repeticiones deben ser positivos y --sensores estar entre 2 y 2000\n");
+        return 1;
+    }
+
+    RegistroAsincrono& registro = RegistroAsincrono::instancia();
+    NivelLog nivelAnterior = registro.obtenerNivelMinimo();
+    registro.establecerNivelMinimo(NivelLog::Error);
+    ListaGeneral lista;
+    char nombre[16];
+    for (long long s = 0; s < sensores / 2; ++s)
+    {
+        std::snprintf(nombre, sizeof(nombre), "T-%03lld", s);
+        lista.insertar(new SensorTemperatura(nombre));
+        std::snprintf(nombre, sizeof(nombre), "P-%03lld", s);
+        lista.insertar(new SensorPresion(nombre));
+    }
+
+    struct Variante
+    {
+        const char* nombre;
+        Flujo flujo;
+    };
+    Variante variantes[] = {
+        {"texto", generarTexto(lecturas, sensores)},
+        {"trama x1", generarTramas(lecturas, sensores, 1)},
+        {"trama x8", generarTramas(lecturas, sensores, 8)},
+        {"trama x32", generarTramas(lecturas, sensores, 32)},
+    };
+
+    std::printf("lecturas=%lld  sensores=%lld\n", lecturas, sensores);
+    std::printf("%-10s %12s %14s %12s %14s\n", "formato", "bytes/lect", "Mlecturas/s", "aceleracion", "suma");
+    bool coinciden = true;
+    double sumaTexto = 0.0;
+    double mejorTexto = 0.0;
+    for (Variante& variante : variantes)
+    {
+        double mejor = 0.0;
+        double suma = 0.0;
+        for (long long r = 0; r < repeticiones; ++r)
+        {
+            suma = 0.0;
+            Cronometro cronometro;
+            long long resueltas = decodificar(variante.flujo, lista, suma);
+            double segundos = cronometro.segundos();
+            coinciden = coinciden && (resueltas == lecturas);
+            if (r == 0 || segundos < mejor)
+            {
+                mejor = segundos;
+            }
+        }
+        if (&variante == &variantes[0])
+        {
+            sumaTexto = suma;
+            mejorTexto = mejor;
+        }
+        coinciden = coinciden && (suma == sumaTexto);
+        std::printf("%-10s %12.2f %14.2f %11.2fx %14.1f\n", variante.nombre,
+                    static_cast<double>(variante.flujo.bytes) / lecturas, lecturas / mejor / 1e6, mejorTexto / mejor,
+                    suma);
+        delete[] variante.flujo.datos;
+    }
+    std::printf("mismas lecturas en todos los formatos: %s\n", coinciden ? "si" : "no");
+
+    lista.liberar();
+    registro.establecerNivelMinimo(nivelAnterior);
+    return coinciden ? 0 : 1;
+}
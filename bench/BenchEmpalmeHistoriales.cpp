@@ -0,0 +1,77 @@
+/**
+ * @file BenchEmpalmeHistoriales.cpp
+ * @brief Escenario empalme_historiales: pasar lotes de un buffer de ingesta a un archivo copiando vs concatenando.
+ */
+
+#include <cstdio>
+#include "Escenarios.h"
+#include "MedicionBench.h"
+#include "ListaSensor.h"
+
+namespace
+{
+/// Llena el buffer con un lote y lo vacía en el archivo extrayendo y reinsertando cada lectura.
+double medirCopiando(long long lotes, long long tamanoLote, double& control)
+{
+    ListaSensor<float> archivo;
+    ListaSensor<float> buffer;
+    Cronometro cronometro;
+    for (long long l = 0; l < lotes; ++l)
+    {
+        for (long long i = 0; i < tamanoLote; ++i)
+        {
+            buffer.insertarAlFinal(static_cast<float>(i % 997));
+        }
+        float valor = 0.0f;
+        while (buffer.extraerPrimero(valor))
+        {
+            archivo.insertarAlFinal(valor);
+        }
+    }
+    double segundos = cronometro.segundos();
+    control += archivo.obtenerSuma() + archivo.contar();
+    return segundos;
+}
+
+/// Mismo flujo, pero cada lote pasa al archivo con concatenar() en O(1).
+double medirConcatenando(long long lotes, long long tamanoLote, double& control)
+{
+    ListaSensor<float> archivo;
+    ListaSensor<float> buffer;
+    Cronometro cronometro;
+    for (long long l = 0; l < lotes; ++l)
+    {
+        for (long long i = 0; i < tamanoLote; ++i)
+        {
+            buffer.insertarAlFinal(static_cast<float>(i % 997));
+        }
+        archivo.concatenar(buffer);
+    }
+    double segundos = cronometro.segundos();
+    control += archivo.obtenerSuma() + archivo.contar();
+    return segundos;
+}
+}
+
+int benchEmpalmeHistoriales(int argc, char** argv)
+{
+    long long lecturas = leerOpcionEntera(argc, argv, "--lecturas", 4000000);
+    if (lecturas <= 0)
+    {
+        std::fprintf(stderr, "--lecturas debe ser positivo\n");
+        return 1;
+    }
+
+    const long long tamanos[] = {16, 256, 4096, 65536};
+    std::printf("%-8s %14s %14s %12s\n", "lote", "copiar (s)", "concatenar (s)", "aceleracion");
+    for (long long tamanoLote : tamanos)
+    {
+        long long lotes = (lecturas + tamanoLote - 1) / tamanoLote;
+        double control = 0.0;
+        double copiando = medirCopiando(lotes, tamanoLote, control);
+        double concatenando = medirConcatenando(lotes, tamanoLote, control);
+        std::printf("%-8lld %14.3f %14.3f %11.1fx   (control=%.0f)\n", tamanoLote, copiando, concatenando,
+                    (concatenando > 0.0) ? copiando / concatenando : 0.0, control);
+    }
+    return 0;
+}
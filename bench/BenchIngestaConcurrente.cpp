@@ -0,0 +1,197 @@
+/**
+ * @file BenchIngestaConcurrente.cpp
+ * @brief Escenario ingesta_concurrente: prueba de estrés de la ingesta sin candados mientras se procesa.
+ *
+ * Pensado también para correr bajo ThreadSanitizer
+ * (cmake -DGESTION_SANITIZADOR=thread): cualquier carrera se reporta ahí.
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include "Escenarios.h"
+#include "MedicionBench.h"
+#include "AuxiliarCli.h"
+#include "LectorSerial.h"
+#include "ListaGeneral.h"
+#include "ListaSensor.h"
+#include "RegistroAsincrono.h"
+#include "SensorPresion.h"
+#include "SensorTemperatura.h"
+
+namespace
+{
+/// Cada valor codifica su productor y su posición para verificar el orden.
+long long codificar(long long productor, long long secuencia)
+{
+    return productor * 1000000000LL + secuencia;
+}
+
+/**
+ * @brief Varios productores agregan a una ListaSensor mientras el dueño consolida y consulta.
+ * @return true si no se perdió ninguna lectura y cada productor conservó su orden.
+ */
+bool estresarListaSensor(int productores, long long porProductor)
+{
+    ListaSensor<long long> lista;
+    std::atomic<int> terminados(0);
+    std::thread* hilos = new std::thread[productores];
+
+    Cronometro cronometro;
+    for (int p = 0; p < productores; ++p)
+    {
+        hilos[p] = std::thread([&lista, &terminados, p, porProductor]()
+        {
+            for (long long i = 0; i < porProductor; ++i)
+            {
+                lista.insertarConcurrente(codificar(p, i));
+            }
+            terminados.fetch_add(1, std::memory_order_release);
+        });
+    }
+
+    long long consolidaciones = 0;
+    long long consultas = 0;
+    double control = 0.0;
+    while (terminados.load(std::memory_order_acquire) < productores)
+    {
+        if (lista.consolidarPendientes() > 0)
+        {
+            ++consolidaciones;
+        }
+        long long minimo = 0;
+        long long maximo = 0;
+        if (lista.obtenerMinimo(minimo) && lista.obtenerMaximo(maximo))
+        {
+            control += lista.promedio() + static_cast<double>(maximo - minimo);
+            ++consultas;
+        }
+    }
+    for (int p = 0; p < productores; ++p)
+    {
+        hilos[p].join();
+    }
+    lista.consolidarPendientes();
+    double segundos = cronometro.segundos();
+    delete[] hilos;
+
+    long long* siguienteEsperado = new long long[productores]();
+    bool ordenado = true;
+    for (Nodo<long long>* nodo = lista.obtenerCabeza(); nodo; nodo = nodo->siguiente)
+    {
+        long long productor = nodo->dato / 1000000000LL;
+        long long secuencia = nodo->dato % 1000000000LL;
+        if (secuencia != siguienteEsperado[productor])
+        {
+            ordenado = false;
+        }
+        siguienteEsperado[productor] = secuencia + 1;
+    }
+    delete[] siguienteEsperado;
+
+    long long total = productores * porProductor;
+    bool completo = (lista.contar() == total);
+    std::printf("lista_sensor  productores=%d  lecturas=%lld  tiempo=%.3f s  anexos/s=%.0f  consolidaciones=%lld  "
+                "consultas=%lld  completo=%s  orden=%s  (control=%.0f)\n",
+                productores, total, segundos, total / segundos, consolidaciones, consultas,
+                completo ? "si" : "no", ordenado ? "si" : "no", control);
+    return completo && ordenado;
+}
+
+/**
+ * @brief Hilos de ingesta enrutan líneas a los sensores mientras otro hilo llama a procesarSensores().
+ * @return true si cada lectura enviada llegó a un sensor.
+ */
+bool estresarSensores(int productores, long long porProductor, int cantidadSensores)
+{
+    RegistroAsincrono& registro = RegistroAsincrono::instancia();
+    NivelLog nivelAnterior = registro.obtenerNivelMinimo();
+    registro.establecerNivelMinimo(NivelLog::Error);
+
+    ListaGeneral lista;
+    char nombre[32];
+    for (int s = 0; s < cantidadSensores; ++s)
+    {
+        std::snprintf(nombre, sizeof(nombre), (s % 2 == 0) ? "T-%03d" : "P-%03d", s);
+        if (s % 2 == 0)
+        {
+            lista.insertar(new SensorTemperatura(nombre));
+        }
+        else
+        {
+            lista.insertar(new SensorPresion(nombre));
+        }
+    }
+    lista.establecerIngestaConcurrente(true);
+
+    std::atomic<int> terminados(0);
+    std::atomic<long long> entregadas(0);
+    std::thread* hilos = new std::thread[productores];
+    Cronometro cronometro;
+    for (int p = 0; p < productores; ++p)
+    {
+        hilos[p] = std::thread([&lista, &terminados, &entregadas, p, porProductor, cantidadSensores]()
+        {
+            AuxiliarCli cli;
+            char linea[48];
+            long long propias = 0;
+            for (long long i = 0; i < porProductor; ++i)
+            {
+                int s = static_cast<int>((i + p) % cantidadSensores);
+                int longitud = std::snprintf(linea, sizeof(linea), (s % 2 == 0) ? "T-%03d,%lld.5" : "P-%03d,%lld",
+                                             s, i % 1000);
+                if (enrutarLineaSerial(lista, linea, static_cast<std::size_t>(longitud), cli))
+                {
+                    ++propias;
+                }
+            }
+            entregadas.fetch_add(propias, std::memory_order_relaxed);
+            terminados.fetch_add(1, std::memory_order_release);
+        });
+    }
+
+    long long ciclos = 0;
+    while (terminados.load(std::memory_order_acquire) < productores)
+    {
+        lista.procesarSensores();
+        ++ciclos;
+    }
+    for (int p = 0; p < productores; ++p)
+    {
+        hilos[p].join();
+    }
+    lista.procesarSensores();
+    double segundos = cronometro.segundos();
+    delete[] hilos;
+
+    lista.establecerIngestaConcurrente(false);
+    lista.liberar();
+    AuxiliarCli::sincronizar();
+    registro.establecerNivelMinimo(nivelAnterior);
+
+    long long total = productores * porProductor;
+    bool completo = (entregadas.load() == total);
+    std::printf("sensores      productores=%d  lecturas=%lld  tiempo=%.3f s  lineas/s=%.0f  ciclos_procesamiento=%lld  "
+                "completo=%s\n",
+                productores, total, segundos, total / segundos, ciclos, completo ? "si" : "no");
+    return completo;
+}
+}
+
+int benchIngestaConcurrente(int argc, char** argv)
+{
+    long long productores = leerOpcionEntera(argc, argv, "--productores", 4);
+    long long lecturas = leerOpcionEntera(argc, argv, "--lecturas", 500000);
+    long long sensores = leerOpcionEntera(argc, argv, "--sensores", 16);
+    if (productores <= 0 || lecturas <= 0 || sensores <= 0 || lecturas >= 1000000000LL)
+    {
+        std::fprintf(stderr, "--productores, --lecturas y --sensores deben ser positivos (lecturas < 1e9)\n");
+        return 1;
+    }
+
+    bool correcto = estresarListaSensor(static_cast<int>(productores), lecturas);
+    correcto = estresarSensores(static_cast<int>(productores), lecturas, static_cast<int>(sensores)) && correcto;
+    std::printf("resultado: %s\n", correcto ? "correcto" : "FALLO");
+    return correcto ? 0 : 1;
+}
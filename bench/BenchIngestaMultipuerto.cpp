@@ -0,0 +1,133 @@
+/**
+ * @file BenchIngestaMultipuerto.cpp
+ * @brief Escenario ingesta_multipuerto: varios pseudo-terminales simulan Arduinos ante MotorIngesta.
+ */
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <pty.h>
+#include <termios.h>
+#include <thread>
+#include <unistd.h>
+#include "Escenarios.h"
+#include "MedicionBench.h"
+#include "RegistroAsincrono.h"
+#include "MotorIngesta.h"
+#include "ListaGeneral.h"
+#include "SensorTemperatura.h"
+#include "SensorPresion.h"
+
+namespace
+{
+/// Emisor simulado: escribe líneas alternando su sensor de temperatura y de presión.
+void emitirPuerto(int fd, int puerto, long long lineas)
+{
+    char linea[64];
+    const long long lineasPorBloque = 2048;
+    char* bloque = new char[64 * lineasPorBloque];
+
+    long long enviadas = 0;
+    while (enviadas < lineas)
+    {
+        std::size_t usados = 0;
+        long long enBloque = 0;
+        while (enBloque < lineasPorBloque && enviadas + enBloque < lineas)
+        {
+            int longitud = ((enviadas + enBloque) % 2 == 0)
+                               ? std::snprintf(linea, sizeof(linea), "T-%03d,%d.%d\n", puerto, 40 + static_cast<int>(enBloque % 10), static_cast<int>(enBloque % 7))
+                               : std::snprintf(linea, sizeof(linea), "P-%03d,%d\n", puerto, 80 + static_cast<int>(enBloque % 6));
+            std::memcpy(bloque + usados, linea, static_cast<std::size_t>(longitud));
+            usados += static_cast<std::size_t>(longitud);
+            ++enBloque;
+        }
+
+        const char* cursor = bloque;
+        while (usados > 0)
+        {
+            ssize_t escritos = write(fd, cursor, usados);
+            if (escritos < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                delete[] bloque;
+                return;
+            }
+            cursor += escritos;
+            usados -= static_cast<std::size_t>(escritos);
+        }
+        enviadas += enBloque;
+    }
+    delete[] bloque;
+}
+}
+
+int benchIngestaMultipuerto(int argc, char** argv)
+{
+    int puertos = static_cast<int>(leerOpcionEntera(argc, argv, "--puertos", 8));
+    long long lineasPorPuerto = leerOpcionEntera(argc, argv, "--lineas", 200000);
+    if (puertos <= 0 || puertos > MotorIngesta::MAX_FUENTES)
+    {
+        std::fprintf(stderr, "--puertos debe estar entre 1 y %d\n", MotorIngesta::MAX_FUENTES);
+        return 1;
+    }
+
+    // Los logs por lectura dominarían la medición: solo se registran errores.
+    RegistroAsincrono::instancia().establecerNivelMinimo(NivelLog::Error);
+
+    AuxiliarCli cli;
+    ListaGeneral lista;
+    MotorIngesta motor(lista, cli);
+    int* maestros = new int[puertos];
+    char nombre[16];
+
+    for (int i = 0; i < puertos; ++i)
+    {
+        int esclavo = -1;
+        if (openpty(&maestros[i], &esclavo, nullptr, nullptr, nullptr) != 0)
+        {
+            std::perror("openpty");
+            return 1;
+        }
+        struct termios modo;
+        tcgetattr(esclavo, &modo);
+        cfmakeraw(&modo);
+        tcsetattr(esclavo, TCSANOW, &modo);
+
+        std::snprintf(nombre, sizeof(nombre), "T-%03d", i);
+        lista.insertar(new SensorTemperatura(nombre));
+        std::snprintf(nombre, sizeof(nombre), "P-%03d", i);
+        lista.insertar(new SensorPresion(nombre));
+        std::snprintf(nombre, sizeof(nombre), "pty-%d", i);
+        motor.agregarDescriptor(esclavo, nombre);
+    }
+
+    std::thread* emisores = new std::thread[puertos];
+    Cronometro cronometro;
+    for (int i = 0; i < puertos; ++i)
+    {
+        emisores[i] = std::thread(emitirPuerto, maestros[i], i, lineasPorPuerto);
+    }
+
+    const long long esperadas = lineasPorPuerto * puertos;
+    while (motor.obtenerLineasTotales() < esperadas && motor.fuentesActivas() > 0)
+    {
+        motor.procesarEventos(1000);
+    }
+    double segundos = cronometro.segundos();
+
+    for (int i = 0; i < puertos; ++i)
+    {
+        emisores[i].join();
+        close(maestros[i]);
+    }
+    delete[] emisores;
+    delete[] maestros;
+
+    std::printf("puertos=%d  lineas=%lld  tiempo=%.3f s  lineas/s=%.0f\n",
+                puertos, motor.obtenerLineasTotales(), segundos,
+                (segundos > 0.0) ? motor.obtenerLineasTotales() / segundos : 0.0);
+    return 0;
+}
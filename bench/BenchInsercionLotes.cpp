@@ -0,0 +1,168 @@
+/**
+ * @file BenchInsercionLotes.cpp
+ * @brief Escenario insercion_lotes: lectura por lectura frente a registrarLoteNumericoEn() e insertarLote().
+ */
+
+#include <cstdio>
+#include <cstdint>
+#include "Escenarios.h"
+#include "MedicionBench.h"
+#include "ListaSensor.h"
+#include "RegistroAsincrono.h"
+#include "SensorTemperatura.h"
+
+namespace
+{
+/// Lecturas que se preparan de antemano y se reutilizan en cada lote.
+constexpr std::size_t LECTURAS_PREPARADAS = 4096;
+
+/// Inserta en la lista lectura por lectura con insertarAlFinal().
+double medirListaIndividual(long long lecturas, const float* valores, const std::int64_t* marcas, double& control)
+{
+    ListaSensor<float> lista;
+    Cronometro cronometro;
+    for (long long i = 0; i < lecturas; ++i)
+    {
+        std::size_t j = static_cast<std::size_t>(i) % LECTURAS_PREPARADAS;
+        lista.insertarAlFinal(valores[j], marcas[j]);
+    }
+    double segundos = cronometro.segundos();
+    control += lista.obtenerSuma() + lista.contar();
+    return segundos;
+}
+
+/// Inserta en la lista por lotes con insertarLote().
+double medirListaLotes(long long lecturas, long long tamanoLote, const float* valores, const std::int64_t* marcas,
+                       double& control)
+{
+    ListaSensor<float> lista;
+    Cronometro cronometro;
+    long long insertadas = 0;
+    while (insertadas < lecturas)
+    {
+        long long enLote = (lecturas - insertadas < tamanoLote) ? lecturas - insertadas : tamanoLote;
+        std::size_t j = static_cast<std::size_t>(insertadas) % LECTURAS_PREPARADAS;
+        if (j + static_cast<std::size_t>(enLote) > LECTURAS_PREPARADAS)
+        {
+            j = 0;
+        }
+        lista.insertarLote(valores + j, marcas + j, static_cast<std::size_t>(enLote));
+        insertadas += enLote;
+    }
+    double segundos = cronometro.segundos();
+    control += lista.obtenerSuma() + lista.contar();
+    return segundos;
+}
+
+/**
+ * @brief Registra las lecturas en un sensor, una por llamada virtual (tamanoLote == 1) o por lotes.
+ *
+ * Incluye el vaciado de la cola de logs, que es donde termina el costo de
+ * una línea de log por lectura.
+ */
+double medirSensor(long long lecturas, long long tamanoLote, const double* valores, const std::int64_t* marcas,
+                   double& control)
+{
+    SensorTemperatura sensor("T-001");
+    Cronometro cronometro;
+    long long insertadas = 0;
+    while (insertadas < lecturas)
+    {
+        long long enLote = (lecturas - insertadas < tamanoLote) ? lecturas - insertadas : tamanoLote;
+        std::size_t j = static_cast<std::size_t>(insertadas) % LECTURAS_PREPARADAS;
+        if (j + static_cast<std::size_t>(enLote) > LECTURAS_PREPARADAS)
+        {
+            j = 0;
+        }
+        if (tamanoLote == 1)
+        {
+            sensor.registrarLecturaNumericaEn(valores[j], marcas[j]);
+        }
+        else
+        {
+            sensor.registrarLoteNumericoEn(valores + j, marcas + j, static_cast<std::size_t>(enLote));
+        }
+        insertadas += enLote;
+    }
+    AuxiliarCli::sincronizar();
+    double segundos = cronometro.segundos();
+    control += static_cast<double>(sensor.lecturasEnMemoria());
+    ResumenLiberacion resumen;
+    sensor.liberarHistorial(resumen);
+    return segundos;
+}
+
+/// Nanosegundos por lectura.
+double nsPorLectura(double segundos, long long lecturas)
+{
+    return segundos * 1e9 / static_cast<double>(lecturas);
+}
+}
+
+int benchInsercionLotes(int argc, char** argv)
+{
+    long long lecturas = leerOpcionEntera(argc, argv, "--lecturas", 2000000);
+    if (lecturas <= 0)
+    {
+        std::fprintf(stderr, "--lecturas debe ser positivo\n");
+        return 1;
+    }
+
+    float* valoresFloat = new float[LECTURAS_PREPARADAS];
+    double* valores = new double[LECTURAS_PREPARADAS];
+    std::int64_t* marcas = new std::int64_t[LECTURAS_PREPARADAS];
+    std::int64_t base = marcaMonotonica();
+    for (std::size_t i = 0; i < LECTURAS_PREPARADAS; ++i)
+    {
+        valores[i] = 20.0 + static_cast<double>(i % 150) / 10.0;
+        valoresFloat[i] = static_cast<float>(valores[i]);
+        marcas[i] = base + static_cast<std::int64_t>(i) * 1000;
+    }
+
+    const long long tamanos[] = {1, 8, 64, 256};
+    double control = 0.0;
+
+    std::printf("ListaSensor<float>, %lld lecturas (ns/lectura)\n", lecturas);
+    std::printf("%-8s %14s %14s %12s\n", "lote", "individual", "insertarLote", "aceleracion");
+    double individual = nsPorLectura(medirListaIndividual(lecturas, valoresFloat, marcas, control), lecturas);
+    for (long long tamanoLote : tamanos)
+    {
+        double porLotes =
+            nsPorLectura(medirListaLotes(lecturas, tamanoLote, valoresFloat, marcas, control), lecturas);
+        std::printf("%-8lld %14.1f %14.1f %11.2fx\n", tamanoLote, individual, porLotes,
+                    (porLotes > 0.0) ? individual / porLotes : 0.0);
+    }
+
+    // Con el log de estado activo cada llamada deja una línea; la salida se descarta para medir solo su costo.
+    RegistroAsincrono& registro = RegistroAsincrono::instancia();
+    NivelLog nivelAnterior = registro.obtenerNivelMinimo();
+    double conLog[sizeof(tamanos) / sizeof(tamanos[0])];
+    double sinLog[sizeof(tamanos) / sizeof(tamanos[0])];
+    {
+        RedireccionSalida descarte("/dev/null");
+        registro.establecerNivelMinimo(NivelLog::Estado);
+        for (std::size_t t = 0; t < sizeof(tamanos) / sizeof(tamanos[0]); ++t)
+        {
+            conLog[t] = nsPorLectura(medirSensor(lecturas, tamanos[t], valores, marcas, control), lecturas);
+        }
+        registro.establecerNivelMinimo(NivelLog::Error);
+        for (std::size_t t = 0; t < sizeof(tamanos) / sizeof(tamanos[0]); ++t)
+        {
+            sinLog[t] = nsPorLectura(medirSensor(lecturas, tamanos[t], valores, marcas, control), lecturas);
+        }
+        registro.establecerNivelMinimo(nivelAnterior);
+    }
+
+    std::printf("\nSensorTemperatura, %lld lecturas (ns/lectura; lote 1 = registrarLecturaNumericaEn)\n", lecturas);
+    std::printf("%-8s %14s %14s\n", "lote", "con log", "sin log");
+    for (std::size_t t = 0; t < sizeof(tamanos) / sizeof(tamanos[0]); ++t)
+    {
+        std::printf("%-8lld %14.1f %14.1f\n", tamanos[t], conLog[t], sinLog[t]);
+    }
+    std::printf("(control=%.0f)\n", control);
+
+    delete[] valoresFloat;
+    delete[] valores;
+    delete[] marcas;
+    return 0;
+}
@@ -0,0 +1,209 @@
+/**
+ * @file BenchLatenciaPuerto.cpp
+ * @brief Escenario latencia_puerto: compara configuraciones de configurarPuertoSerial sobre un pty.
+ *
+ * Un pseudo-terminal no simula la velocidad de línea, así que los baudios no
+ * cambian el resultado en este lazo local; sí lo hacen VMIN/VTIME, que
+ * determinan cuándo regresa un read() bloqueante. En un adaptador USB real el
+ * mismo escenario refleja además el efecto de la velocidad y de ASYNC_LOW_LATENCY.
+ */
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <pty.h>
+#include <thread>
+#include <unistd.h>
+#include "Escenarios.h"
+#include "MedicionBench.h"
+#include "RegistroAsincrono.h"
+#include "LectorSerial.h"
+
+namespace
+{
+/// Combinación de parámetros a evaluar.
+struct CasoPuerto
+{
+    int baudios;
+    int vmin;
+    int vtime;
+    bool bajaLatencia;
+};
+
+int compararDoubles(const void* a, const void* b)
+{
+    double x = *static_cast<const double*>(a);
+    double y = *static_cast<const double*>(b);
+    return (x < y) ? -1 : (x > y) ? 1 : 0;
+}
+
+/// Lee del esclavo hasta completar una línea; devuelve false si el canal se cerró.
+bool leerLineaBloqueante(int fd, BufferLineas& buffer)
+{
+    std::size_t longitud = 0;
+    while (!buffer.siguienteLinea(longitud))
+    {
+        ssize_t cantidad = buffer.leerDesde(fd);
+        if (cantidad < 0 && errno != EINTR && errno != EAGAIN)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Mide ida de una línea (escritura en el maestro hasta línea completa en el esclavo).
+bool medirLatencia(int maestro, int esclavo, int repeticiones, double* muestras)
+{
+    static const char linea[] = "T-001,45.3\n";
+    BufferLineas buffer;
+    for (int i = 0; i < repeticiones; ++i)
+    {
+        Cronometro cronometro;
+        if (write(maestro, linea, sizeof(linea) - 1) < 0)
+        {
+            return false;
+        }
+        if (!leerLineaBloqueante(esclavo, buffer))
+        {
+            return false;
+        }
+        muestras[i] = cronometro.segundos() * 1e6;
+    }
+    return true;
+}
+
+/// Mide líneas por segundo de una ráfaga continua.
+double medirRendimiento(int maestro, int esclavo, long long lineas)
+{
+    std::thread emisor([maestro, lineas]() {
+        static const char linea[] = "T-001,45.3\n";
+        char bloque[sizeof(linea) * 512];
+        for (int i = 0; i < 512; ++i)
+        {
+            std::memcpy(bloque + i * (sizeof(linea) - 1), linea, sizeof(linea) - 1);
+        }
+        long long restantes = lineas;
+        while (restantes > 0)
+        {
+            long long enBloque = (restantes < 512) ? restantes : 512;
+            std::size_t pendiente = static_cast<std::size_t>(enBloque) * (sizeof(linea) - 1);
+            const char* cursor = bloque;
+            while (pendiente > 0)
+            {
+                ssize_t escritos = write(maestro, cursor, pendiente);
+                if (escritos < 0)
+                {
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    return;
+                }
+                cursor += escritos;
+                pendiente -= static_cast<std::size_t>(escritos);
+            }
+            restantes -= enBloque;
+        }
+    });
+
+    BufferLineas buffer;
+    long long recibidas = 0;
+    Cronometro cronometro;
+    while (recibidas < lineas)
+    {
+        ssize_t cantidad = buffer.leerDesde(esclavo);
+        if (cantidad < 0 && errno != EINTR && errno != EAGAIN)
+        {
+            break;
+        }
+        std::size_t longitud = 0;
+        while (buffer.siguienteLinea(longitud))
+        {
+            ++recibidas;
+        }
+    }
+    double segundos = cronometro.segundos();
+    emisor.join();
+    return (segundos > 0.0) ? recibidas / segundos : 0.0;
+}
+}
+
+int benchLatenciaPuerto(int argc, char** argv)
+{
+    int repeticiones = static_cast<int>(leerOpcionEntera(argc, argv, "--repeticiones", 2000));
+    long long lineas = leerOpcionEntera(argc, argv, "--lineas", 200000);
+
+    static const CasoPuerto casos[] = {
+        {9600, 0, 10, false},
+        {115200, 0, 10, false},
+        {230400, 0, 10, false},
+        {921600, 0, 10, false},
+        {921600, 1, 0, false},
+        {921600, 1, 0, true},
+        {4000000, 1, 0, true},
+    };
+
+    // Los avisos de baja latencia no soportada en un pty no aportan a la tabla.
+    RegistroAsincrono::instancia().establecerNivelMinimo(NivelLog::Error);
+    AuxiliarCli cli;
+    double* muestras = new double[repeticiones > 0 ? repeticiones : 1];
+
+    std::printf("%-9s %-5s %-6s %-7s %10s %10s %10s %12s\n",
+                "baudios", "vmin", "vtime", "bajaLat", "prom_us", "p50_us", "p99_us", "lineas/s");
+    for (const CasoPuerto& caso : casos)
+    {
+        speed_t velocidad;
+        if (!velocidadTermios(caso.baudios, velocidad))
+        {
+            std::printf("%-9d (no soportada en esta plataforma)\n", caso.baudios);
+            continue;
+        }
+
+        int maestro = -1;
+        int esclavo = -1;
+        if (openpty(&maestro, &esclavo, nullptr, nullptr, nullptr) != 0)
+        {
+            std::perror("openpty");
+            delete[] muestras;
+            return 1;
+        }
+
+        ConfiguracionPuerto configuracion;
+        configuracion.baudios = caso.baudios;
+        configuracion.vmin = caso.vmin;
+        configuracion.vtime = caso.vtime;
+        configuracion.bajaLatencia = caso.bajaLatencia;
+        configurarPuertoSerial(esclavo, cli, configuracion);
+        bool bajaLatenciaAplicada = caso.bajaLatencia && aplicarBajaLatencia(esclavo, true);
+
+        double promedio = 0.0;
+        double p50 = 0.0;
+        double p99 = 0.0;
+        if (repeticiones > 0 && medirLatencia(maestro, esclavo, repeticiones, muestras))
+        {
+            for (int i = 0; i < repeticiones; ++i)
+            {
+                promedio += muestras[i];
+            }
+            promedio /= repeticiones;
+            std::qsort(muestras, static_cast<std::size_t>(repeticiones), sizeof(double), compararDoubles);
+            p50 = muestras[repeticiones / 2];
+            p99 = muestras[(repeticiones * 99) / 100];
+        }
+        double rendimiento = medirRendimiento(maestro, esclavo, lineas);
+
+        std::printf("%-9d %-5d %-6d %-7s %10.1f %10.1f %10.1f %12.0f\n",
+                    caso.baudios, caso.vmin, caso.vtime,
+                    caso.bajaLatencia ? (bajaLatenciaAplicada ? "si" : "n/d") : "no",
+                    promedio, p50, p99, rendimiento);
+
+        close(maestro);
+        close(esclavo);
+    }
+
+    delete[] muestras;
+    return 0;
+}
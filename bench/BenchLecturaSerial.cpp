@@ -0,0 +1,273 @@
+/**
+ * @file BenchLecturaSerial.cpp
+ * @brief Escenario lectura_serial: alimenta un pipe o pty con líneas ID,valor y mide el lector.
+ */
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <pty.h>
+#include <sys/select.h>
+#include <termios.h>
+#include <thread>
+#include <unistd.h>
+#include "Escenarios.h"
+#include "MedicionBench.h"
+#include "LectorSerial.h"
+#include "ListaGeneral.h"
+#include "SensorTemperatura.h"
+
+namespace
+{
+/// Resultado de una pasada del lector.
+struct ResultadoLectura
+{
+    long long lineas;
+    long long bytes;
+    long long llamadas;
+    double segundos;
+};
+
+/// Par de descriptores: extremo de escritura (emisor) y de lectura (host).
+struct Canal
+{
+    int escritura;
+    int lectura;
+};
+
+bool abrirCanal(bool usarPty, Canal& canal)
+{
+    if (usarPty)
+    {
+        int maestro = -1;
+        int esclavo = -1;
+        if (openpty(&maestro, &esclavo, nullptr, nullptr, nullptr) != 0)
+        {
+            return false;
+        }
+        struct termios modo;
+        tcgetattr(esclavo, &modo);
+        cfmakeraw(&modo);
+        tcsetattr(esclavo, TCSANOW, &modo);
+        canal.escritura = maestro;
+        canal.lectura = esclavo;
+    }
+    else
+    {
+        int extremos[2];
+        if (pipe(extremos) != 0)
+        {
+            return false;
+        }
+        canal.lectura = extremos[0];
+        canal.escritura = extremos[1];
+    }
+    fcntl(canal.lectura, F_SETFL, fcntl(canal.lectura, F_GETFL) | O_NONBLOCK);
+    return true;
+}
+
+/// Escribe la cantidad de líneas pedida en bloques grandes.
+void emitirLineas(int fd, long long lineas)
+{
+    static const char linea[] = "T-001,45.3\n";
+    const std::size_t tamLinea = sizeof(linea) - 1;
+    const long long lineasPorBloque = 4096;
+
+    char* bloque = new char[tamLinea * lineasPorBloque];
+    for (long long i = 0; i < lineasPorBloque; ++i)
+    {
+        std::memcpy(bloque + i * tamLinea, linea, tamLinea);
+    }
+
+    long long restantes = lineas;
+    while (restantes > 0)
+    {
+        long long enBloque = (restantes < lineasPorBloque) ? restantes : lineasPorBloque;
+        std::size_t pendiente = static_cast<std::size_t>(enBloque) * tamLinea;
+        const char* cursor = bloque;
+        while (pendiente > 0)
+        {
+            ssize_t escritos = write(fd, cursor, pendiente);
+            if (escritos < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                delete[] bloque;
+                return;
+            }
+            cursor += escritos;
+            pendiente -= static_cast<std::size_t>(escritos);
+        }
+        restantes -= enBloque;
+    }
+    delete[] bloque;
+}
+
+/// Espera a que el descriptor tenga datos; cuenta la llamada a select().
+bool esperarDatos(int fd, long long& llamadas)
+{
+    fd_set conjunto;
+    FD_ZERO(&conjunto);
+    FD_SET(fd, &conjunto);
+    ++llamadas;
+    return select(fd + 1, &conjunto, nullptr, nullptr, nullptr) >= 0 || errno == EINTR;
+}
+
+/// Interpreta la línea y resuelve el sensor como lo hace el motor de ingesta, sin insertar.
+bool analizarLinea(ListaGeneral& lista, const char* linea, std::size_t longitud)
+{
+    LineaSerial campos;
+    return analizarLineaSerial(linea, longitud, campos) &&
+           lista.buscarPorNombre(campos.id.data(), campos.id.size()) != nullptr;
+}
+
+/// Variante con copias que usaba el lector anterior.
+bool analizarLineaLegado(ListaGeneral& lista, const char* linea)
+{
+    char id[TAM_ID];
+    char valor[40];
+    return descomponerLineaSerial(linea, id, TAM_ID, valor, sizeof(valor)) && lista.buscarPorNombre(id) != nullptr;
+}
+
+/// Lector actual: un read() por bloque y separación de líneas en el buffer.
+ResultadoLectura leerPorBloques(int fd, ListaGeneral& lista, long long esperadas)
+{
+    ResultadoLectura resultado = {0, 0, 0, 0.0};
+    BufferLineas buffer;
+    Cronometro cronometro;
+
+    while (resultado.lineas < esperadas && esperarDatos(fd, resultado.llamadas))
+    {
+        ++resultado.llamadas;
+        ssize_t cantidad = buffer.leerDesde(fd);
+        if (cantidad == 0 || (cantidad < 0 && errno != EAGAIN && errno != EINTR))
+        {
+            break;
+        }
+        if (cantidad < 0)
+        {
+            continue;
+        }
+
+        resultado.bytes += cantidad;
+        std::size_t longitud = 0;
+        while (char* linea = buffer.siguienteLinea(longitud))
+        {
+            if (analizarLinea(lista, linea, longitud))
+            {
+                ++resultado.lineas;
+            }
+        }
+    }
+
+    resultado.segundos = cronometro.segundos();
+    return resultado;
+}
+
+/// Lector anterior: select() y read() de un byte por cada carácter.
+ResultadoLectura leerByteAByte(int fd, ListaGeneral& lista, long long esperadas)
+{
+    ResultadoLectura resultado = {0, 0, 0, 0.0};
+    char linea[TAM_SERIAL];
+    std::size_t posicion = 0;
+    Cronometro cronometro;
+
+    while (resultado.lineas < esperadas && esperarDatos(fd, resultado.llamadas))
+    {
+        char byteLeido = 0;
+        ++resultado.llamadas;
+        ssize_t cantidad = read(fd, &byteLeido, 1);
+        if (cantidad == 0 || (cantidad < 0 && errno != EAGAIN && errno != EINTR))
+        {
+            break;
+        }
+        if (cantidad < 0)
+        {
+            continue;
+        }
+
+        ++resultado.bytes;
+        if (byteLeido == '\r')
+        {
+            continue;
+        }
+        if (byteLeido == '\n')
+        {
+            linea[posicion] = '\0';
+            if (posicion > 0 && analizarLineaLegado(lista, linea))
+            {
+                ++resultado.lineas;
+            }
+            posicion = 0;
+        }
+        else if (posicion < sizeof(linea) - 1)
+        {
+            linea[posicion++] = byteLeido;
+        }
+    }
+
+    resultado.segundos = cronometro.segundos();
+    return resultado;
+}
+
+bool ejecutarPasada(bool usarPty, bool porBloques, long long lineas, ListaGeneral& lista, ResultadoLectura& resultado)
+{
+    Canal canal;
+    if (!abrirCanal(usarPty, canal))
+    {
+        std::perror("No se pudo crear el canal");
+        return false;
+    }
+
+    // El emisor no cierra su extremo: al cerrar el maestro de un pty se pierde
+    // lo que aún no se ha leído, así que el lector se detiene al contar todas las líneas.
+    std::thread emisor([&canal, lineas]() { emitirLineas(canal.escritura, lineas); });
+
+    resultado = porBloques ? leerPorBloques(canal.lectura, lista, lineas) : leerByteAByte(canal.lectura, lista, lineas);
+    emisor.join();
+    close(canal.escritura);
+    close(canal.lectura);
+    return true;
+}
+
+void imprimirResultado(const char* nombre, const ResultadoLectura& r)
+{
+    double lineasPorSegundo = (r.segundos > 0.0) ? r.lineas / r.segundos : 0.0;
+    double bytesPorLlamada = (r.llamadas > 0) ? static_cast<double>(r.bytes) / r.llamadas : 0.0;
+    std::printf("%-14s lineas=%lld  tiempo=%.3f s  lineas/s=%.0f  bytes/syscall=%.1f\n",
+                nombre, r.lineas, r.segundos, lineasPorSegundo, bytesPorLlamada);
+}
+}
+
+int benchLecturaSerial(int argc, char** argv)
+{
+    long long lineas = leerOpcionEntera(argc, argv, "--lineas", 2000000);
+    long long lineasLegado = leerOpcionEntera(argc, argv, "--lineas-legado", lineas / 20);
+    bool usarPty = tieneBandera(argc, argv, "--pty");
+
+    ListaGeneral lista;
+    lista.insertar(new SensorTemperatura("T-001"));
+
+    std::printf("Canal: %s\n", usarPty ? "pseudo-terminal" : "pipe");
+
+    ResultadoLectura bloques;
+    if (!ejecutarPasada(usarPty, true, lineas, lista, bloques))
+    {
+        return 1;
+    }
+    imprimirResultado("por_bloques", bloques);
+
+    if (lineasLegado > 0)
+    {
+        ResultadoLectura legado;
+        if (!ejecutarPasada(usarPty, false, lineasLegado, lista, legado))
+        {
+            return 1;
+        }
+        imprimirResultado("byte_a_byte", legado);
+    }
+    return 0;
+}
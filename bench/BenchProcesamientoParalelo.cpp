@@ -0,0 +1,166 @@
+/**
+ * @file BenchProcesamientoParalelo.cpp
+ * @brief Escenario procesamiento_paralelo: escalamiento de procesarSensoresEnParalelo de 1 a N hilos.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include "Escenarios.h"
+#include "MedicionBench.h"
+#include "AuxiliarCli.h"
+#include "ListaGeneral.h"
+#include "PoolTrabajo.h"
+#include "RegistroAsincrono.h"
+#include "SensorPresion.h"
+#include "SensorTemperatura.h"
+
+namespace
+{
+/// Crea los sensores con historiales deterministas (mitad temperatura, mitad presión).
+void poblarLista(ListaGeneral& lista, long long sensores, long long lecturas)
+{
+    char nombre[32];
+    char valor[32];
+    for (long long s = 0; s < sensores; ++s)
+    {
+        SensorBase* sensor = nullptr;
+        if (s % 2 == 0)
+        {
+            std::snprintf(nombre, sizeof(nombre), "T-%06lld", s);
+            sensor = new SensorTemperatura(nombre);
+        }
+        else
+        {
+            std::snprintf(nombre, sizeof(nombre), "P-%06lld", s);
+            sensor = new SensorPresion(nombre);
+        }
+        lista.insertar(sensor);
+
+        unsigned int semilla = static_cast<unsigned int>(s) * 2654435761u + 1u;
+        for (long long l = 0; l < lecturas; ++l)
+        {
+            semilla = semilla * 1103515245u + 12345u;
+            unsigned int azar = (semilla >> 8) % 100000u;
+            if (s % 2 == 0)
+            {
+                std::snprintf(valor, sizeof(valor), "%u.%u", azar / 1000u, azar % 10u);
+            }
+            else
+            {
+                std::snprintf(valor, sizeof(valor), "%u", azar);
+            }
+            sensor->registrarLecturaDesdeCadena(valor);
+        }
+    }
+}
+
+/// Hash FNV-1a del archivo, usado para comparar la salida de cada corrida.
+std::uint64_t huellaArchivo(const char* ruta)
+{
+    std::uint64_t hash = 1469598103934665603ULL;
+    std::FILE* archivo = std::fopen(ruta, "rb");
+    if (!archivo)
+    {
+        return 0;
+    }
+    int caracter;
+    while ((caracter = std::fgetc(archivo)) != EOF)
+    {
+        hash ^= static_cast<unsigned char>(caracter);
+        hash *= 1099511628211ULL;
+    }
+    std::fclose(archivo);
+    return hash;
+}
+
+/**
+ * @brief Construye la lista, la procesa con los hilos indicados y mide solo el procesamiento.
+ * @param hilos 0 para procesarSensores() secuencial.
+ */
+double medirCorrida(unsigned hilos, long long sensores, long long lecturas, const char* rutaLogs,
+                    std::uint64_t& huella, std::uint64_t& robos)
+{
+    RegistroAsincrono& registro = RegistroAsincrono::instancia();
+    NivelLog nivelAnterior = registro.obtenerNivelMinimo();
+    ListaGeneral lista;
+
+    registro.establecerNivelMinimo(NivelLog::Error);
+    poblarLista(lista, sensores, lecturas);
+    registro.establecerNivelMinimo(nivelAnterior);
+
+    double segundos = 0.0;
+    robos = 0;
+    {
+        RedireccionSalida redireccion(rutaLogs);
+        Cronometro cronometro;
+        if (hilos == 0)
+        {
+            lista.procesarSensores();
+        }
+        else
+        {
+            PoolTrabajo pool(hilos);
+            lista.procesarSensoresEnParalelo(pool);
+            robos = pool.obtenerRobos();
+        }
+        AuxiliarCli::sincronizar();
+        segundos = cronometro.segundos();
+    }
+    huella = huellaArchivo(rutaLogs);
+
+    registro.establecerNivelMinimo(NivelLog::Error);
+    lista.liberar();
+    registro.establecerNivelMinimo(nivelAnterior);
+    return segundos;
+}
+}
+
+int benchProcesamientoParalelo(int argc, char** argv)
+{
+    long long sensores = leerOpcionEntera(argc, argv, "--sensores", 2000);
+    long long lecturas = leerOpcionEntera(argc, argv, "--lecturas", 2000);
+    unsigned nucleos = std::thread::hardware_concurrency();
+    long long hilosMaximos = leerOpcionEntera(argc, argv, "--hilos-max", nucleos > 0 ? nucleos : 1);
+    if (sensores <= 0 || lecturas <= 0 || hilosMaximos <= 0)
+    {
+        std::fprintf(stderr, "--sensores, --lecturas y --hilos-max deben ser positivos\n");
+        return 1;
+    }
+    if (hilosMaximos > PoolTrabajo::MAX_HILOS)
+    {
+        hilosMaximos = PoolTrabajo::MAX_HILOS;
+    }
+
+    char rutaLogs[] = "/tmp/gestion_sensores_paralelo_XXXXXX";
+    int descriptor = mkstemp(rutaLogs);
+    if (descriptor < 0)
+    {
+        std::perror("mkstemp");
+        return 1;
+    }
+    close(descriptor);
+
+    std::printf("sensores=%lld  lecturas/sensor=%lld  nucleos=%u\n", sensores, lecturas, nucleos);
+    std::uint64_t huellaSecuencial = 0;
+    std::uint64_t robos = 0;
+    double secuencial = medirCorrida(0, sensores, lecturas, rutaLogs, huellaSecuencial, robos);
+    std::printf("%-10s tiempo=%.3f s  huella=%016llx\n", "secuencial", secuencial,
+                static_cast<unsigned long long>(huellaSecuencial));
+
+    bool deterministico = true;
+    for (long long hilos = 1; hilos <= hilosMaximos; ++hilos)
+    {
+        std::uint64_t huella = 0;
+        double segundos = medirCorrida(static_cast<unsigned>(hilos), sensores, lecturas, rutaLogs, huella, robos);
+        deterministico = deterministico && (huella == huellaSecuencial);
+        std::printf("hilos=%-4lld tiempo=%.3f s  aceleracion=%.2fx  robos=%llu  huella=%016llx\n", hilos, segundos,
+                    (segundos > 0.0) ? secuencial / segundos : 0.0, static_cast<unsigned long long>(robos),
+                    static_cast<unsigned long long>(huella));
+    }
+    std::printf("salida identica a la secuencial: %s\n", deterministico ? "si" : "no");
+
+    std::remove(rutaLogs);
+    return deterministico ? 0 : 1;
+}
@@ -0,0 +1,119 @@
+/**
+ * @file BenchRegistroLog.cpp
+ * @brief Escenario registro_log: costo de imprimirLog síncrono con std::endl frente al backend asíncrono.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include "Escenarios.h"
+#include "MedicionBench.h"
+#include "AuxiliarCli.h"
+#include "RegistroAsincrono.h"
+
+namespace
+{
+/// Réplica del imprimirLog anterior: comparación de cadenas y un flush por mensaje.
+void imprimirLogSincrono(const char* tipo, const char* msj)
+{
+    int colorId = 37;
+    if (std::strcmp(tipo, "RED") == 0 || std::strcmp(tipo, "ERROR") == 0 || std::strcmp(tipo, "error") == 0)
+    {
+        colorId = 31;
+    }
+    else if (std::strcmp(tipo, "GREEN") == 0 || std::strcmp(tipo, "SUCCESS") == 0 || std::strcmp(tipo, "success") == 0)
+    {
+        colorId = 32;
+    }
+    else if (std::strcmp(tipo, "YELLOW") == 0 || std::strcmp(tipo, "WARNING") == 0 || std::strcmp(tipo, "warning") == 0)
+    {
+        colorId = 33;
+    }
+    else if (std::strcmp(tipo, "CYAN") == 0 || std::strcmp(tipo, "STATUS") == 0 || std::strcmp(tipo, "status") == 0)
+    {
+        colorId = 36;
+    }
+
+    std::cout << "\033[" << colorId << "m";
+    std::cout << "[" << tipo << "] " << msj << std::endl;
+    std::cout << "\033[0m";
+}
+
+void imprimirResultado(const char* nombre, long long mensajes, double segundosLlamador, double segundosTotal)
+{
+    std::printf("%-12s mensajes=%lld  llamador=%.3f s (%.0f ns/msj)  total=%.3f s  msj/s=%.0f\n",
+                nombre, mensajes, segundosLlamador, segundosLlamador * 1e9 / mensajes, segundosTotal,
+                (segundosTotal > 0.0) ? mensajes / segundosTotal : 0.0);
+}
+}
+
+int benchRegistroLog(int argc, char** argv)
+{
+    long long mensajes = leerOpcionEntera(argc, argv, "--mensajes", 1000000);
+    const char* ruta = "/dev/null";
+    for (int i = 0; i + 1 < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--salida") == 0)
+        {
+            ruta = argv[i + 1];
+        }
+    }
+    if (mensajes <= 0)
+    {
+        std::fprintf(stderr, "--mensajes debe ser positivo\n");
+        return 1;
+    }
+
+    std::printf("Salida de los logs: %s\n", ruta);
+    AuxiliarCli cli;
+    RegistroAsincrono& registro = RegistroAsincrono::instancia();
+    double sincronoSegundos = 0.0;
+    double asincronoLlamador = 0.0;
+    double asincronoTotal = 0.0;
+    double filtradoSegundos = 0.0;
+    std::uint64_t lotesIniciales = registro.obtenerLotes();
+    {
+        RedireccionSalida redireccion(ruta);
+        if (!redireccion.activa())
+        {
+            std::fprintf(stderr, "No se pudo abrir %s\n", ruta);
+            return 1;
+        }
+
+        Cronometro cronometro;
+        for (long long i = 0; i < mensajes; ++i)
+        {
+            char mensaje[140];
+            std::snprintf(mensaje, sizeof(mensaje), "Insertando nodo float en T-%03lld.", i % 1000);
+            imprimirLogSincrono("STATUS", mensaje);
+        }
+        sincronoSegundos = cronometro.segundos();
+
+        cronometro.reiniciar();
+        for (long long i = 0; i < mensajes; ++i)
+        {
+            cli.imprimirLogFormato<NivelLog::Estado>("Insertando nodo float en T-%03lld.", i % 1000);
+        }
+        asincronoLlamador = cronometro.segundos();
+        AuxiliarCli::sincronizar();
+        asincronoTotal = cronometro.segundos();
+
+        NivelLog nivelAnterior = registro.obtenerNivelMinimo();
+        registro.establecerNivelMinimo(NivelLog::Advertencia);
+        cronometro.reiniciar();
+        for (long long i = 0; i < mensajes; ++i)
+        {
+            cli.imprimirLogFormato<NivelLog::Estado>("Insertando nodo float en T-%03lld.", i % 1000);
+        }
+        filtradoSegundos = cronometro.segundos();
+        registro.establecerNivelMinimo(nivelAnterior);
+    }
+
+    imprimirResultado("sincrono", mensajes, sincronoSegundos, sincronoSegundos);
+    imprimirResultado("asincrono", mensajes, asincronoLlamador, asincronoTotal);
+    imprimirResultado("filtrado", mensajes, filtradoSegundos, filtradoSegundos);
+    std::uint64_t lotes = registro.obtenerLotes() - lotesIniciales;
+    std::printf("lotes=%llu  mensajes/lote=%.1f\n", static_cast<unsigned long long>(lotes),
+                (lotes > 0) ? static_cast<double>(mensajes) / lotes : 0.0);
+    return 0;
+}
@@ -0,0 +1,119 @@
+/**
+ * @file BenchRegistroSensores.cpp
+ * @brief Escenario registro_sensores: ListaGeneral (nodo + sensor + llamada virtual) frente a RegistroSensores (grupos contiguos).
+ */
+
+#include <cstdio>
+#include "Escenarios.h"
+#include "MedicionBench.h"
+#include "ListaGeneral.h"
+#include "RegistroAsincrono.h"
+#include "RegistroSensores.h"
+#include "SensorPresion.h"
+#include "SensorTemperatura.h"
+
+namespace
+{
+/// Nombre del sensor s; alterna temperatura y presión como un despliegue mixto.
+void nombreSensor(long long s, char* destino, std::size_t tam)
+{
+    std::snprintf(destino, tam, "%c-%06lld", (s % 2 == 0) ? 'T' : 'P', s);
+}
+
+/// Lectura l del sensor s, la misma para ambos contenedores.
+double valorLectura(long long s, long long l)
+{
+    unsigned int semilla = static_cast<unsigned int>(s * 2654435761LL + l * 40503LL + 1);
+    return static_cast<double>((semilla >> 8) % 100000u);
+}
+
+/// Nanosegundos por sensor de una pasada.
+double nanosPorSensor(double segundos, long long pasadas, long long sensores)
+{
+    return segundos * 1e9 / static_cast<double>(pasadas * sensores);
+}
+}
+
+int benchRegistroSensores(int argc, char** argv)
+{
+    long long sensores = leerOpcionEntera(argc, argv, "--sensores", 100000);
+    long long lecturas = leerOpcionEntera(argc, argv, "--lecturas", 1);
+    long long pasadas = leerOpcionEntera(argc, argv, "--pasadas", 20);
+    if (sensores <= 0 || sensores > 999999 || lecturas < 0 || pasadas <= 0)
+    {
+        std::fprintf(stderr, "--sensores debe estar entre 1 y 999999, --lecturas no ser negativo y --pasadas positivo\n");
+        return 1;
+    }
+
+    RegistroAsincrono& registro = RegistroAsincrono::instancia();
+    NivelLog nivelAnterior = registro.obtenerNivelMinimo();
+    registro.establecerNivelMinimo(NivelLog::Error);
+
+    // Se alternan las altas en ambos contenedores, como en un proceso que registra
+    // sensores mientras recibe lecturas; los sensores de la lista quedan dispersos en el heap.
+    ListaGeneral lista;
+    RegistroSensores registroSensores;
+    char nombre[24];
+    for (long long s = 0; s < sensores; ++s)
+    {
+        nombreSensor(s, nombre, sizeof(nombre));
+        SensorBase* enLista = (s % 2 == 0) ? static_cast<SensorBase*>(new SensorTemperatura(nombre))
+                                           : static_cast<SensorBase*>(new SensorPresion(nombre));
+        lista.insertar(enLista);
+        SensorBase* enRegistro = (s % 2 == 0) ? static_cast<SensorBase*>(registroSensores.agregarTemperatura(nombre))
+                                              : static_cast<SensorBase*>(registroSensores.agregarPresion(nombre));
+        for (long long l = 0; l < lecturas; ++l)
+        {
+            enLista->registrarLecturaNumerica(valorLectura(s, l));
+            enRegistro->registrarLecturaNumerica(valorLectura(s, l));
+        }
+    }
+
+    bool correcto = registroSensores.tamano() == static_cast<std::size_t>(sensores);
+    for (long long s = 0; s < sensores && correcto; s += 997)
+    {
+        nombreSensor(s, nombre, sizeof(nombre));
+        correcto = registroSensores.buscarPorNombre(nombre) != nullptr;
+    }
+
+    std::printf("sensores=%lld  lecturas por sensor=%lld  pasadas=%lld\n", sensores, lecturas, pasadas);
+    std::printf("%-30s %16s %18s %12s\n", "pasada", "lista (ns/sensor)", "registro (ns/sensor)", "aceleracion");
+
+    // Recorrido puro: una escritura atómica por sensor, sin despacho virtual en ninguno de los dos.
+    Cronometro cronometro;
+    for (long long p = 0; p < pasadas; ++p)
+    {
+        lista.establecerIngestaConcurrente(false);
+    }
+    double recorridoLista = nanosPorSensor(cronometro.segundos(), pasadas, sensores);
+    cronometro.reiniciar();
+    for (long long p = 0; p < pasadas; ++p)
+    {
+        registroSensores.establecerIngestaConcurrente(false);
+    }
+    double recorridoRegistro = nanosPorSensor(cronometro.segundos(), pasadas, sensores);
+    std::printf("%-30s %16.2f %18.2f %11.2fx\n", "recorrer", recorridoLista, recorridoRegistro,
+                recorridoLista / recorridoRegistro);
+
+    // Procesamiento completo: procesarLectura() virtual frente a la llamada resuelta por tipo.
+    cronometro.reiniciar();
+    for (long long p = 0; p < pasadas; ++p)
+    {
+        lista.procesarSensores();
+    }
+    double procesoLista = nanosPorSensor(cronometro.segundos(), pasadas, sensores);
+    cronometro.reiniciar();
+    for (long long p = 0; p < pasadas; ++p)
+    {
+        registroSensores.procesarSensores();
+    }
+    double procesoRegistro = nanosPorSensor(cronometro.segundos(), pasadas, sensores);
+    std::printf("%-30s %16.2f %18.2f %11.2fx\n", "procesarSensores", procesoLista, procesoRegistro,
+                procesoLista / procesoRegistro);
+
+    std::printf("registro completo y buscable: %s\n", correcto ? "si" : "no");
+    lista.liberar();
+    registroSensores.liberar();
+    registro.establecerNivelMinimo(nivelAnterior);
+    return correcto ? 0 : 1;
+}
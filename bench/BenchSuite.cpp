@@ -0,0 +1,558 @@
+/**
+ * @file BenchSuite.cpp
+ * @brief Escenario suite: micro y macrobenchmarks reproducibles en varios tamaños con salida en texto, CSV o JSON.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include "Escenarios.h"
+#include "MedicionBench.h"
+#include "ListaGeneral.h"
+#include "ListaSensor.h"
+#include "ListaSensorContigua.h"
+#include "LectorSerial.h"
+#include "RegistroAsincrono.h"
+#include "RegistroSensores.h"
+#include "SensorPresion.h"
+#include "SensorTemperatura.h"
+
+namespace
+{
+/// Versión del formato de salida; cambia si cambian los campos o el significado de un caso.
+constexpr int VERSION_FORMATO = 1;
+
+/// Acumula resultados de los casos para que el compilador no descarte el trabajo medido.
+volatile double sumidero = 0.0;
+
+/// Generador xorshift32 con semilla fija: las entradas son iguales en cada corrida.
+struct Aleatorio
+{
+    std::uint32_t estado;
+
+    explicit Aleatorio(std::uint32_t semilla) : estado(semilla ? semilla : 1u) {}
+
+    std::uint32_t siguiente()
+    {
+        estado ^= estado << 13;
+        estado ^= estado >> 17;
+        estado ^= estado << 5;
+        return estado;
+    }
+};
+
+/// Nombre del sensor s; alterna temperatura y presión.
+void nombreSensor(long long s, char* destino, std::size_t tam)
+{
+    std::snprintf(destino, tam, "%c-%06lld", (s % 2 == 0) ? 'T' : 'P', s);
+}
+
+/// Da de alta n sensores alternados con k lecturas cada uno en la lista.
+void poblarLista(ListaGeneral& lista, long long n, int lecturas)
+{
+    char nombre[24];
+    Aleatorio azar(7);
+    for (long long s = 0; s < n; ++s)
+    {
+        nombreSensor(s, nombre, sizeof(nombre));
+        SensorBase* sensor = (s % 2 == 0) ? static_cast<SensorBase*>(new SensorTemperatura(nombre))
+                                          : static_cast<SensorBase*>(new SensorPresion(nombre));
+        lista.insertar(sensor);
+        for (int l = 0; l < lecturas; ++l)
+        {
+            sensor->registrarLecturaNumerica(static_cast<double>(azar.siguiente() % 100000u));
+        }
+    }
+}
+
+/// Las mismas altas y lecturas que poblarLista(), en un RegistroSensores.
+void poblarRegistro(RegistroSensores& registro, long long n, int lecturas)
+{
+    char nombre[24];
+    Aleatorio azar(7);
+    for (long long s = 0; s < n; ++s)
+    {
+        nombreSensor(s, nombre, sizeof(nombre));
+        SensorBase* sensor = (s % 2 == 0) ? static_cast<SensorBase*>(registro.agregarTemperatura(nombre))
+                                          : static_cast<SensorBase*>(registro.agregarPresion(nombre));
+        for (int l = 0; l < lecturas; ++l)
+        {
+            sensor->registrarLecturaNumerica(static_cast<double>(azar.siguiente() % 100000u));
+        }
+    }
+}
+
+// Cada caso prepara sus datos, mide solo la operación que le da nombre y
+// devuelve los segundos; en operaciones deja cuántas veces la ejecutó.
+
+double medirListaInsertar(long long n, long long& operaciones)
+{
+    ListaSensor<float> lista;
+    Cronometro cronometro;
+    for (long long i = 0; i < n; ++i)
+    {
+        lista.insertarAlFinal(static_cast<float>(i % 1000));
+    }
+    double segundos = cronometro.segundos();
+    sumidero = sumidero + lista.obtenerSuma();
+    operaciones = n;
+    return segundos;
+}
+
+double medirListaExtremos(long long n, long long& operaciones)
+{
+    ListaSensor<float> lista;
+    Aleatorio azar(11);
+    for (long long i = 0; i < n; ++i)
+    {
+        lista.insertarAlFinal(static_cast<float>(azar.siguiente() % 100000u));
+    }
+    // Extraer de la cabeza retira de vez en cuando el mínimo o el máximo vigente.
+    long long consultas = (n < 100000) ? n : 100000;
+    float valor = 0.0f;
+    float minimo = 0.0f;
+    float maximo = 0.0f;
+    Cronometro cronometro;
+    for (long long i = 0; i < consultas; ++i)
+    {
+        lista.extraerPrimero(valor);
+        lista.obtenerMinimo(minimo);
+        lista.obtenerMaximo(maximo);
+        sumidero = sumidero + lista.promedio() + minimo + maximo;
+    }
+    double segundos = cronometro.segundos();
+    operaciones = consultas;
+    return segundos;
+}
+
+double medirListaRango(long long n, long long& operaciones)
+{
+    ListaSensor<int> lista;
+    Aleatorio azar(13);
+    for (long long i = 0; i < n; ++i)
+    {
+        lista.insertarAlFinal(static_cast<int>(azar.siguiente() % 100000u), i);
+    }
+    long long consultas = 10000;
+    Cronometro cronometro;
+    for (long long q = 0; q < consultas; ++q)
+    {
+        std::int64_t desde = static_cast<std::int64_t>(azar.siguiente() % static_cast<std::uint32_t>(n));
+        sumidero = sumidero + lista.resumirRango(desde, desde + n / 10 + 1).suma;
+    }
+    double segundos = cronometro.segundos();
+    operaciones = consultas;
+    return segundos;
+}
+
+double medirListaLimpiar(long long n, long long& operaciones)
+{
+    ListaSensor<float> lista;
+    for (long long i = 0; i < n; ++i)
+    {
+        lista.insertarAlFinal(static_cast<float>(i % 1000));
+    }
+    Cronometro cronometro;
+    lista.limpiar();
+    double segundos = cronometro.segundos();
+    operaciones = n;
+    return segundos;
+}
+
+double medirContiguaAgregados(long long n, long long& operaciones)
+{
+    ListaSensorContigua<float> lista;
+    Aleatorio azar(17);
+    for (long long i = 0; i < n; ++i)
+    {
+        lista.insertarAlFinal(static_cast<float>(azar.siguiente() % 100000u));
+    }
+    float minimo = 0.0f;
+    float maximo = 0.0f;
+    Cronometro cronometro;
+    lista.obtenerExtremos(minimo, maximo);
+    double varianza = lista.varianza();
+    std::size_t mayores = lista.contarMayoresQue(50000.0f);
+    double segundos = cronometro.segundos();
+    sumidero = sumidero + minimo + maximo + varianza + static_cast<double>(mayores);
+    operaciones = n;
+    return segundos;
+}
+
+double medirBuscarPorNombre(long long n, long long& operaciones)
+{
+    ListaGeneral lista;
+    poblarLista(lista, n, 0);
+    char* nombres = new char[static_cast<std::size_t>(n) * 16];
+    Aleatorio azar(19);
+    for (long long i = 0; i < n; ++i)
+    {
+        nombreSensor(static_cast<long long>(azar.siguiente() % static_cast<std::uint32_t>(n)), nombres + i * 16, 16);
+    }
+    std::size_t encontrados = 0;
+    Cronometro cronometro;
+    for (long long i = 0; i < n; ++i)
+    {
+        encontrados += lista.buscarPorNombre(nombres + i * 16) != nullptr;
+    }
+    double segundos = cronometro.segundos();
+    sumidero = sumidero + static_cast<double>(encontrados);
+    delete[] nombres;
+    operaciones = n;
+    return segundos;
+}
+
+double medirBuscarPorId(long long n, long long& operaciones)
+{
+    ListaGeneral lista;
+    poblarLista(lista, n, 0);
+    Aleatorio azar(23);
+    std::size_t encontrados = 0;
+    Cronometro cronometro;
+    for (long long i = 0; i < n; ++i)
+    {
+        std::uint32_t s = azar.siguiente() % static_cast<std::uint32_t>(n);
+        encontrados += lista.buscarPorId((s % 2 == 0) ? 'T' : 'P', static_cast<std::uint16_t>(s)) != nullptr;
+    }
+    double segundos = cronometro.segundos();
+    sumidero = sumidero + static_cast<double>(encontrados);
+    operaciones = n;
+    return segundos;
+}
+
+/// Llena un buffer con n líneas "ID,valor" terminadas en nulo, cada una en TAM_SERIAL bytes.
+char* generarLineas(long long n)
+{
+    char* lineas = new char[static_cast<std::size_t>(n) * TAM_SERIAL];
+    Aleatorio azar(29);
+    for (long long i = 0; i < n; ++i)
+    {
+        std::uint32_t valor = azar.siguiente() % 100000u;
+        std::snprintf(lineas + i * TAM_SERIAL, TAM_SERIAL, "%c-%03u, %u.%u", (i % 2 == 0) ? 'T' : 'P',
+                      static_cast<unsigned>(i % 1000), valor / 10u, valor % 10u);
+    }
+    return lineas;
+}
+
+double medirDescomponerLinea(long long n, long long& operaciones)
+{
+    char* lineas = generarLineas(n);
+    char id[TAM_ID];
+    char valor[TAM_SERIAL];
+    std::size_t validas = 0;
+    Cronometro cronometro;
+    for (long long i = 0; i < n; ++i)
+    {
+        validas += descomponerLineaSerial(lineas + i * TAM_SERIAL, id, sizeof(id), valor, sizeof(valor));
+    }
+    double segundos = cronometro.segundos();
+    sumidero = sumidero + static_cast<double>(validas);
+    delete[] lineas;
+    operaciones = n;
+    return segundos;
+}
+
+double medirAnalizarLinea(long long n, long long& operaciones)
+{
+    char* lineas = generarLineas(n);
+    std::size_t validas = 0;
+    Cronometro cronometro;
+    for (long long i = 0; i < n; ++i)
+    {
+        const char* linea = lineas + i * TAM_SERIAL;
+        LineaSerial campos;
+        validas += analizarLineaSerial(linea, std::strlen(linea), campos);
+    }
+    double segundos = cronometro.segundos();
+    sumidero = sumidero + static_cast<double>(validas);
+    delete[] lineas;
+    operaciones = n;
+    return segundos;
+}
+
+double medirProcesarLista(long long n, long long& operaciones)
+{
+    ListaGeneral lista;
+    poblarLista(lista, n, 4);
+    Cronometro cronometro;
+    lista.procesarSensores();
+    double segundos = cronometro.segundos();
+    operaciones = n;
+    return segundos;
+}
+
+double medirProcesarRegistro(long long n, long long& operaciones)
+{
+    RegistroSensores registro;
+    poblarRegistro(registro, n, 4);
+    Cronometro cronometro;
+    registro.procesarSensores();
+    double segundos = cronometro.segundos();
+    operaciones = n;
+    return segundos;
+}
+
+double medirLiberarLista(long long n, long long& operaciones)
+{
+    ListaGeneral lista;
+    poblarLista(lista, n, 4);
+    Cronometro cronometro;
+    lista.liberar();
+    double segundos = cronometro.segundos();
+    operaciones = n;
+    return segundos;
+}
+
+/// Sensor de temperatura con n lecturas registradas sin log.
+SensorTemperatura* sensorConLecturas(long long n)
+{
+    SensorTemperatura* sensor = new SensorTemperatura("T-000");
+    for (long long i = 0; i < n; ++i)
+    {
+        sensor->registrarLecturaNumerica(static_cast<double>(i % 1000));
+    }
+    return sensor;
+}
+
+double medirDestructorDetallado(long long n, long long& operaciones)
+{
+    SensorTemperatura* sensor = sensorConLecturas(n);
+    // El detalle por lectura solo cuesta con el log activo; se descarta en /dev/null y se espera a que se escriba.
+    RegistroAsincrono& registro = RegistroAsincrono::instancia();
+    registro.establecerNivelMinimo(NivelLog::Estado);
+    double segundos = 0.0;
+    {
+        RedireccionSalida descarte("/dev/null");
+        Cronometro cronometro;
+        delete sensor;
+        AuxiliarCli::sincronizar();
+        segundos = cronometro.segundos();
+    }
+    registro.establecerNivelMinimo(NivelLog::Error);
+    operaciones = n;
+    return segundos;
+}
+
+double medirLiberarHistorial(long long n, long long& operaciones)
+{
+    SensorTemperatura* sensor = sensorConLecturas(n);
+    Cronometro cronometro;
+    ResumenLiberacion resumen;
+    sensor->liberarHistorial(resumen);
+    delete sensor;
+    double segundos = cronometro.segundos();
+    sumidero = sumidero + static_cast<double>(resumen.bytes);
+    operaciones = n;
+    return segundos;
+}
+
+double medirLiberarEnBloque(long long n, long long& operaciones)
+{
+    ListaGeneral lista;
+    poblarLista(lista, n, 4);
+    Cronometro cronometro;
+    lista.liberarEnBloque();
+    double segundos = cronometro.segundos();
+    operaciones = n;
+    return segundos;
+}
+
+/// Un caso de la suite: nombre estable para comparar corridas y tamaño máximo razonable.
+struct Caso
+{
+    const char* nombre;
+    const char* unidad;
+    long long tamanoMaximo;
+    double (*medir)(long long, long long&);
+};
+
+const Caso casos[] = {
+    {"lista.insertar_al_final", "lectura", 1000000, medirListaInsertar},
+    {"lista.extremos_tras_extraer", "consulta", 1000000, medirListaExtremos},
+    {"lista.resumir_rango", "consulta", 1000000, medirListaRango},
+    {"lista.limpiar", "lectura", 1000000, medirListaLimpiar},
+    {"contigua.agregados", "lectura", 1000000, medirContiguaAgregados},
+    {"general.buscar_por_nombre", "busqueda", 100000, medirBuscarPorNombre},
+    {"general.buscar_por_id", "busqueda", 100000, medirBuscarPorId},
+    {"analisis.descomponer_linea", "linea", 1000000, medirDescomponerLinea},
+    {"analisis.analizar_linea", "linea", 1000000, medirAnalizarLinea},
+    {"general.procesar_sensores", "sensor", 100000, medirProcesarLista},
+    {"registro.procesar_sensores", "sensor", 100000, medirProcesarRegistro},
+    {"general.liberar", "sensor", 100000, medirLiberarLista},
+    {"general.liberar_en_bloque", "sensor", 100000, medirLiberarEnBloque},
+    {"sensor.destructor_con_log", "lectura", 1000000, medirDestructorDetallado},
+    {"sensor.liberar_historial", "lectura", 1000000, medirLiberarHistorial},
+};
+
+const long long tamanos[] = {1000, 10000, 100000, 1000000};
+
+/// Resultado de un caso en un tamaño, ya resumido sobre las repeticiones.
+struct Resultado
+{
+    const Caso* caso;
+    long long tamano;
+    long long operaciones;
+    double nsMediana;
+    double nsMinimo;
+};
+
+enum class Formato
+{
+    Texto,
+    Csv,
+    Json
+};
+
+void ordenar(double* valores, int cantidad)
+{
+    for (int i = 1; i < cantidad; ++i)
+    {
+        double valor = valores[i];
+        int j = i - 1;
+        for (; j >= 0 && valores[j] > valor; --j)
+        {
+            valores[j + 1] = valores[j];
+        }
+        valores[j + 1] = valor;
+    }
+}
+
+void escribirResultados(std::FILE* salida, Formato formato, const Resultado* resultados, std::size_t cantidad,
+                        int repeticiones)
+{
+    char fecha[32];
+    std::time_t ahora = std::time(nullptr);
+    std::strftime(fecha, sizeof(fecha), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&ahora));
+
+    if (formato == Formato::Csv)
+    {
+        std::fprintf(salida, "caso,tamano,unidad,operaciones,ns_por_op_mediana,ns_por_op_minimo\n");
+        for (std::size_t i = 0; i < cantidad; ++i)
+        {
+            const Resultado& r = resultados[i];
+            std::fprintf(salida, "%s,%lld,%s,%lld,%.3f,%.3f\n", r.caso->nombre, r.tamano, r.caso->unidad,
+                         r.operaciones, r.nsMediana, r.nsMinimo);
+        }
+        return;
+    }
+
+    if (formato == Formato::Json)
+    {
+        std::fprintf(salida, "{\n  \"suite\": \"gestion_sensores\",\n  \"version_formato\": %d,\n", VERSION_FORMATO);
+        std::fprintf(salida, "  \"fecha\": \"%s\",\n  \"compilador\": \"%s\",\n  \"repeticiones\": %d,\n", fecha,
+                     __VERSION__, repeticiones);
+        std::fprintf(salida, "  \"resultados\": [\n");
+        for (std::size_t i = 0; i < cantidad; ++i)
+        {
+            const Resultado& r = resultados[i];
+            std::fprintf(salida,
+                         "    {\"caso\": \"%s\", \"tamano\": %lld, \"unidad\": \"%s\", \"operaciones\": %lld, "
+                         "\"ns_por_op_mediana\": %.3f, \"ns_por_op_minimo\": %.3f}%s\n",
+                         r.caso->nombre, r.tamano, r.caso->unidad, r.operaciones, r.nsMediana, r.nsMinimo,
+                         (i + 1 < cantidad) ? "," : "");
+        }
+        std::fprintf(salida, "  ]\n}\n");
+        return;
+    }
+
+    std::fprintf(salida, "suite gestion_sensores  %s  repeticiones=%d\n", fecha, repeticiones);
+    std::fprintf(salida, "%-30s %10s %12s %14s %14s\n", "caso", "tamano", "operaciones", "mediana ns/op",
+                 "minimo ns/op");
+    for (std::size_t i = 0; i < cantidad; ++i)
+    {
+        const Resultado& r = resultados[i];
+        std::fprintf(salida, "%-30s %10lld %12lld %14.2f %14.2f\n", r.caso->nombre, r.tamano, r.operaciones,
+                     r.nsMediana, r.nsMinimo);
+    }
+}
+}
+
+int benchSuite(int argc, char** argv)
+{
+    long long repeticiones = leerOpcionEntera(argc, argv, "--repeticiones", 5);
+    long long tamanoMaximo = leerOpcionEntera(argc, argv, "--tamano-max", 1000000);
+    const char* textoFormato = leerOpcionTexto(argc, argv, "--formato", "texto");
+    const char* ruta = leerOpcionTexto(argc, argv, "--salida", nullptr);
+    const char* filtro = leerOpcionTexto(argc, argv, "--caso", nullptr);
+
+    Formato formato = Formato::Texto;
+    if (std::strcmp(textoFormato, "csv") == 0)
+    {
+        formato = Formato::Csv;
+    }
+    else if (std::strcmp(textoFormato, "json") == 0)
+    {
+        formato = Formato::Json;
+    }
+    else if (std::strcmp(textoFormato, "texto") != 0)
+    {
+        std::fprintf(stderr, "--formato debe ser texto, csv o json\n");
+        return 1;
+    }
+    if (repeticiones <= 0 || repeticiones > 1000 || tamanoMaximo < 1000)
+    {
+        std::fprintf(stderr, "--repeticiones debe estar entre 1 y 1000 y --tamano-max ser al menos 1000\n");
+        return 1;
+    }
+
+    RegistroAsincrono& registro = RegistroAsincrono::instancia();
+    NivelLog nivelAnterior = registro.obtenerNivelMinimo();
+    registro.establecerNivelMinimo(NivelLog::Error);
+
+    const std::size_t maxResultados = sizeof(casos) / sizeof(casos[0]) * sizeof(tamanos) / sizeof(tamanos[0]);
+    Resultado* resultados = new Resultado[maxResultados];
+    double* muestras = new double[repeticiones];
+    std::size_t cantidad = 0;
+    for (const Caso& caso : casos)
+    {
+        if (filtro && std::strstr(caso.nombre, filtro) == nullptr)
+        {
+            continue;
+        }
+        for (long long tamano : tamanos)
+        {
+            if (tamano > caso.tamanoMaximo || tamano > tamanoMaximo)
+            {
+                continue;
+            }
+            long long operaciones = 0;
+            for (long long r = 0; r < repeticiones; ++r)
+            {
+                double segundos = caso.medir(tamano, operaciones);
+                muestras[r] = segundos * 1e9 / static_cast<double>(operaciones > 0 ? operaciones : 1);
+            }
+            ordenar(muestras, static_cast<int>(repeticiones));
+            Resultado& resultado = resultados[cantidad++];
+            resultado.caso = &caso;
+            resultado.tamano = tamano;
+            resultado.operaciones = operaciones;
+            resultado.nsMediana = muestras[repeticiones / 2];
+            resultado.nsMinimo = muestras[0];
+            if (ruta)
+            {
+                std::fprintf(stderr, "%-30s %10lld %14.2f ns/op\n", caso.nombre, tamano, resultado.nsMediana);
+            }
+        }
+    }
+    registro.establecerNivelMinimo(nivelAnterior);
+
+    int codigo = 0;
+    std::FILE* salida = ruta ? std::fopen(ruta, "w") : stdout;
+    if (!salida)
+    {
+        std::fprintf(stderr, "No se pudo abrir %s\n", ruta);
+        codigo = 1;
+    }
+    else
+    {
+        escribirResultados(salida, formato, resultados, cantidad, static_cast<int>(repeticiones));
+        if (salida != stdout)
+        {
+            std::fclose(salida);
+        }
+    }
+    delete[] muestras;
+    delete[] resultados;
+    return codigo;
+}
@@ -0,0 +1,109 @@
+/**
+ * @file BenchVentanaDeslizante.cpp
+ * @brief Escenario ventana_deslizante: costo por lectura de HistorialVentana frente a recalcular la ventana.
+ */
+
+#include <cstdio>
+#include "Escenarios.h"
+#include "MedicionBench.h"
+#include "HistorialVentana.h"
+#include "ListaSensor.h"
+
+namespace
+{
+/// Genera lecturas pseudoaleatorias reproducibles.
+float siguienteLectura(unsigned int& semilla)
+{
+    semilla = semilla * 1103515245u + 12345u;
+    return static_cast<float>((semilla >> 8) % 100000u) / 100.0f;
+}
+
+/// Inserta en la ventana y consulta media, mínimo y máximo tras cada lectura.
+double medirVentana(std::size_t tamano, long long lecturas, double& control)
+{
+    PoliticaRetencion politica;
+    politica.maxLecturas = tamano;
+    HistorialVentana<float> ventana(politica);
+    unsigned int semilla = 1u;
+
+    Cronometro cronometro;
+    for (long long i = 0; i < lecturas; ++i)
+    {
+        ventana.insertarEn(siguienteLectura(semilla), i);
+        float minimo = 0.0f;
+        float maximo = 0.0f;
+        ventana.obtenerMinimo(minimo);
+        ventana.obtenerMaximo(maximo);
+        control += ventana.promedio() + minimo + maximo;
+    }
+    return cronometro.segundos();
+}
+
+/// Referencia ingenua: buffer circular y recorrido completo de la ventana en cada consulta.
+double medirRecalculo(std::size_t tamano, long long lecturas, double& control)
+{
+    float* buffer = new float[tamano];
+    std::size_t ocupadas = 0;
+    unsigned int semilla = 1u;
+
+    Cronometro cronometro;
+    for (long long i = 0; i < lecturas; ++i)
+    {
+        buffer[static_cast<std::size_t>(i) % tamano] = siguienteLectura(semilla);
+        if (ocupadas < tamano)
+        {
+            ++ocupadas;
+        }
+
+        double suma = 0.0;
+        float minimo = buffer[0];
+        float maximo = buffer[0];
+        for (std::size_t j = 0; j < ocupadas; ++j)
+        {
+            suma += buffer[j];
+            minimo = (buffer[j] < minimo) ? buffer[j] : minimo;
+            maximo = (maximo < buffer[j]) ? buffer[j] : maximo;
+        }
+        control += suma / ocupadas + minimo + maximo;
+    }
+    double segundos = cronometro.segundos();
+    delete[] buffer;
+    return segundos;
+}
+}
+
+int benchVentanaDeslizante(int argc, char** argv)
+{
+    long long lecturas = leerOpcionEntera(argc, argv, "--lecturas", 2000000);
+    long long lecturasRecalculo = leerOpcionEntera(argc, argv, "--lecturas-recalculo", 200000);
+    if (lecturas <= 0 || lecturasRecalculo <= 0)
+    {
+        std::fprintf(stderr, "--lecturas y --lecturas-recalculo deben ser positivos\n");
+        return 1;
+    }
+
+    const std::size_t tamanos[] = {64, 1024, 16384, 262144};
+    std::printf("%-9s %14s %14s %12s %16s\n", "ventana", "ns/lect_vent", "ns/lect_recalc", "aceleracion", "bytes_ventana");
+    for (std::size_t tamano : tamanos)
+    {
+        double control = 0.0;
+        double ventana = medirVentana(tamano, lecturas, control) * 1e9 / lecturas;
+        double recalculo = medirRecalculo(tamano, lecturasRecalculo, control) * 1e9 / lecturasRecalculo;
+
+        PoliticaRetencion politica;
+        politica.maxLecturas = tamano;
+        HistorialVentana<float> muestra(politica);
+        std::printf("%-9zu %14.1f %14.1f %11.1fx %16zu   (control=%.0f)\n", tamano, ventana, recalculo,
+                    recalculo / ventana, muestra.bytesReservados(), control);
+    }
+
+    // Referencia de memoria: el historial ilimitado crece con cada lectura.
+    ListaSensor<float> ilimitada;
+    unsigned int semilla = 1u;
+    for (long long i = 0; i < lecturas; ++i)
+    {
+        ilimitada.insertarAlFinal(siguienteLectura(semilla));
+    }
+    std::printf("lista ilimitada tras %lld lecturas: %zu bytes\n", lecturas, ilimitada.bytesReservados());
+    return 0;
+}
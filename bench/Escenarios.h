@@ -0,0 +1,45 @@
+/**
+ * @file Escenarios.h
+ * @brief Declaración de los escenarios disponibles en gestion_sensores_bench.
+ */
+#ifndef ESCENARIOS_H
+#define ESCENARIOS_H
+
+/// Mide líneas por segundo del lector serial por bloques frente al lector byte a byte.
+int benchLecturaSerial(int argc, char** argv);
+/// Mide MotorIngesta con varios pseudo-terminales emitiendo a la vez.
+int benchIngestaMultipuerto(int argc, char** argv);
+/// Reporta latencia y rendimiento de distintas configuraciones de puerto sobre un pty.
+int benchLatenciaPuerto(int argc, char** argv);
+/// Compara el análisis de líneas con copias y atof/atoi frente a vistas y from_chars.
+int benchAnalisisLineas(int argc, char** argv);
+/// Compara imprimirLog síncrono con flush por mensaje frente al backend asíncrono por lotes.
+int benchRegistroLog(int argc, char** argv);
+/// Mide procesarSensoresEnParalelo de 1 a N hilos y verifica que la salida no cambie.
+int benchProcesamientoParalelo(int argc, char** argv);
+/// Estrés de ingesta concurrente mientras se procesa; apto para ThreadSanitizer.
+int benchIngestaConcurrente(int argc, char** argv);
+/// Compara HistorialVentana (O(1) por lectura) con recalcular media y extremos de la ventana.
+int benchVentanaDeslizante(int argc, char** argv);
+/// Mide los núcleos AVX2/SSE4.1/escalar de ListaSensorContigua frente a recorrer ListaSensor.
+int benchAgregadosSimd(int argc, char** argv);
+/// Compara pasar lotes entre historiales copiando nodo a nodo frente a concatenar() en O(1).
+int benchEmpalmeHistoriales(int argc, char** argv);
+/// Compara decodificar texto ID,valor con tramas binarias de 1, 8 y 32 lecturas.
+int benchDecodificacionBinaria(int argc, char** argv);
+/// Mide anexar a columnas mapeadas en disco, el reinicio perezoso y la recuperación tras una caída.
+int benchAlmacenHistorial(int argc, char** argv);
+/// Compara resumirRango() con índice temporal frente a recorrer la lista, antes y después de bajas y empalmes.
+int benchConsultasRango(int argc, char** argv);
+/// Verifica que resumirRango() siga siendo sublineal cuando parte de las lecturas llega con marcas atrasadas.
+int benchConsultasDesordenadas(int argc, char** argv);
+/// Compara procesar ListaGeneral (nodo, sensor y llamada virtual) con RegistroSensores agrupado por tipo.
+int benchRegistroSensores(int argc, char** argv);
+/// Suite reproducible de inserción, búsqueda, análisis, agregados, procesamiento y liberación en varios tamaños.
+int benchSuite(int argc, char** argv);
+/// Compara lectores que insertan en los sensores con lectores que publican en ColaIngesta (MPSC) hacia un consumidor.
+int benchColaIngesta(int argc, char** argv);
+/// Compara insertar lectura por lectura con insertarLote() y registrarLoteNumericoEn(), con y sin log.
+int benchInsercionLotes(int argc, char** argv);
+
+#endif
@@ -0,0 +1,121 @@
+/**
+ * @file MedicionBench.h
+ * @brief Utilidades comunes de los escenarios de benchmark: cronómetro, lectura de opciones y redirección de stdout.
+ */
+#ifndef MEDICIONBENCH_H
+#define MEDICIONBENCH_H
+
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+/**
+ * @brief Cronómetro monotónico de alta resolución.
+ */
+class Cronometro
+{
+public:
+    Cronometro() : inicio(std::chrono::steady_clock::now()) {}
+
+    /// Reinicia la medición.
+    void reiniciar()
+    {
+        inicio = std::chrono::steady_clock::now();
+    }
+
+    /// Segundos transcurridos desde la construcción o el último reinicio.
+    double segundos() const
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point inicio;
+};
+
+/**
+ * @brief Busca una opción "--nombre valor" en los argumentos y la convierte a entero.
+ * @return El valor encontrado o porOmision si la opción no aparece.
+ */
+inline long long leerOpcionEntera(int argc, char** argv, const char* nombre, long long porOmision)
+{
+    for (int i = 0; i + 1 < argc; ++i)
+    {
+        if (std::strcmp(argv[i], nombre) == 0)
+        {
+            return std::atoll(argv[i + 1]);
+        }
+    }
+    return porOmision;
+}
+
+/**
+ * @brief Busca una opción "--nombre valor" en los argumentos y devuelve el texto del valor.
+ * @return El valor encontrado o porOmision si la opción no aparece.
+ */
+inline const char* leerOpcionTexto(int argc, char** argv, const char* nombre, const char* porOmision)
+{
+    for (int i = 0; i + 1 < argc; ++i)
+    {
+        if (std::strcmp(argv[i], nombre) == 0)
+        {
+            return argv[i + 1];
+        }
+    }
+    return porOmision;
+}
+
+/// Indica si la bandera "--nombre" aparece en los argumentos.
+inline bool tieneBandera(int argc, char** argv, const char* nombre)
+{
+    for (int i = 0; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], nombre) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/// Redirige stdout al destino indicado mientras dura la medición.
+class RedireccionSalida
+{
+public:
+    explicit RedireccionSalida(const char* ruta) : original(-1)
+    {
+        int destino = open(ruta, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (destino < 0)
+        {
+            return;
+        }
+        std::fflush(stdout);
+        original = dup(STDOUT_FILENO);
+        dup2(destino, STDOUT_FILENO);
+        close(destino);
+    }
+
+    ~RedireccionSalida()
+    {
+        if (original >= 0)
+        {
+            std::fflush(stdout);
+            dup2(original, STDOUT_FILENO);
+            close(original);
+        }
+    }
+
+    /// Indica si la redirección quedó vigente.
+    bool activa() const
+    {
+        return original >= 0;
+    }
+
+private:
+    int original;
+};
+
+#endif
@@ -0,0 +1,71 @@
+/**
+ * @file main.cpp
+ * @brief Punto de entrada de gestion_sensores_bench: despacha al escenario solicitado.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include "Escenarios.h"
+
+namespace
+{
+/// Asocia el nombre de un escenario con la función que lo ejecuta.
+struct EntradaEscenario
+{
+    const char* nombre;
+    const char* descripcion;
+    int (*ejecutar)(int, char**);
+};
+
+const EntradaEscenario escenarios[] = {
+    {"lectura_serial", "Lector serial por bloques vs byte a byte (--lineas N, --pty)", benchLecturaSerial},
+    {"ingesta_multipuerto", "MotorIngesta con N pseudo-terminales (--puertos N, --lineas N)", benchIngestaMultipuerto},
+    {"latencia_puerto", "Latencia/rendimiento por baudios, VMIN/VTIME y baja latencia (--repeticiones N, --lineas N)", benchLatenciaPuerto},
+    {"analisis_lineas", "Análisis ID,valor con copias+atof vs vistas+from_chars (--lineas N, --repeticiones N)", benchAnalisisLineas},
+    {"registro_log", "Logs síncronos con std::endl vs cola asíncrona por lotes (--mensajes N, --salida ruta)", benchRegistroLog},
+    {"procesamiento_paralelo", "Escalamiento del procesamiento con robo de trabajo de 1 a N hilos (--sensores N, --lecturas N, --hilos-max N)", benchProcesamientoParalelo},
+    {"ingesta_concurrente", "Estrés de anexos sin candados mientras se procesa (--productores N, --lecturas N, --sensores N)", benchIngestaConcurrente},
+    {"ventana_deslizante", "Ventana circular con colas monótonas vs recálculo por lectura (--lecturas N)", benchVentanaDeslizante},
+    {"agregados_simd", "Suma, extremos, conteo y varianza contiguos por nivel SIMD vs lista enlazada (--exponente-min N, --exponente-max N)", benchAgregadosSimd},
+    {"empalme_historiales", "Traspaso de lotes buffer->archivo copiando vs concatenar() (--lecturas N)", benchEmpalmeHistoriales},
+    {"decodificacion_binaria", "Decodificación texto ID,valor vs tramas binarias por lotes (--lecturas N, --sensores N)", benchDecodificacionBinaria},
+    {"almacen_historial", "Historial en disco: anexar, msync, reinicio perezoso y recuperación tras SIGKILL (--lecturas N, --sensores N, --directorio ruta)", benchAlmacenHistorial},
+    {"consultas_rango", "Resumen por intervalo de tiempo con índice por tramos vs recorrer la lista (--lecturas N, --consultas N)", benchConsultasRango},
+    {"consultas_desordenadas", "Resumen por intervalo con marcas atrasadas en historiales crecientes; falla si el costo crece linealmente (--lecturas N, --consultas N, --atrasadas P, --retraso-ms N)", benchConsultasDesordenadas},
+    {"registro_sensores", "Pasadas sobre ListaGeneral vs grupos contiguos por tipo sin despacho virtual (--sensores N, --lecturas N, --pasadas N)", benchRegistroSensores},
+    {"suite", "Micro y macrobenchmarks en varios tamaños, salida para seguimiento de regresiones (--formato texto|csv|json, --salida ruta, --repeticiones N, --tamano-max N, --caso texto)", benchSuite},
+    {"cola_ingesta", "Lectores con inserción directa vs cola MPSC hacia un consumidor, con presión y descarte (--puertos N, --lineas N, --capacidad N)", benchColaIngesta},
+    {"insercion_lotes", "Inserción lectura por lectura vs lotes en ListaSensor y en el sensor, con y sin log (--lecturas N)", benchInsercionLotes},
+};
+
+void mostrarUso(const char* programa)
+{
+    std::printf("Uso: %s <escenario> [opciones]\n\nEscenarios:\n", programa);
+    for (const EntradaEscenario& entrada : escenarios)
+    {
+        std::printf("  %-20s %s\n", entrada.nombre, entrada.descripcion);
+    }
+}
+}
+
+/** @brief Ejecuta el escenario indicado como primer argumento. */
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        mostrarUso(argv[0]);
+        return 1;
+    }
+
+    for (const EntradaEscenario& entrada : escenarios)
+    {
+        if (std::strcmp(argv[1], entrada.nombre) == 0)
+        {
+            return entrada.ejecutar(argc - 2, argv + 2);
+        }
+    }
+
+    std::fprintf(stderr, "Escenario desconocido: %s\n\n", argv[1]);
+    mostrarUso(argv[0]);
+    return 1;
+}
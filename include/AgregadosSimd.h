@@ -0,0 +1,618 @@
+/**
+ * @file AgregadosSimd.h
+ * @brief Núcleos de agregación (suma, extremos, conteo sobre umbral, varianza) con AVX2, SSE4.1 o C++ escalar.
+ */
+#ifndef AGREGADOSSIMD_H
+#define AGREGADOSSIMD_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define GESTION_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define GESTION_SIMD_X86 0
+#endif
+
+/// Juego de instrucciones que usan los núcleos de AgregadosSimd.
+enum class NivelSimd
+{
+    Escalar = 0,
+    Sse41 = 1,
+    Avx2 = 2
+};
+
+/**
+ * @brief Agregados sobre arreglos contiguos de float o int.
+ *
+ * Cada operación tiene una versión escalar portable y, en x86 con GCC o
+ * Clang, versiones SSE4.1 y AVX2 compiladas con el atributo target, de modo
+ * que el binario no exige esas extensiones: el nivel se elige en tiempo de
+ * ejecución consultando la CPU y puede bajarse con establecerNivel() para
+ * comparar implementaciones.
+ *
+ * Las sumas de float se acumulan en double y las de int en enteros de 64
+ * bits. Como las versiones vectoriales suman en otro orden, los resultados de
+ * float pueden diferir de la escalar en el último dígito; los de int son
+ * idénticos. Los valores NaN no están contemplados.
+ */
+class AgregadosSimd
+{
+public:
+    /// Mejor nivel que soporta la CPU actual.
+    static NivelSimd nivelDetectado()
+    {
+        static const NivelSimd detectado = detectar();
+        return detectado;
+    }
+
+    /// Nivel con el que se ejecutan los núcleos.
+    static NivelSimd nivelActivo()
+    {
+        return static_cast<NivelSimd>(nivelElegido().load(std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief Fija el nivel de los núcleos; si la CPU no lo soporta se usa el detectado.
+     * @return Nivel que quedó activo.
+     */
+    static NivelSimd establecerNivel(NivelSimd nivel)
+    {
+        if (static_cast<int>(nivel) > static_cast<int>(nivelDetectado()))
+        {
+            nivel = nivelDetectado();
+        }
+        nivelElegido().store(static_cast<int>(nivel), std::memory_order_relaxed);
+        return nivel;
+    }
+
+    /// Nombre legible del nivel.
+    static const char* nombreNivel(NivelSimd nivel)
+    {
+        switch (nivel)
+        {
+        case NivelSimd::Avx2:
+            return "avx2";
+        case NivelSimd::Sse41:
+            return "sse4.1";
+        default:
+            return "escalar";
+        }
+    }
+
+    /// Suma de los valores.
+    static double sumar(const float* datos, std::size_t cantidad)
+    {
+#if GESTION_SIMD_X86
+        switch (nivelActivo())
+        {
+        case NivelSimd::Avx2:
+            return sumarAvx2(datos, cantidad);
+        case NivelSimd::Sse41:
+            return sumarSse(datos, cantidad);
+        default:
+            break;
+        }
+#endif
+        return sumarEscalar(datos, cantidad);
+    }
+
+    /// Suma exacta de los valores (acumulada en 64 bits).
+    static double sumar(const int* datos, std::size_t cantidad)
+    {
+#if GESTION_SIMD_X86
+        switch (nivelActivo())
+        {
+        case NivelSimd::Avx2:
+            return static_cast<double>(sumarAvx2(datos, cantidad));
+        case NivelSimd::Sse41:
+            return static_cast<double>(sumarSse(datos, cantidad));
+        default:
+            break;
+        }
+#endif
+        return static_cast<double>(sumarEscalar(datos, cantidad));
+    }
+
+    /// Mínimo y máximo en una sola pasada; false si no hay datos.
+    static bool extremos(const float* datos, std::size_t cantidad, float& minimo, float& maximo)
+    {
+        return extremosDespachados(datos, cantidad, minimo, maximo);
+    }
+
+    /// Mínimo y máximo en una sola pasada; false si no hay datos.
+    static bool extremos(const int* datos, std::size_t cantidad, int& minimo, int& maximo)
+    {
+        return extremosDespachados(datos, cantidad, minimo, maximo);
+    }
+
+    /// Cuántos valores son estrictamente mayores que el umbral.
+    static std::size_t contarMayoresQue(const float* datos, std::size_t cantidad, float umbral)
+    {
+        return contarDespachado(datos, cantidad, umbral);
+    }
+
+    /// Cuántos valores son estrictamente mayores que el umbral.
+    static std::size_t contarMayoresQue(const int* datos, std::size_t cantidad, int umbral)
+    {
+        return contarDespachado(datos, cantidad, umbral);
+    }
+
+    /// Varianza poblacional en dos pasadas (media y luego desviaciones al cuadrado).
+    static double varianza(const float* datos, std::size_t cantidad)
+    {
+        return varianzaDespachada(datos, cantidad);
+    }
+
+    /// Varianza poblacional en dos pasadas (media y luego desviaciones al cuadrado).
+    static double varianza(const int* datos, std::size_t cantidad)
+    {
+        return varianzaDespachada(datos, cantidad);
+    }
+
+private:
+    static std::atomic<int>& nivelElegido()
+    {
+        static std::atomic<int> nivel(static_cast<int>(nivelDetectado()));
+        return nivel;
+    }
+
+    static NivelSimd detectar()
+    {
+#if GESTION_SIMD_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return NivelSimd::Avx2;
+        }
+        if (__builtin_cpu_supports("sse4.1"))
+        {
+            return NivelSimd::Sse41;
+        }
+#endif
+        return NivelSimd::Escalar;
+    }
+
+    template <typename T>
+    static bool extremosDespachados(const T* datos, std::size_t cantidad, T& minimo, T& maximo)
+    {
+        if (cantidad == 0)
+        {
+            return false;
+        }
+#if GESTION_SIMD_X86
+        switch (nivelActivo())
+        {
+        case NivelSimd::Avx2:
+            extremosAvx2(datos, cantidad, minimo, maximo);
+            return true;
+        case NivelSimd::Sse41:
+            extremosSse(datos, cantidad, minimo, maximo);
+            return true;
+        default:
+            break;
+        }
+#endif
+        extremosEscalar(datos, cantidad, 0, datos[0], datos[0], minimo, maximo);
+        return true;
+    }
+
+    template <typename T>
+    static std::size_t contarDespachado(const T* datos, std::size_t cantidad, T umbral)
+    {
+#if GESTION_SIMD_X86
+        switch (nivelActivo())
+        {
+        case NivelSimd::Avx2:
+            return contarAvx2(datos, cantidad, umbral);
+        case NivelSimd::Sse41:
+            return contarSse(datos, cantidad, umbral);
+        default:
+            break;
+        }
+#endif
+        return contarEscalar(datos, cantidad, 0, umbral);
+    }
+
+    template <typename T>
+    static double varianzaDespachada(const T* datos, std::size_t cantidad)
+    {
+        if (cantidad == 0)
+        {
+            return 0.0;
+        }
+        double media = sumar(datos, cantidad) / static_cast<double>(cantidad);
+#if GESTION_SIMD_X86
+        switch (nivelActivo())
+        {
+        case NivelSimd::Avx2:
+            return desviacionesAvx2(datos, cantidad, media) / static_cast<double>(cantidad);
+        case NivelSimd::Sse41:
+            return desviacionesSse(datos, cantidad, media) / static_cast<double>(cantidad);
+        default:
+            break;
+        }
+#endif
+        return desviacionesEscalar(datos, cantidad, 0, media) / static_cast<double>(cantidad);
+    }
+
+    // ---- Versiones escalares; también terminan el resto que no llena un vector. ----
+
+    static double sumarEscalar(const float* datos, std::size_t cantidad)
+    {
+        double suma = 0.0;
+        for (std::size_t i = 0; i < cantidad; ++i)
+        {
+            suma += static_cast<double>(datos[i]);
+        }
+        return suma;
+    }
+
+    static std::int64_t sumarEscalar(const int* datos, std::size_t cantidad)
+    {
+        std::int64_t suma = 0;
+        for (std::size_t i = 0; i < cantidad; ++i)
+        {
+            suma += datos[i];
+        }
+        return suma;
+    }
+
+    template <typename T>
+    static void extremosEscalar(const T* datos, std::size_t cantidad, std::size_t desde, T menor, T mayor, T& minimo,
+                                T& maximo)
+    {
+        for (std::size_t i = desde; i < cantidad; ++i)
+        {
+            menor = (datos[i] < menor) ? datos[i] : menor;
+            mayor = (mayor < datos[i]) ? datos[i] : mayor;
+        }
+        minimo = menor;
+        maximo = mayor;
+    }
+
+    /// Combina los carriles de los vectores de mínimos y máximos.
+    template <typename T>
+    static void reducirCarriles(const T* menores, const T* mayores, std::size_t carriles, T& minimo, T& maximo)
+    {
+        minimo = menores[0];
+        maximo = mayores[0];
+        for (std::size_t i = 1; i < carriles; ++i)
+        {
+            minimo = (menores[i] < minimo) ? menores[i] : minimo;
+            maximo = (maximo < mayores[i]) ? mayores[i] : maximo;
+        }
+    }
+
+    template <typename T>
+    static std::size_t contarEscalar(const T* datos, std::size_t cantidad, std::size_t desde, T umbral)
+    {
+        std::size_t total = 0;
+        for (std::size_t i = desde; i < cantidad; ++i)
+        {
+            total += (datos[i] > umbral) ? 1 : 0;
+        }
+        return total;
+    }
+
+    template <typename T>
+    static double desviacionesEscalar(const T* datos, std::size_t cantidad, std::size_t desde, double media)
+    {
+        double total = 0.0;
+        for (std::size_t i = desde; i < cantidad; ++i)
+        {
+            double desviacion = static_cast<double>(datos[i]) - media;
+            total += desviacion * desviacion;
+        }
+        return total;
+    }
+
+#if GESTION_SIMD_X86
+    // ---- SSE4.1: 4 lecturas por iteración. ----
+
+    __attribute__((target("sse4.1"))) static double sumarSse(const float* datos, std::size_t cantidad)
+    {
+        __m128d a = _mm_setzero_pd();
+        __m128d b = _mm_setzero_pd();
+        std::size_t i = 0;
+        for (; i + 4 <= cantidad; i += 4)
+        {
+            __m128 v = _mm_loadu_ps(datos + i);
+            a = _mm_add_pd(a, _mm_cvtps_pd(v));
+            b = _mm_add_pd(b, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+        }
+        double parcial[2];
+        _mm_storeu_pd(parcial, _mm_add_pd(a, b));
+        return parcial[0] + parcial[1] + sumarEscalar(datos + i, cantidad - i);
+    }
+
+    __attribute__((target("sse4.1"))) static std::int64_t sumarSse(const int* datos, std::size_t cantidad)
+    {
+        __m128i a = _mm_setzero_si128();
+        __m128i b = _mm_setzero_si128();
+        std::size_t i = 0;
+        for (; i + 4 <= cantidad; i += 4)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(datos + i));
+            a = _mm_add_epi64(a, _mm_cvtepi32_epi64(v));
+            b = _mm_add_epi64(b, _mm_cvtepi32_epi64(_mm_srli_si128(v, 8)));
+        }
+        std::int64_t parcial[2];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(parcial), _mm_add_epi64(a, b));
+        return parcial[0] + parcial[1] + sumarEscalar(datos + i, cantidad - i);
+    }
+
+    __attribute__((target("sse4.1"))) static void extremosSse(const float* datos, std::size_t cantidad, float& minimo,
+                                                              float& maximo)
+    {
+        if (cantidad < 4)
+        {
+            extremosEscalar(datos, cantidad, 0, datos[0], datos[0], minimo, maximo);
+            return;
+        }
+        __m128 menor = _mm_loadu_ps(datos);
+        __m128 mayor = menor;
+        std::size_t i = 4;
+        for (; i + 4 <= cantidad; i += 4)
+        {
+            __m128 v = _mm_loadu_ps(datos + i);
+            menor = _mm_min_ps(menor, v);
+            mayor = _mm_max_ps(mayor, v);
+        }
+        float menores[4];
+        float mayores[4];
+        _mm_storeu_ps(menores, menor);
+        _mm_storeu_ps(mayores, mayor);
+        reducirCarriles(menores, mayores, 4, minimo, maximo);
+        extremosEscalar(datos, cantidad, i, minimo, maximo, minimo, maximo);
+    }
+
+    __attribute__((target("sse4.1"))) static void extremosSse(const int* datos, std::size_t cantidad, int& minimo,
+                                                              int& maximo)
+    {
+        if (cantidad < 4)
+        {
+            extremosEscalar(datos, cantidad, 0, datos[0], datos[0], minimo, maximo);
+            return;
+        }
+        __m128i menor = _mm_loadu_si128(reinterpret_cast<const __m128i*>(datos));
+        __m128i mayor = menor;
+        std::size_t i = 4;
+        for (; i + 4 <= cantidad; i += 4)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(datos + i));
+            menor = _mm_min_epi32(menor, v);
+            mayor = _mm_max_epi32(mayor, v);
+        }
+        int menores[4];
+        int mayores[4];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(menores), menor);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(mayores), mayor);
+        reducirCarriles(menores, mayores, 4, minimo, maximo);
+        extremosEscalar(datos, cantidad, i, minimo, maximo, minimo, maximo);
+    }
+
+    __attribute__((target("sse4.1,popcnt"))) static std::size_t contarSse(const float* datos, std::size_t cantidad,
+                                                                          float umbral)
+    {
+        __m128 limite = _mm_set1_ps(umbral);
+        std::size_t total = 0;
+        std::size_t i = 0;
+        for (; i + 4 <= cantidad; i += 4)
+        {
+            total += __builtin_popcount(_mm_movemask_ps(_mm_cmpgt_ps(_mm_loadu_ps(datos + i), limite)));
+        }
+        return total + contarEscalar(datos, cantidad, i, umbral);
+    }
+
+    __attribute__((target("sse4.1,popcnt"))) static std::size_t contarSse(const int* datos, std::size_t cantidad,
+                                                                          int umbral)
+    {
+        __m128i limite = _mm_set1_epi32(umbral);
+        std::size_t total = 0;
+        std::size_t i = 0;
+        for (; i + 4 <= cantidad; i += 4)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(datos + i));
+            total += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(v, limite))));
+        }
+        return total + contarEscalar(datos, cantidad, i, umbral);
+    }
+
+    __attribute__((target("sse4.1"))) static double desviacionesSse(const float* datos, std::size_t cantidad,
+                                                                    double media)
+    {
+        __m128d centro = _mm_set1_pd(media);
+        __m128d a = _mm_setzero_pd();
+        __m128d b = _mm_setzero_pd();
+        std::size_t i = 0;
+        for (; i + 4 <= cantidad; i += 4)
+        {
+            __m128 v = _mm_loadu_ps(datos + i);
+            __m128d bajo = _mm_sub_pd(_mm_cvtps_pd(v), centro);
+            __m128d alto = _mm_sub_pd(_mm_cvtps_pd(_mm_movehl_ps(v, v)), centro);
+            a = _mm_add_pd(a, _mm_mul_pd(bajo, bajo));
+            b = _mm_add_pd(b, _mm_mul_pd(alto, alto));
+        }
+        double parcial[2];
+        _mm_storeu_pd(parcial, _mm_add_pd(a, b));
+        return parcial[0] + parcial[1] + desviacionesEscalar(datos, cantidad, i, media);
+    }
+
+    __attribute__((target("sse4.1"))) static double desviacionesSse(const int* datos, std::size_t cantidad,
+                                                                    double media)
+    {
+        __m128d centro = _mm_set1_pd(media);
+        __m128d a = _mm_setzero_pd();
+        __m128d b = _mm_setzero_pd();
+        std::size_t i = 0;
+        for (; i + 4 <= cantidad; i += 4)
+        {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(datos + i));
+            __m128d bajo = _mm_sub_pd(_mm_cvtepi32_pd(v), centro);
+            __m128d alto = _mm_sub_pd(_mm_cvtepi32_pd(_mm_srli_si128(v, 8)), centro);
+            a = _mm_add_pd(a, _mm_mul_pd(bajo, bajo));
+            b = _mm_add_pd(b, _mm_mul_pd(alto, alto));
+        }
+        double parcial[2];
+        _mm_storeu_pd(parcial, _mm_add_pd(a, b));
+        return parcial[0] + parcial[1] + desviacionesEscalar(datos, cantidad, i, media);
+    }
+
+    // ---- AVX2: 8 lecturas por iteración. ----
+
+    __attribute__((target("avx2"))) static double sumarAvx2(const float* datos, std::size_t cantidad)
+    {
+        __m256d a = _mm256_setzero_pd();
+        __m256d b = _mm256_setzero_pd();
+        std::size_t i = 0;
+        for (; i + 8 <= cantidad; i += 8)
+        {
+            __m256 v = _mm256_loadu_ps(datos + i);
+            a = _mm256_add_pd(a, _mm256_cvtps_pd(_mm256_castps256_ps128(v)));
+            b = _mm256_add_pd(b, _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)));
+        }
+        double parcial[4];
+        _mm256_storeu_pd(parcial, _mm256_add_pd(a, b));
+        return (parcial[0] + parcial[1]) + (parcial[2] + parcial[3]) + sumarEscalar(datos + i, cantidad - i);
+    }
+
+    __attribute__((target("avx2"))) static std::int64_t sumarAvx2(const int* datos, std::size_t cantidad)
+    {
+        __m256i a = _mm256_setzero_si256();
+        __m256i b = _mm256_setzero_si256();
+        std::size_t i = 0;
+        for (; i + 8 <= cantidad; i += 8)
+        {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(datos + i));
+            a = _mm256_add_epi64(a, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+            b = _mm256_add_epi64(b, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+        }
+        std::int64_t parcial[4];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(parcial), _mm256_add_epi64(a, b));
+        return parcial[0] + parcial[1] + parcial[2] + parcial[3] + sumarEscalar(datos + i, cantidad - i);
+    }
+
+    __attribute__((target("avx2"))) static void extremosAvx2(const float* datos, std::size_t cantidad, float& minimo,
+                                                             float& maximo)
+    {
+        if (cantidad < 8)
+        {
+            extremosEscalar(datos, cantidad, 0, datos[0], datos[0], minimo, maximo);
+            return;
+        }
+        __m256 menor = _mm256_loadu_ps(datos);
+        __m256 mayor = menor;
+        std::size_t i = 8;
+        for (; i + 8 <= cantidad; i += 8)
+        {
+            __m256 v = _mm256_loadu_ps(datos + i);
+            menor = _mm256_min_ps(menor, v);
+            mayor = _mm256_max_ps(mayor, v);
+        }
+        float menores[8];
+        float mayores[8];
+        _mm256_storeu_ps(menores, menor);
+        _mm256_storeu_ps(mayores, mayor);
+        reducirCarriles(menores, mayores, 8, minimo, maximo);
+        extremosEscalar(datos, cantidad, i, minimo, maximo, minimo, maximo);
+    }
+
+    __attribute__((target("avx2"))) static void extremosAvx2(const int* datos, std::size_t cantidad, int& minimo,
+                                                             int& maximo)
+    {
+        if (cantidad < 8)
+        {
+            extremosEscalar(datos, cantidad, 0, datos[0], datos[0], minimo, maximo);
+            return;
+        }
+        __m256i menor = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(datos));
+        __m256i mayor = menor;
+        std::size_t i = 8;
+        for (; i + 8 <= cantidad; i += 8)
+        {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(datos + i));
+            menor = _mm256_min_epi32(menor, v);
+            mayor = _mm256_max_epi32(mayor, v);
+        }
+        int menores[8];
+        int mayores[8];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(menores), menor);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(mayores), mayor);
+        reducirCarriles(menores, mayores, 8, minimo, maximo);
+        extremosEscalar(datos, cantidad, i, minimo, maximo, minimo, maximo);
+    }
+
+    __attribute__((target("avx2,popcnt"))) static std::size_t contarAvx2(const float* datos, std::size_t cantidad,
+                                                                        float umbral)
+    {
+        __m256 limite = _mm256_set1_ps(umbral);
+        std::size_t total = 0;
+        std::size_t i = 0;
+        for (; i + 8 <= cantidad; i += 8)
+        {
+            __m256 mayores = _mm256_cmp_ps(_mm256_loadu_ps(datos + i), limite, _CMP_GT_OQ);
+            total += __builtin_popcount(_mm256_movemask_ps(mayores));
+        }
+        return total + contarEscalar(datos, cantidad, i, umbral);
+    }
+
+    __attribute__((target("avx2,popcnt"))) static std::size_t contarAvx2(const int* datos, std::size_t cantidad,
+                                                                        int umbral)
+    {
+        __m256i limite = _mm256_set1_epi32(umbral);
+        std::size_t total = 0;
+        std::size_t i = 0;
+        for (; i + 8 <= cantidad; i += 8)
+        {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(datos + i));
+            total += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(v, limite))));
+        }
+        return total + contarEscalar(datos, cantidad, i, umbral);
+    }
+
+    __attribute__((target("avx2"))) static double desviacionesAvx2(const float* datos, std::size_t cantidad,
+                                                                   double media)
+    {
+        __m256d centro = _mm256_set1_pd(media);
+        __m256d a = _mm256_setzero_pd();
+        __m256d b = _mm256_setzero_pd();
+        std::size_t i = 0;
+        for (; i + 8 <= cantidad; i += 8)
+        {
+            __m256 v = _mm256_loadu_ps(datos + i);
+            __m256d bajo = _mm256_sub_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(v)), centro);
+            __m256d alto = _mm256_sub_pd(_mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)), centro);
+            a = _mm256_add_pd(a, _mm256_mul_pd(bajo, bajo));
+            b = _mm256_add_pd(b, _mm256_mul_pd(alto, alto));
+        }
+        double parcial[4];
+        _mm256_storeu_pd(parcial, _mm256_add_pd(a, b));
+        return (parcial[0] + parcial[1]) + (parcial[2] + parcial[3]) + desviacionesEscalar(datos, cantidad, i, media);
+    }
+
+    __attribute__((target("avx2"))) static double desviacionesAvx2(const int* datos, std::size_t cantidad,
+                                                                   double media)
+    {
+        __m256d centro = _mm256_set1_pd(media);
+        __m256d a = _mm256_setzero_pd();
+        __m256d b = _mm256_setzero_pd();
+        std::size_t i = 0;
+        for (; i + 8 <= cantidad; i += 8)
+        {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(datos + i));
+            __m256d bajo = _mm256_sub_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(v)), centro);
+            __m256d alto = _mm256_sub_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(v, 1)), centro);
+            a = _mm256_add_pd(a, _mm256_mul_pd(bajo, bajo));
+            b = _mm256_add_pd(b, _mm256_mul_pd(alto, alto));
+        }
+        double parcial[4];
+        _mm256_storeu_pd(parcial, _mm256_add_pd(a, b));
+        return (parcial[0] + parcial[1]) + (parcial[2] + parcial[3]) + desviacionesEscalar(datos, cantidad, i, media);
+    }
+#endif
+};
+
+#endif
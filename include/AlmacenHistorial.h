@@ -0,0 +1,242 @@
+/**
+ * @file AlmacenHistorial.h
+ * @brief Directorio con el historial en disco de cada sensor y restauración perezosa de la lista al arrancar.
+ */
+#ifndef ALMACENHISTORIAL_H
+#define ALMACENHISTORIAL_H
+
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <sys/stat.h>
+#include "AuxiliarCli.h"
+#include "ColumnaPersistente.h"
+#include "ListaGeneral.h"
+#include "SensorPresion.h"
+#include "SensorTemperatura.h"
+
+/**
+ * @brief Administra la raíz del almacén: un subdirectorio con una ColumnaPersistente por sensor.
+ *
+ * El subdirectorio se nombra a partir del sensor, conservando letras,
+ * dígitos, '-' y '_' y escribiendo el resto como %XX; el nombre exacto y el
+ * tipo se leen del encabezado del primer segmento.
+ */
+class AlmacenHistorial
+{
+public:
+    AlmacenHistorial() : capacidadSegmento(ColumnaPersistente::CAPACIDAD_SEGMENTO)
+    {
+        raiz[0] = '\0';
+    }
+
+    /**
+     * @brief Usa (y crea si hace falta) el directorio raíz del almacén.
+     * @param capacidad Lecturas por segmento para las columnas que se creen.
+     */
+    bool abrir(const char* ruta, std::uint32_t capacidad = ColumnaPersistente::CAPACIDAD_SEGMENTO)
+    {
+        AuxiliarCli cli;
+        if (!ruta || ruta[0] == '\0' || std::strlen(ruta) >= sizeof(raiz) || capacidad == 0)
+        {
+            cli.imprimirLog(NivelLog::Error, "Ruta de almacén inválida.");
+            return false;
+        }
+        if (mkdir(ruta, 0755) != 0 && errno != EEXIST)
+        {
+            cli.imprimirLogFormato<NivelLog::Error>("No se pudo crear el almacén '%s': %s", ruta, std::strerror(errno));
+            return false;
+        }
+        std::strcpy(raiz, ruta);
+        capacidadSegmento = capacidad;
+        return true;
+    }
+
+    /// Indica si hay un directorio raíz en uso.
+    bool estaAbierto() const
+    {
+        return raiz[0] != '\0';
+    }
+
+    /// Ruta del directorio raíz.
+    const char* obtenerRuta() const
+    {
+        return raiz;
+    }
+
+    /**
+     * @brief Abre la columna del sensor y se la entrega; las lecturas previas quedan sin cargar.
+     * @return false si el almacén está cerrado o la columna no pudo abrirse.
+     */
+    bool adjuntar(SensorBase& sensor)
+    {
+        if (!estaAbierto() || sensor.obtenerNombre()[0] == '\0')
+        {
+            return false;
+        }
+
+        char ruta[PATH_MAX];
+        if (!rutaSensor(sensor.obtenerNombre(), ruta, sizeof(ruta)))
+        {
+            AuxiliarCli cli;
+            cli.imprimirLogFormato<NivelLog::Error>("La ruta del historial de %s excede PATH_MAX.",
+                                                    sensor.obtenerNombre());
+            return false;
+        }
+        ColumnaPersistente* columna = new ColumnaPersistente();
+        if (!columna->abrir(ruta, sensor.obtenerNombre(), sensor.tipoLectura(), capacidadSegmento))
+        {
+            delete columna;
+            return false;
+        }
+        sensor.adjuntarPersistencia(columna);
+        return true;
+    }
+
+    /**
+     * @brief Agrega a la lista un sensor por cada columna del almacén, sin leer sus lecturas.
+     * @return Sensores restaurados, o -1 si la raíz no pudo leerse.
+     *
+     * Las columnas se procesan en orden alfabético de su directorio para que
+     * la lista quede igual en cada arranque. Si un sensor ya está en la lista
+     * se le adjunta su columna en lugar de crear otro.
+     */
+    int restaurar(ListaGeneral& lista)
+    {
+        AuxiliarCli cli;
+        DIR* directorio = estaAbierto() ? opendir(raiz) : nullptr;
+        if (!directorio)
+        {
+            cli.imprimirLogFormato<NivelLog::Error>("No se pudo leer el almacén '%s'.", raiz);
+            return -1;
+        }
+
+        std::size_t cantidad = 0;
+        std::size_t capacidad = 16;
+        EntradaDirectorio* entradas = new EntradaDirectorio[capacidad];
+        while (struct dirent* entrada = readdir(directorio))
+        {
+            if (entrada->d_name[0] == '.' || std::strlen(entrada->d_name) >= sizeof(entradas->nombre))
+            {
+                continue;
+            }
+            if (cantidad == capacidad)
+            {
+                EntradaDirectorio* mayores = new EntradaDirectorio[capacidad * 2];
+                std::memcpy(mayores, entradas, capacidad * sizeof(EntradaDirectorio));
+                delete[] entradas;
+                entradas = mayores;
+                capacidad *= 2;
+            }
+            std::strcpy(entradas[cantidad++].nombre, entrada->d_name);
+        }
+        closedir(directorio);
+        std::qsort(entradas, cantidad, sizeof(EntradaDirectorio), [](const void* a, const void* b)
+        {
+            return std::strcmp(static_cast<const EntradaDirectorio*>(a)->nombre,
+                               static_cast<const EntradaDirectorio*>(b)->nombre);
+        });
+
+        int restaurados = 0;
+        for (std::size_t i = 0; i < cantidad; ++i)
+        {
+            char ruta[PATH_MAX];
+            int largo = std::snprintf(ruta, sizeof(ruta), "%s/%s", raiz, entradas[i].nombre);
+            if (largo < 0 || static_cast<std::size_t>(largo) >= sizeof(ruta))
+            {
+                cli.imprimirLogFormato<NivelLog::Advertencia>("Se omite '%s': la ruta excede PATH_MAX.",
+                                                              entradas[i].nombre);
+                continue;
+            }
+            char nombre[TAM_NOMBRE_SENSOR];
+            char tipo = 0;
+            if (!ColumnaPersistente::inspeccionar(ruta, nombre, sizeof(nombre), tipo))
+            {
+                continue;
+            }
+
+            SensorBase* sensor = lista.buscarPorNombre(nombre);
+            bool nuevo = !sensor;
+            if (nuevo)
+            {
+                sensor = (tipo == 'T') ? static_cast<SensorBase*>(new SensorTemperatura(nombre))
+                                       : static_cast<SensorBase*>(new SensorPresion(nombre));
+            }
+            else if (sensor->tienePersistencia())
+            {
+                continue;
+            }
+            else if (sensor->tipoLectura() != tipo)
+            {
+                cli.imprimirLogFormato<NivelLog::Advertencia>(
+                    "El sensor %s existe con otro tipo; su historial en disco no se adjuntó.", nombre);
+                continue;
+            }
+
+            if (!adjuntar(*sensor) || (nuevo && !lista.insertar(sensor)))
+            {
+                if (nuevo)
+                {
+                    delete sensor;
+                }
+                continue;
+            }
+            ++restaurados;
+        }
+        delete[] entradas;
+        return restaurados;
+    }
+
+private:
+    /// Longitud máxima de un nombre de sensor más el terminador.
+    static constexpr std::size_t TAM_NOMBRE_SENSOR = 50;
+
+    /// Nombre de un subdirectorio de la raíz.
+    struct EntradaDirectorio
+    {
+        char nombre[256];
+    };
+
+    char raiz[PATH_MAX];
+    std::uint32_t capacidadSegmento;
+
+    /**
+     * @brief Arma la ruta del subdirectorio de un sensor escapando los caracteres no seguros.
+     * @return false si la ruta completa no cabe en destino.
+     */
+    bool rutaSensor(const char* nombre, char* destino, std::size_t tam) const
+    {
+        int escritos = std::snprintf(destino, tam, "%s/", raiz);
+        if (escritos < 0 || static_cast<std::size_t>(escritos) >= tam)
+        {
+            return false;
+        }
+        std::size_t posicion = static_cast<std::size_t>(escritos);
+        for (const char* c = nombre; *c; ++c)
+        {
+            // Cada carácter ocupa hasta tres posiciones ("%XX") y debe quedar lugar para el terminador.
+            if (posicion + 3 >= tam)
+            {
+                return false;
+            }
+            unsigned char letra = static_cast<unsigned char>(*c);
+            bool seguro = (letra >= 'A' && letra <= 'Z') || (letra >= 'a' && letra <= 'z') ||
+                          (letra >= '0' && letra <= '9') || letra == '-' || letra == '_';
+            if (seguro)
+            {
+                destino[posicion++] = static_cast<char>(letra);
+            }
+            else
+            {
+                posicion += static_cast<std::size_t>(std::snprintf(destino + posicion, tam - posicion, "%%%02X", letra));
+            }
+        }
+        destino[posicion] = '\0';
+        return true;
+    }
+};
+
+#endif
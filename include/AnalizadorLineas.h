@@ -0,0 +1,111 @@
+/**
+ * @file AnalizadorLineas.h
+ * @brief Análisis sin copias de líneas ID,valor y conversión numérica estricta con std::from_chars.
+ */
+#ifndef ANALIZADORLINEAS_H
+#define ANALIZADORLINEAS_H
+
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+/**
+ * @brief Resultado de analizar una línea: vistas al identificador y al valor.
+ *
+ * Ambas vistas apuntan dentro del buffer original, por lo que solo son válidas
+ * mientras ese buffer no se modifique.
+ */
+struct LineaSerial
+{
+    /// Identificador del sensor, sin espacios alrededor.
+    std::string_view id;
+    /// Texto del valor, sin espacios alrededor.
+    std::string_view valor;
+};
+
+/// Reduce la vista quitando espacios y tabuladores en ambos extremos.
+inline std::string_view recortarVista(std::string_view texto)
+{
+    std::size_t inicio = 0;
+    std::size_t fin = texto.size();
+    while (inicio < fin && (texto[inicio] == ' ' || texto[inicio] == '\t'))
+    {
+        ++inicio;
+    }
+    while (fin > inicio && (texto[fin - 1] == ' ' || texto[fin - 1] == '\t'))
+    {
+        --fin;
+    }
+    return texto.substr(inicio, fin - inicio);
+}
+
+/**
+ * @brief Separa una línea ID,valor sin copiar ni modificar el buffer.
+ * @param linea Inicio de la línea (no necesita terminador).
+ * @param longitud Número de caracteres de la línea.
+ * @param resultado Recibe las vistas al identificador y al valor.
+ * @return false si falta la coma o alguno de los campos queda vacío.
+ */
+inline bool analizarLineaSerial(const char* linea, std::size_t longitud, LineaSerial& resultado)
+{
+    if (!linea)
+    {
+        return false;
+    }
+
+    const char* coma = static_cast<const char*>(std::memchr(linea, ',', longitud));
+    if (!coma)
+    {
+        return false;
+    }
+
+    std::size_t posicionComa = static_cast<std::size_t>(coma - linea);
+    resultado.id = recortarVista(std::string_view(linea, posicionComa));
+    resultado.valor = recortarVista(std::string_view(coma + 1, longitud - posicionComa - 1));
+    return !resultado.id.empty() && !resultado.valor.empty();
+}
+
+/**
+ * @brief Convierte el texto completo a un número sin depender del locale.
+ * @param texto Vista con el número (se admite un signo '+' inicial).
+ * @param valor Recibe el número convertido si la conversión es válida.
+ * @return false si el texto está vacío, tiene caracteres sobrantes, desborda
+ *         el tipo o (para flotantes) no representa un número finito.
+ */
+template <typename T>
+bool convertirValor(std::string_view texto, T& valor)
+{
+    if (!texto.empty() && texto[0] == '+')
+    {
+        texto.remove_prefix(1);
+    }
+    if (texto.empty())
+    {
+        return false;
+    }
+
+    T convertido{};
+    const char* fin = texto.data() + texto.size();
+    std::from_chars_result resultado = std::from_chars(texto.data(), fin, convertido);
+    if (resultado.ec != std::errc() || resultado.ptr != fin)
+    {
+        return false;
+    }
+
+    if constexpr (std::is_floating_point<T>::value)
+    {
+        if (!std::isfinite(convertido))
+        {
+            return false;
+        }
+    }
+
+    valor = convertido;
+    return true;
+}
+
+#endif
@@ -3,11 +3,13 @@
 
 #include <iostream>
 #include <limits>
+#include <cstdio>
 #include <cstring>
+#include "RegistroAsincrono.h"
 
 /**
  * @file AuxiliarCli.h
- * @brief Utilidades para interacción en consola y mensajes coloreados.
+ * @brief Utilidades para interacción en consola y mensajes coloreados por nivel.
  */
 /**
  * @brief Auxilia a la interfaz de consola con logs y lectura validada.
@@ -18,38 +20,65 @@ public:
     AuxiliarCli() = default;
 
     /**
-     * @brief Imprime un mensaje con color según la etiqueta proporcionada.
-     * @param tipo Texto que describe el tipo de log (STATUS, WARNING, SUCCESS, ERROR).
+     * @brief Registra un mensaje con el color de su nivel.
+     * @param nivel Severidad del mensaje.
      * @param msj Mensaje a desplegar.
+     *
+     * El mensaje se copia a la cola de RegistroAsincrono y lo escribe el hilo
+     * escritor; la llamada no toca la consola.
      */
-    void imprimirLog(const char* tipo, const char* msj)
+    void imprimirLog(NivelLog nivel, const char* msj)
     {
-        if (!tipo || !msj)
+        if (!msj)
         {
             return;
         }
 
-        int colorId = 37;
-        if (coincide(tipo, "RED") || coincide(tipo, "ERROR") || coincide(tipo, "error"))
+        RegistroAsincrono& registro = RegistroAsincrono::instancia();
+        if (registro.habilitado(nivel))
         {
-            colorId = 31;
+            registro.encolar(nivel, msj, std::strlen(msj));
         }
-        else if (coincide(tipo, "GREEN") || coincide(tipo, "SUCCESS") || coincide(tipo, "success"))
-        {
-            colorId = 32;
-        }
-        else if (coincide(tipo, "YELLOW") || coincide(tipo, "WARNING") || coincide(tipo, "warning"))
-        {
-            colorId = 33;
-        }
-        else if (coincide(tipo, "CYAN") || coincide(tipo, "STATUS") || coincide(tipo, "status"))
+    }
+
+    /**
+     * @brief Da formato con snprintf y registra el mensaje, pensado para rutas calientes.
+     * @tparam Nivel Severidad; si está por debajo de GESTION_LOG_NIVEL_MINIMO la llamada no genera código.
+     * @param formato Formato estilo printf.
+     * @param argumentos Valores del formato.
+     *
+     * El formato solo se evalúa si el nivel está habilitado en tiempo de ejecución.
+     */
+    template <NivelLog Nivel, typename... Argumentos>
+    void imprimirLogFormato(const char* formato, Argumentos... argumentos)
+    {
+        if constexpr (nivelCompilado(Nivel))
         {
-            colorId = 36;
+            RegistroAsincrono& registro = RegistroAsincrono::instancia();
+            if (!registro.habilitado(Nivel))
+            {
+                return;
+            }
+
+            char mensaje[RegistroAsincrono::TAM_MENSAJE];
+            int longitud = std::snprintf(mensaje, sizeof(mensaje), formato, argumentos...);
+            if (longitud < 0)
+            {
+                return;
+            }
+            std::size_t bytes = static_cast<std::size_t>(longitud);
+            registro.encolar(Nivel, mensaje, (bytes < sizeof(mensaje)) ? bytes : sizeof(mensaje) - 1);
         }
+    }
 
-        std::cout << "\033[" << colorId << "m";
-        std::cout << "[" << tipo << "] " << msj << std::endl;
-        std::cout << "\033[0m";
+    /**
+     * @brief Espera a que los logs pendientes lleguen a la consola.
+     *
+     * Se llama antes de escribir directamente en std::cout para conservar el orden.
+     */
+    static void sincronizar()
+    {
+        RegistroAsincrono::instancia().sincronizar();
     }
 
     /**
@@ -65,12 +94,14 @@ public:
             mensaje = "Entrada";
         }
 
+        sincronizar();
         std::cout << mensaje << ": ";
         while (!(std::cin >> valor))
         {
-            imprimirLog("WARNING", "Entrada no válida, por favor, intente de nuevo.");
+            imprimirLog(NivelLog::Advertencia, "Entrada no válida, por favor, intente de nuevo.");
             std::cin.clear();
             std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            sincronizar();
             std::cout << mensaje << ": ";
         }
         std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
@@ -86,7 +117,7 @@ public:
     {
         if (!destino || capacidad == 0)
         {
-            imprimirLog("WARNING", "Buffer inválido para lectura de cadena.");
+            imprimirLog(NivelLog::Advertencia, "Buffer inválido para lectura de cadena.");
             return;
         }
 
@@ -95,6 +126,7 @@ public:
             mensaje = "Entrada";
         }
 
+        sincronizar();
         std::cout << mensaje << ": ";
         std::cin.getline(destino, static_cast<std::streamsize>(capacidad));
 
@@ -104,17 +136,13 @@ public:
             {
                 std::cin.clear();
             }
-            imprimirLog("WARNING", "Entrada vacía, por favor, intente de nuevo.");
+            imprimirLog(NivelLog::Advertencia, "Entrada vacía, por favor, intente de nuevo.");
+            sincronizar();
             std::cout << mensaje << ": ";
             std::cin.getline(destino, static_cast<std::streamsize>(capacidad));
         }
     }
 
-private:
-    bool coincide(const char* texto, const char* referencia) const
-    {
-        return std::strcmp(texto, referencia) == 0;
-    }
 };
 
 #endif
@@ -0,0 +1,573 @@
+/**
+ * @file ColaIngesta.h
+ * @brief Cola acotada sin candados entre los hilos que leen puertos y el hilo que inserta en los sensores.
+ */
+#ifndef COLAINGESTA_H
+#define COLAINGESTA_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include "AnalizadorLineas.h"
+#include "AuxiliarCli.h"
+#include "HistogramaLatencia.h"
+#include "IndiceTemporal.h"
+#include "Instrumentacion.h"
+#include "LectorSerial.h"
+#include "ListaGeneral.h"
+#include "ProtocoloBinario.h"
+#include "SensorBase.h"
+
+/// Lectura ya analizada y enrutada, a la espera de insertarse en su sensor.
+struct LecturaEncolada
+{
+    SensorBase* sensor = nullptr;
+    double valor = 0.0;
+    /// Marca monotónica del momento en que se leyó; es la que conserva el historial.
+    std::int64_t marca = 0;
+};
+
+/// Qué hace un productor que encuentra la cola llena.
+enum class PoliticaCola
+{
+    /// Espera a que el consumidor libere espacio (contrapresión): no se pierde nada.
+    Esperar,
+    /// Descarta la lectura y la cuenta: el lector nunca se detiene.
+    Descartar
+};
+
+/**
+ * @brief Cola circular acotada de varios productores y un consumidor.
+ *
+ * Es el algoritmo de Vyukov de RegistroAsincrono: cada ranura lleva un número
+ * de secuencia y los productores reservan posiciones con compare-and-swap,
+ * así que publicar no toma ningún mutex. Como hay un solo consumidor, éste
+ * avanza su posición sin CAS y saca lotes enteros de una vez.
+ *
+ * El mutex y la variable de condición solo sirven para dormir al consumidor
+ * cuando no hay nada que hacer; un productor los toca únicamente si lo
+ * encuentra dormido.
+ */
+class ColaIngesta
+{
+public:
+    /// Capacidad predeterminada en lecturas (potencia de dos).
+    static constexpr std::size_t CAPACIDAD_PREDETERMINADA = 16384;
+
+    /**
+     * @param capacidadSolicitada Lecturas que caben; se redondea a la siguiente potencia de dos.
+     * @param politicaLlena Comportamiento de los productores cuando no hay espacio.
+     */
+    explicit ColaIngesta(std::size_t capacidadSolicitada = CAPACIDAD_PREDETERMINADA,
+                         PoliticaCola politicaLlena = PoliticaCola::Esperar)
+        : capacidad(redondearPotenciaDos(capacidadSolicitada)), ranuras(new Ranura[capacidad]),
+          politica(politicaLlena), posicionProductor(0), posicionConsumidor(0), publicadas(0), descartadas(0),
+          esperas(0), consumidorDormido(false), cerrada(false)
+    {
+        for (std::size_t i = 0; i < capacidad; ++i)
+        {
+            ranuras[i].secuencia.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ColaIngesta(const ColaIngesta&) = delete;
+    ColaIngesta& operator=(const ColaIngesta&) = delete;
+
+    ~ColaIngesta()
+    {
+        delete[] ranuras;
+    }
+
+    /**
+     * @brief Publica una lectura; la puede llamar cualquier hilo.
+     * @return false si la cola estaba llena y la política es Descartar.
+     */
+    bool publicar(SensorBase* sensor, double valor, std::int64_t marca)
+    {
+        std::uint64_t posicion = posicionProductor.load(std::memory_order_relaxed);
+        bool esperando = false;
+        Ranura* ranura = nullptr;
+        for (;;)
+        {
+            ranura = &ranuras[posicion & (capacidad - 1)];
+            std::uint64_t secuencia = ranura->secuencia.load(std::memory_order_acquire);
+            if (secuencia == posicion)
+            {
+                if (posicionProductor.compare_exchange_weak(posicion, posicion + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (secuencia < posicion)
+            {
+                // Llena: la ranura aún guarda la lectura de la vuelta anterior.
+                if (politica == PoliticaCola::Descartar)
+                {
+                    descartadas.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                if (!esperando)
+                {
+                    esperas.fetch_add(1, std::memory_order_relaxed);
+                    esperando = true;
+                }
+                despertarConsumidor();
+                std::this_thread::yield();
+                posicion = posicionProductor.load(std::memory_order_relaxed);
+            }
+            else
+            {
+                posicion = posicionProductor.load(std::memory_order_relaxed);
+            }
+        }
+
+        ranura->lectura.sensor = sensor;
+        ranura->lectura.valor = valor;
+        ranura->lectura.marca = marca;
+        ranura->secuencia.store(posicion + 1, std::memory_order_release);
+
+        publicadas.fetch_add(1, std::memory_order_seq_cst);
+        if (consumidorDormido.load(std::memory_order_seq_cst))
+        {
+            despertarConsumidor();
+        }
+        return true;
+    }
+
+    /**
+     * @brief Saca hasta maximo lecturas publicadas, en orden; solo desde el hilo consumidor.
+     * @return Lecturas copiadas en destino.
+     */
+    std::size_t extraerLote(LecturaEncolada* destino, std::size_t maximo)
+    {
+        std::size_t extraidas = 0;
+        while (extraidas < maximo)
+        {
+            Ranura& ranura = ranuras[posicionConsumidor & (capacidad - 1)];
+            if (ranura.secuencia.load(std::memory_order_acquire) != posicionConsumidor + 1)
+            {
+                break;
+            }
+            destino[extraidas++] = ranura.lectura;
+            ranura.secuencia.store(posicionConsumidor + capacidad, std::memory_order_release);
+            ++posicionConsumidor;
+        }
+        return extraidas;
+    }
+
+    /**
+     * @brief Duerme al consumidor hasta que haya publicaciones, se cierre la cola o pase el plazo.
+     * @return true si hay lecturas pendientes de extraer.
+     */
+    bool esperarPublicaciones(int milisegundos)
+    {
+        std::unique_lock<std::mutex> candado(mutexConsumidor);
+        consumidorDormido.store(true, std::memory_order_seq_cst);
+        if (!cerrada.load(std::memory_order_acquire) && !hayPublicadas())
+        {
+            hayTrabajo.wait_for(candado, std::chrono::milliseconds(milisegundos));
+        }
+        consumidorDormido.store(false, std::memory_order_relaxed);
+        return hayPublicadas();
+    }
+
+    /**
+     * @brief Indica que ya no habrá publicaciones y despierta al consumidor.
+     *
+     * Los productores deben haber terminado antes de llamarla.
+     */
+    void cerrar()
+    {
+        cerrada.store(true, std::memory_order_release);
+        despertarConsumidor();
+    }
+
+    /// Indica si se llamó a cerrar().
+    bool estaCerrada() const
+    {
+        return cerrada.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Indica si hay lecturas publicadas que el consumidor aún no extrae (solo desde el consumidor).
+     *
+     * Junto con la marca consumidorDormido (ambas seq_cst) evita que el
+     * consumidor se duerma justo después de que un productor publicó sin avisarle.
+     */
+    bool hayPublicadas() const
+    {
+        return publicadas.load(std::memory_order_seq_cst) != posicionConsumidor;
+    }
+
+    /// Lecturas que entraron a la cola.
+    std::uint64_t obtenerPublicadas() const
+    {
+        return publicadas.load(std::memory_order_relaxed);
+    }
+
+    /// Lecturas descartadas por encontrar la cola llena (política Descartar).
+    std::uint64_t obtenerDescartadas() const
+    {
+        return descartadas.load(std::memory_order_relaxed);
+    }
+
+    /// Publicaciones que tuvieron que esperar espacio (política Esperar).
+    std::uint64_t obtenerEsperas() const
+    {
+        return esperas.load(std::memory_order_relaxed);
+    }
+
+    /// Capacidad efectiva en lecturas.
+    std::size_t obtenerCapacidad() const
+    {
+        return capacidad;
+    }
+
+    /// Política aplicada cuando la cola se llena.
+    PoliticaCola obtenerPolitica() const
+    {
+        return politica;
+    }
+
+private:
+    /// Posición de la cola: secuencia de Vyukov más la lectura.
+    struct Ranura
+    {
+        std::atomic<std::uint64_t> secuencia;
+        LecturaEncolada lectura;
+    };
+
+    const std::size_t capacidad;
+    Ranura* ranuras;
+    const PoliticaCola politica;
+    alignas(64) std::atomic<std::uint64_t> posicionProductor;
+    alignas(64) std::uint64_t posicionConsumidor;
+    alignas(64) std::atomic<std::uint64_t> publicadas;
+    std::atomic<std::uint64_t> descartadas;
+    std::atomic<std::uint64_t> esperas;
+    std::atomic<bool> consumidorDormido;
+    std::atomic<bool> cerrada;
+
+    std::mutex mutexConsumidor;
+    std::condition_variable hayTrabajo;
+
+    void despertarConsumidor()
+    {
+        std::lock_guard<std::mutex> guardia(mutexConsumidor);
+        hayTrabajo.notify_one();
+    }
+
+    static std::size_t redondearPotenciaDos(std::size_t valor)
+    {
+        std::size_t potencia = 64;
+        while (potencia < valor)
+        {
+            potencia *= 2;
+        }
+        return potencia;
+    }
+};
+
+/**
+ * @brief Hilo único que vacía una ColaIngesta por lotes y registra cada lectura en su sensor.
+ *
+ * Las lecturas seguidas de un mismo sensor dentro de un lote se registran
+ * juntas con SensorBase::registrarLoteNumericoEn(): una llamada virtual, una
+ * reserva de nodos y una línea de log por tramo en vez de por lectura.
+ *
+ * Es el único que escribe en los historiales mientras dura la ingesta; si
+ * otro hilo procesa los sensores al mismo tiempo, éstos deben estar en modo de
+ * ingesta concurrente (ListaGeneral::establecerIngestaConcurrente()).
+ */
+class ConsumidorIngesta
+{
+public:
+    /// Lecturas que se sacan de la cola de una vez.
+    static constexpr std::size_t TAM_LOTE = 256;
+
+    /**
+     * @brief Arranca el hilo consumidor sobre la cola.
+     *
+     * Si el hilo no puede crearse, enEjecucion() devuelve false y detener()
+     * vacía la cola en el llamador; mientras tanto nadie la vacía, así que
+     * los lectores no deben publicar en ella (ver colaParaLectores()).
+     */
+    explicit ConsumidorIngesta(ColaIngesta& colaOrigen)
+        : cola(colaOrigen), lote(new LecturaEncolada[TAM_LOTE]), valores(new double[TAM_LOTE]),
+          marcas(new std::int64_t[TAM_LOTE]), registradas(0), rechazadas(0), lotes(0)
+    {
+        try
+        {
+            hilo = std::thread(&ConsumidorIngesta::ejecutar, this);
+        }
+        catch (const std::system_error&)
+        {
+            // Sin hilo, las lecturas que alcanzaran a entrar se insertan al llamar a detener().
+        }
+    }
+
+    ConsumidorIngesta(const ConsumidorIngesta&) = delete;
+    ConsumidorIngesta& operator=(const ConsumidorIngesta&) = delete;
+
+    ~ConsumidorIngesta()
+    {
+        detener();
+        delete[] lote;
+        delete[] valores;
+        delete[] marcas;
+    }
+
+    /**
+     * @brief Cierra la cola, inserta lo que quede en ella y espera al hilo.
+     *
+     * Los productores deben haber terminado antes de llamarla.
+     */
+    void detener()
+    {
+        cola.cerrar();
+        if (hilo.joinable())
+        {
+            hilo.join();
+        }
+        else
+        {
+            while (vaciarLote() > 0)
+            {
+            }
+        }
+    }
+
+    /// Indica si el hilo consumidor está vaciando la cola.
+    bool enEjecucion() const
+    {
+        return hilo.joinable();
+    }
+
+    /// Lecturas que sus sensores aceptaron.
+    std::uint64_t obtenerRegistradas() const
+    {
+        return registradas.load(std::memory_order_relaxed);
+    }
+
+    /// Lecturas que sus sensores rechazaron (por ejemplo, un valor no entero para presión).
+    std::uint64_t obtenerRechazadas() const
+    {
+        return rechazadas.load(std::memory_order_relaxed);
+    }
+
+    /// Lotes extraídos; con las lecturas da el tamaño medio de lote.
+    std::uint64_t obtenerLotes() const
+    {
+        return lotes.load(std::memory_order_relaxed);
+    }
+
+    /// Tiempo que pasó cada lectura en la cola, desde su marca hasta su inserción. Válido tras detener().
+    const HistogramaLatencia& obtenerEsperaEnCola() const
+    {
+        return esperaEnCola;
+    }
+
+private:
+    ColaIngesta& cola;
+    LecturaEncolada* lote;
+    /// Valores y marcas del tramo de un mismo sensor que se está insertando.
+    double* valores;
+    std::int64_t* marcas;
+    std::thread hilo;
+    std::atomic<std::uint64_t> registradas;
+    std::atomic<std::uint64_t> rechazadas;
+    std::atomic<std::uint64_t> lotes;
+    HistogramaLatencia esperaEnCola;
+
+    /// Ciclo del hilo: vacía la cola por lotes y duerme cuando está vacía.
+    void ejecutar()
+    {
+        for (;;)
+        {
+            if (vaciarLote() > 0)
+            {
+                continue;
+            }
+            if (cola.estaCerrada() && !cola.hayPublicadas())
+            {
+                break;
+            }
+            cola.esperarPublicaciones(50);
+        }
+    }
+
+    /// Inserta un lote; devuelve cuántas lecturas sacó de la cola.
+    std::size_t vaciarLote()
+    {
+        std::size_t cantidad = cola.extraerLote(lote, TAM_LOTE);
+        if (cantidad == 0)
+        {
+            return 0;
+        }
+
+        // Una lectura del reloj por lote basta para la espera en cola de todas sus lecturas.
+        std::int64_t extraccion = marcaMonotonica();
+        std::uint64_t aceptadas = 0;
+        std::size_t inicio = 0;
+        while (inicio < cantidad)
+        {
+            // Las lecturas seguidas de un mismo sensor entran con una sola llamada a registrarLoteNumericoEn().
+            SensorBase* sensor = lote[inicio].sensor;
+            std::size_t enTramo = 0;
+            while (inicio + enTramo < cantidad && lote[inicio + enTramo].sensor == sensor)
+            {
+                const LecturaEncolada& lectura = lote[inicio + enTramo];
+                std::int64_t espera = extraccion - lectura.marca;
+                esperaEnCola.registrar((espera > 0) ? static_cast<std::uint64_t>(espera) : 0);
+                valores[enTramo] = lectura.valor;
+                marcas[enTramo] = lectura.marca;
+                ++enTramo;
+            }
+
+            CronometroEtapas etapas(MUESTREO_INGESTA);
+            std::size_t registradasTramo = sensor->registrarLoteNumericoEn(valores, marcas, enTramo);
+            etapas.marcar(Etapa::Insercion);
+            etapas.contar(Contador::LecturasRegistradas, registradasTramo);
+            etapas.contar(Contador::LecturasRechazadas, enTramo - registradasTramo);
+            aceptadas += registradasTramo;
+            inicio += enTramo;
+        }
+        registradas.store(registradas.load(std::memory_order_relaxed) + aceptadas, std::memory_order_relaxed);
+        rechazadas.store(rechazadas.load(std::memory_order_relaxed) + (cantidad - aceptadas), std::memory_order_relaxed);
+        lotes.store(lotes.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return cantidad;
+    }
+};
+
+/**
+ * @brief Analiza y enruta una línea ID,valor como enrutarLineaSerial(), pero la publica en la cola en vez de insertarla.
+ * @return true si la lectura entró a la cola.
+ *
+ * El valor se convierte a double aquí; el sensor aplica su propia validación
+ * (entero para presión, finito para temperatura) al insertarla el consumidor.
+ */
+inline bool encolarLineaSerial(ListaGeneral& lista, const char* linea, std::size_t longitud, ColaIngesta& cola,
+                               AuxiliarCli& cli)
+{
+    CronometroEtapas etapas(MUESTREO_INGESTA);
+    etapas.contar(Contador::Lineas);
+    LineaSerial campos;
+    double valor = 0.0;
+    bool valida = analizarLineaSerial(linea, longitud, campos);
+    bool numerico = valida && convertirValor(campos.valor, valor);
+    etapas.marcar(Etapa::Analisis);
+    if (!valida)
+    {
+        etapas.contar(Contador::LineasMalformadas);
+        cli.imprimirLog(NivelLog::Advertencia, "Lectura serial ignorada: formato incorrecto.");
+        return false;
+    }
+
+    SensorBase* sensor = lista.buscarPorNombre(campos.id.data(), campos.id.size());
+    etapas.marcar(Etapa::Enrutamiento);
+    if (!sensor)
+    {
+        etapas.contar(Contador::SensoresDesconocidos);
+        cli.imprimirLogFormato<NivelLog::Advertencia>(
+            "Sensor '%.*s' no se encuentra en la lista.",
+            static_cast<int>(campos.id.size() < TAM_ID ? campos.id.size() : TAM_ID), campos.id.data());
+        return false;
+    }
+    if (!numerico)
+    {
+        etapas.contar(Contador::LecturasRechazadas);
+        cli.imprimirLogFormato<NivelLog::Advertencia>(
+            "Valor '%.*s' inválido para el sensor %s.",
+            static_cast<int>(campos.valor.size() > 40 ? 40 : campos.valor.size()), campos.valor.data(),
+            sensor->obtenerNombre());
+        return false;
+    }
+
+    return cola.publicar(sensor, valor, marcaMonotonica());
+}
+
+/**
+ * @brief Publica en la cola las lecturas de una trama binaria, con la misma marca para todas.
+ * @return Lecturas que entraron a la cola.
+ */
+inline int encolarTramaBinaria(ListaGeneral& lista, const TramaBinaria& trama, ColaIngesta& cola, AuxiliarCli& cli)
+{
+    std::int64_t marca = marcaMonotonica();
+    CronometroEtapas etapas(MUESTREO_INGESTA);
+    etapas.contar(Contador::Tramas);
+    int publicadas = 0;
+    SensorBase* sensor = nullptr;
+    for (std::size_t i = 0; i < trama.cantidad; ++i)
+    {
+        const LecturaBinaria& lectura = trama.lecturas[i];
+        // Las lecturas seguidas del mismo sensor reutilizan la búsqueda; el consumidor las registra como un lote.
+        const LecturaBinaria* anterior = (i > 0) ? &trama.lecturas[i - 1] : nullptr;
+        if (!anterior || anterior->tipo != lectura.tipo || anterior->id != lectura.id)
+        {
+            sensor = lista.buscarPorId(lectura.tipo, lectura.id);
+        }
+        etapas.marcar(Etapa::Enrutamiento);
+        if (!sensor)
+        {
+            etapas.contar(Contador::SensoresDesconocidos);
+            cli.imprimirLogFormato<NivelLog::Advertencia>("Sensor '%c-%03u' no se encuentra en la lista.", lectura.tipo,
+                                                          static_cast<unsigned>(lectura.id));
+            etapas.reanudar();
+            continue;
+        }
+        if (cola.publicar(sensor, lectura.valor, marca))
+        {
+            ++publicadas;
+        }
+    }
+    return publicadas;
+}
+
+/**
+ * @brief Cola en la que deben publicar los lectores, o nullptr si el consumidor no pudo arrancar su hilo.
+ *
+ * Sin hilo nadie vaciaría la cola durante la escucha y, con
+ * PoliticaCola::Esperar, los lectores esperarían espacio para siempre; en ese
+ * caso se avisa y los lectores insertan directamente en los sensores.
+ */
+inline ColaIngesta* colaParaLectores(ColaIngesta& cola, const ConsumidorIngesta& consumidor, AuxiliarCli& cli)
+{
+    if (consumidor.enEjecucion())
+    {
+        return &cola;
+    }
+    cli.imprimirLog(NivelLog::Error,
+                    "No se pudo crear el hilo consumidor; las lecturas se insertarán directamente en los sensores.");
+    return nullptr;
+}
+
+/**
+ * @brief Resume por log el paso de las lecturas por la cola tras detener el consumidor.
+ */
+inline void informarCola(AuxiliarCli& cli, const ColaIngesta& cola, const ConsumidorIngesta& consumidor)
+{
+    std::uint64_t lotes = consumidor.obtenerLotes();
+    double medio = (lotes > 0) ? static_cast<double>(cola.obtenerPublicadas()) / static_cast<double>(lotes) : 0.0;
+    cli.imprimirLogFormato<NivelLog::Estado>(
+        "Cola de ingesta: %llu publicadas, %llu descartadas por cola llena, %llu esperas por espacio; lote medio %.1f.",
+        static_cast<unsigned long long>(cola.obtenerPublicadas()),
+        static_cast<unsigned long long>(cola.obtenerDescartadas()),
+        static_cast<unsigned long long>(cola.obtenerEsperas()), medio);
+
+    const HistogramaLatencia& espera = consumidor.obtenerEsperaEnCola();
+    if (espera.obtenerCantidad() > 0)
+    {
+        cli.imprimirLogFormato<NivelLog::Estado>("Espera en cola (us): p50 %.1f, p99 %.1f, máx %.1f.",
+                                                 static_cast<double>(espera.percentil(50.0)) / 1e3,
+                                                 static_cast<double>(espera.percentil(99.0)) / 1e3,
+                                                 static_cast<double>(espera.obtenerMaximo()) / 1e3);
+    }
+}
+
+#endif
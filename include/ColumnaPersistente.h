@@ -0,0 +1,609 @@
+/**
+ * @file ColumnaPersistente.h
+ * @brief Historial en disco de un sensor: segmentos mapeados en memoria con una columna de marcas de tiempo y otra de valores.
+ */
+#ifndef COLUMNAPERSISTENTE_H
+#define COLUMNAPERSISTENTE_H
+
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "AuxiliarCli.h"
+
+/// Nanosegundos desde la época Unix; es la marca que se guarda junto a cada lectura.
+inline std::int64_t marcaTiempoActual()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+/**
+ * @brief Encabezado de 128 bytes al inicio de cada segmento.
+ *
+ * Tras él vienen las columnas: capacidad marcas int64 y luego capacidad
+ * valores de 4 bytes (float o int32 según el tipo), ambas en el orden nativo.
+ */
+struct EncabezadoSegmento
+{
+    char magia[8];
+    std::uint32_t version;
+    std::uint32_t capacidad;
+    /// Lecturas que ya llegaron al disco; solo lo actualiza sincronizar().
+    std::uint64_t confirmadas;
+    std::uint32_t numero;
+    char tipo;
+    char reservado[3];
+    char nombre[56];
+    char relleno[40];
+};
+
+static_assert(sizeof(EncabezadoSegmento) == 128, "El encabezado de segmento debe medir 128 bytes");
+
+/**
+ * @brief Columna de solo anexado con las lecturas de un sensor, repartida en segmentos mapeados.
+ *
+ * Cada segmento es un archivo "NNNNNNNN.seg" de tamaño fijo dentro del
+ * directorio del sensor, creado disperso con ftruncate() y mapeado con
+ * MAP_SHARED: anexar es escribir dos palabras en memoria y el núcleo se
+ * encarga de llevarlas al archivo. Abrir una columna existente solo mapea
+ * los segmentos; los valores no se leen hasta que alguien los recorre.
+ *
+ * Recuperación: el valor se escribe antes que su marca y una marca en cero
+ * significa "ranura libre", así que al abrir se cuentan las marcas no nulas
+ * que siguen a las confirmadas en el encabezado. Si el proceso muere, nada
+ * de lo anexado se pierde (las páginas mapeadas ya son del caché del
+ * núcleo); ante un corte de energía solo está garantizado lo anterior a la
+ * última llamada a sincronizar().
+ */
+class ColumnaPersistente
+{
+public:
+    /// Lecturas por segmento cuando no se indica otra cosa (12 MB por archivo).
+    static constexpr std::uint32_t CAPACIDAD_SEGMENTO = 1u << 20;
+    /// Máximo de segmentos por sensor.
+    static constexpr std::size_t MAX_SEGMENTOS = 1024;
+    /// Versión del formato en disco.
+    static constexpr std::uint32_t VERSION_FORMATO = 1;
+
+    ColumnaPersistente()
+        : capacidad(0), cantidadSegmentos(0), total(0), recuperadas(0), tipo(0), avisoLleno(false)
+    {
+        directorio[0] = '\0';
+        nombre[0] = '\0';
+    }
+
+    ColumnaPersistente(const ColumnaPersistente&) = delete;
+    ColumnaPersistente& operator=(const ColumnaPersistente&) = delete;
+
+    ~ColumnaPersistente()
+    {
+        cerrar();
+    }
+
+    /**
+     * @brief Abre (o crea) la columna guardada en un directorio.
+     * @param rutaDirectorio Directorio exclusivo del sensor; se crea si no existe.
+     * @param nombreSensor Nombre que se registra en los segmentos nuevos.
+     * @param tipoLectura 'T' (float) o 'P' (int32); debe coincidir con el de los segmentos existentes.
+     * @param capacidadSegmento Lecturas por segmento para una columna nueva; una existente conserva la suya.
+     * @return false si el directorio no es utilizable o algún segmento está dañado o es de otro tipo.
+     */
+    bool abrir(const char* rutaDirectorio, const char* nombreSensor, char tipoLectura,
+               std::uint32_t capacidadSegmento = CAPACIDAD_SEGMENTO)
+    {
+        AuxiliarCli cli;
+        cerrar();
+        // El directorio debe dejar lugar para "/NNNNNNNN.seg" dentro de PATH_MAX.
+        if (!rutaDirectorio || !nombreSensor || capacidadSegmento == 0 ||
+            std::strlen(rutaDirectorio) + LARGO_NOMBRE_SEGMENTO >= sizeof(directorio))
+        {
+            cli.imprimirLog(NivelLog::Error, "Parámetros inválidos al abrir un historial persistente.");
+            return false;
+        }
+        if (mkdir(rutaDirectorio, 0755) != 0 && errno != EEXIST)
+        {
+            cli.imprimirLogFormato<NivelLog::Error>("No se pudo crear el directorio '%s': %s", rutaDirectorio,
+                                                    std::strerror(errno));
+            return false;
+        }
+
+        std::strcpy(directorio, rutaDirectorio);
+        copiarAcotado(nombre, sizeof(nombre), nombreSensor);
+        tipo = tipoLectura;
+        capacidad = capacidadSegmento;
+
+        char ruta[PATH_MAX];
+        for (std::uint32_t numero = 0; numero < MAX_SEGMENTOS; ++numero)
+        {
+            if (!rutaSegmento(numero, ruta, sizeof(ruta)) || access(ruta, F_OK) != 0)
+            {
+                break;
+            }
+            if (!abrirSegmento(ruta, numero))
+            {
+                cerrar();
+                return false;
+            }
+        }
+
+        if (recuperadas > 0)
+        {
+            cli.imprimirLogFormato<NivelLog::Advertencia>(
+                "Historial de %s: %zu lecturas recuperadas tras un cierre sin sincronizar.", nombre, recuperadas);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Lee nombre y tipo del primer segmento de un directorio sin mapearlo.
+     * @return false si el directorio no contiene una columna válida.
+     */
+    static bool inspeccionar(const char* rutaDirectorio, char* nombreSensor, std::size_t tamNombre, char& tipoLectura)
+    {
+        char ruta[PATH_MAX];
+        int largo = std::snprintf(ruta, sizeof(ruta), "%s/%08u.seg", rutaDirectorio, 0u);
+        if (largo < 0 || static_cast<std::size_t>(largo) >= sizeof(ruta))
+        {
+            return false;
+        }
+        int fd = open(ruta, O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            return false;
+        }
+        EncabezadoSegmento encabezado;
+        bool valido = pread(fd, &encabezado, sizeof(encabezado), 0) == static_cast<ssize_t>(sizeof(encabezado)) &&
+                      encabezadoValido(encabezado);
+        close(fd);
+        if (!valido || tamNombre == 0)
+        {
+            return false;
+        }
+        encabezado.nombre[sizeof(encabezado.nombre) - 1] = '\0';
+        copiarAcotado(nombreSensor, tamNombre, encabezado.nombre);
+        tipoLectura = encabezado.tipo;
+        return true;
+    }
+
+    /// Indica si la columna tiene un directorio abierto.
+    bool estaAbierta() const
+    {
+        return directorio[0] != '\0';
+    }
+
+    /// Lecturas guardadas.
+    std::size_t contar() const
+    {
+        return total;
+    }
+
+    /// Lecturas que se recuperaron al abrir más allá de las confirmadas.
+    std::size_t obtenerRecuperadas() const
+    {
+        return recuperadas;
+    }
+
+    /// Tipo de lectura de la columna ('T' o 'P').
+    char obtenerTipo() const
+    {
+        return tipo;
+    }
+
+    /// Nombre del sensor dueño de la columna.
+    const char* obtenerNombre() const
+    {
+        return nombre;
+    }
+
+    /**
+     * @brief Anexa una lectura.
+     * @param valor float o int, según el tipo de la columna.
+     * @param marca Nanosegundos desde la época; un valor no positivo se guarda como 1 para no confundirlo con una ranura libre.
+     * @return false si no hay columna abierta o se agotaron los segmentos.
+     */
+    template <typename T>
+    bool agregar(T valor, std::int64_t marca)
+    {
+        static_assert(sizeof(T) == sizeof(std::uint32_t), "Las columnas guardan valores de 4 bytes");
+        if (cantidadSegmentos == 0 || segmentos[cantidadSegmentos - 1].cantidad == capacidad)
+        {
+            if (!agregarSegmento())
+            {
+                return false;
+            }
+        }
+
+        Segmento& segmento = segmentos[cantidadSegmentos - 1];
+        std::memcpy(valores(segmento) + segmento.cantidad, &valor, sizeof(valor));
+        // La marca confirma la ranura: debe quedar escrita después del valor.
+        __atomic_store_n(marcas(segmento) + segmento.cantidad, (marca > 0) ? marca : 1, __ATOMIC_RELEASE);
+        ++segmento.cantidad;
+        ++total;
+        return true;
+    }
+
+    /// Variante de agregar() para varios hilos de ingesta que anexan al mismo sensor.
+    template <typename T>
+    bool agregarConcurrente(T valor, std::int64_t marca)
+    {
+        std::lock_guard<std::mutex> guardia(mutexAnexo);
+        return agregar(valor, marca);
+    }
+
+    /**
+     * @brief Anexa varias lecturas copiando los valores por tramos contiguos de cada segmento.
+     * @param marcasLote Nanosegundos desde la época de cada valor, con la misma regla que agregar().
+     * @return Lecturas anexadas; menos que cantidadLote solo si se agotaron los segmentos.
+     */
+    template <typename T>
+    std::size_t agregarLote(const T* valoresLote, const std::int64_t* marcasLote, std::size_t cantidadLote)
+    {
+        static_assert(sizeof(T) == sizeof(std::uint32_t), "Las columnas guardan valores de 4 bytes");
+        std::size_t agregadas = 0;
+        while (agregadas < cantidadLote)
+        {
+            if (cantidadSegmentos == 0 || segmentos[cantidadSegmentos - 1].cantidad == capacidad)
+            {
+                if (!agregarSegmento())
+                {
+                    break;
+                }
+            }
+
+            Segmento& segmento = segmentos[cantidadSegmentos - 1];
+            std::size_t tramo = capacidad - segmento.cantidad;
+            if (tramo > cantidadLote - agregadas)
+            {
+                tramo = cantidadLote - agregadas;
+            }
+            std::memcpy(valores(segmento) + segmento.cantidad, valoresLote + agregadas, tramo * sizeof(T));
+            // Igual que en agregar(), cada marca se publica después de su valor.
+            std::int64_t* destino = marcas(segmento) + segmento.cantidad;
+            for (std::size_t i = 0; i < tramo; ++i)
+            {
+                std::int64_t marca = marcasLote[agregadas + i];
+                __atomic_store_n(destino + i, (marca > 0) ? marca : 1, __ATOMIC_RELEASE);
+            }
+            segmento.cantidad += static_cast<std::uint32_t>(tramo);
+            total += tramo;
+            agregadas += tramo;
+        }
+        return agregadas;
+    }
+
+    /// Variante de agregarLote() que toma el candado de anexo una vez por lote.
+    template <typename T>
+    std::size_t agregarLoteConcurrente(const T* valoresLote, const std::int64_t* marcasLote, std::size_t cantidadLote)
+    {
+        std::lock_guard<std::mutex> guardia(mutexAnexo);
+        return agregarLote(valoresLote, marcasLote, cantidadLote);
+    }
+
+    /**
+     * @brief Recorre las lecturas en [desde, hasta) llamando a funcion(marca, valor).
+     *
+     * Las lecturas ya anexadas no cambian, así que puede recorrerse un rango
+     * anterior mientras otro hilo sigue anexando.
+     */
+    template <typename T, typename Funcion>
+    void recorrer(std::size_t desde, std::size_t hasta, Funcion funcion) const
+    {
+        static_assert(sizeof(T) == sizeof(std::uint32_t), "Las columnas guardan valores de 4 bytes");
+        while (desde < hasta)
+        {
+            const Segmento& segmento = segmentos[desde / capacidad];
+            std::size_t inicio = desde % capacidad;
+            std::size_t fin = inicio + (hasta - desde);
+            fin = (fin > segmento.cantidad) ? segmento.cantidad : fin;
+
+            const std::int64_t* columnaMarcas = marcas(segmento);
+            const unsigned char* columnaValores = reinterpret_cast<const unsigned char*>(valores(segmento));
+            for (std::size_t i = inicio; i < fin; ++i)
+            {
+                T valor;
+                std::memcpy(&valor, columnaValores + i * sizeof(T), sizeof(T));
+                funcion(columnaMarcas[i], valor);
+            }
+            desde += fin - inicio;
+        }
+    }
+
+    /**
+     * @brief Lleva al disco todas las lecturas y actualiza los contadores confirmados.
+     *
+     * Primero se sincronizan las columnas y después el encabezado, de modo que
+     * un encabezado en disco nunca confirma lecturas que aún no están ahí.
+     */
+    bool sincronizar()
+    {
+        bool correcto = true;
+        for (std::size_t i = 0; i < cantidadSegmentos; ++i)
+        {
+            Segmento& segmento = segmentos[i];
+            EncabezadoSegmento* encabezado = reinterpret_cast<EncabezadoSegmento*>(segmento.mapa);
+            if (encabezado->confirmadas == segmento.cantidad)
+            {
+                continue;
+            }
+            correcto = (msync(segmento.mapa, segmento.tamano, MS_SYNC) == 0) && correcto;
+            encabezado->confirmadas = segmento.cantidad;
+            correcto = (msync(segmento.mapa, sizeof(EncabezadoSegmento), MS_SYNC) == 0) && correcto;
+        }
+        if (!correcto)
+        {
+            AuxiliarCli cli;
+            cli.imprimirLogFormato<NivelLog::Error>("No se pudo sincronizar el historial de %s: %s", nombre,
+                                                    std::strerror(errno));
+        }
+        return correcto;
+    }
+
+    /// Sincroniza y libera los mapeos; la columna queda cerrada.
+    void cerrar()
+    {
+        if (cantidadSegmentos > 0)
+        {
+            sincronizar();
+        }
+        for (std::size_t i = 0; i < cantidadSegmentos; ++i)
+        {
+            munmap(segmentos[i].mapa, segmentos[i].tamano);
+            close(segmentos[i].fd);
+        }
+        cantidadSegmentos = 0;
+        total = 0;
+        recuperadas = 0;
+        avisoLleno = false;
+        directorio[0] = '\0';
+    }
+
+private:
+    struct Segmento
+    {
+        unsigned char* mapa;
+        std::size_t tamano;
+        int fd;
+        std::uint32_t cantidad;
+    };
+
+    /// Largo de "/NNNNNNNN.seg" que rutaSegmento() agrega al directorio.
+    static constexpr std::size_t LARGO_NOMBRE_SEGMENTO = 13;
+
+    char directorio[PATH_MAX];
+    char nombre[56];
+    std::uint32_t capacidad;
+    Segmento segmentos[MAX_SEGMENTOS];
+    std::size_t cantidadSegmentos;
+    std::size_t total;
+    std::size_t recuperadas;
+    char tipo;
+    bool avisoLleno;
+    std::mutex mutexAnexo;
+
+    static std::size_t tamanoSegmento(std::uint32_t capacidadSegmento)
+    {
+        return sizeof(EncabezadoSegmento) +
+               static_cast<std::size_t>(capacidadSegmento) * (sizeof(std::int64_t) + sizeof(std::uint32_t));
+    }
+
+    static bool encabezadoValido(const EncabezadoSegmento& encabezado)
+    {
+        return std::memcmp(encabezado.magia, "GSHIST\0\0", sizeof(encabezado.magia)) == 0 &&
+               encabezado.version == VERSION_FORMATO && encabezado.capacidad > 0 &&
+               encabezado.confirmadas <= encabezado.capacidad && (encabezado.tipo == 'T' || encabezado.tipo == 'P');
+    }
+
+    std::int64_t* marcas(const Segmento& segmento) const
+    {
+        return reinterpret_cast<std::int64_t*>(segmento.mapa + sizeof(EncabezadoSegmento));
+    }
+
+    std::uint32_t* valores(const Segmento& segmento) const
+    {
+        return reinterpret_cast<std::uint32_t*>(segmento.mapa + sizeof(EncabezadoSegmento) +
+                                                static_cast<std::size_t>(capacidad) * sizeof(std::int64_t));
+    }
+
+    /// Arma la ruta de un segmento; false si no cabe en destino.
+    bool rutaSegmento(std::uint32_t numero, char* destino, std::size_t tam) const
+    {
+        int largo = std::snprintf(destino, tam, "%s/%08u.seg", directorio, numero);
+        return largo >= 0 && static_cast<std::size_t>(largo) < tam;
+    }
+
+    /// Copia una cadena truncándola a tam - 1 caracteres; el destino queda siempre terminado en nulo.
+    static void copiarAcotado(char* destino, std::size_t tam, const char* origen)
+    {
+        if (tam == 0)
+        {
+            return;
+        }
+        std::size_t largo = std::strlen(origen);
+        if (largo >= tam)
+        {
+            largo = tam - 1;
+        }
+        std::memcpy(destino, origen, largo);
+        destino[largo] = '\0';
+    }
+
+    /// Mapea un archivo de segmento; devuelve nullptr y registra el error si falla.
+    unsigned char* mapear(int fd, std::size_t tamano, const char* ruta)
+    {
+        void* mapa = mmap(nullptr, tamano, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapa == MAP_FAILED)
+        {
+            AuxiliarCli cli;
+            cli.imprimirLogFormato<NivelLog::Error>("No se pudo mapear '%s': %s", ruta, std::strerror(errno));
+            return nullptr;
+        }
+        return static_cast<unsigned char*>(mapa);
+    }
+
+    /**
+     * @brief Mapea un segmento existente y cuenta sus lecturas.
+     *
+     * Un último segmento sin encabezado válido es uno cuya creación se
+     * interrumpió: se reinicializa en lugar de rechazar la columna.
+     */
+    bool abrirSegmento(const char* ruta, std::uint32_t numero)
+    {
+        AuxiliarCli cli;
+        int fd = open(ruta, O_RDWR | O_CLOEXEC);
+        if (fd < 0)
+        {
+            cli.imprimirLogFormato<NivelLog::Error>("No se pudo abrir '%s': %s", ruta, std::strerror(errno));
+            return false;
+        }
+
+        struct stat info;
+        EncabezadoSegmento encabezado;
+        bool legible = fstat(fd, &info) == 0 &&
+                       pread(fd, &encabezado, sizeof(encabezado), 0) == static_cast<ssize_t>(sizeof(encabezado));
+        if (!legible || !encabezadoValido(encabezado))
+        {
+            char siguiente[PATH_MAX];
+            if (!rutaSegmento(numero + 1, siguiente, sizeof(siguiente)) || access(siguiente, F_OK) != 0)
+            {
+                cli.imprimirLogFormato<NivelLog::Advertencia>("Segmento '%s' incompleto; se reinicia.", ruta);
+                return inicializarSegmento(fd, ruta, numero);
+            }
+            cli.imprimirLogFormato<NivelLog::Error>("Segmento '%s' dañado.", ruta);
+            close(fd);
+            return false;
+        }
+
+        encabezado.nombre[sizeof(encabezado.nombre) - 1] = '\0';
+        if (encabezado.tipo != tipo)
+        {
+            cli.imprimirLogFormato<NivelLog::Error>("El historial '%s' es de tipo '%c', no '%c'.", directorio,
+                                                    encabezado.tipo, tipo);
+            close(fd);
+            return false;
+        }
+        if (numero == 0)
+        {
+            capacidad = encabezado.capacidad;
+        }
+        std::size_t tamano = tamanoSegmento(capacidad);
+        if (encabezado.capacidad != capacidad || encabezado.numero != numero ||
+            static_cast<std::size_t>(info.st_size) < tamano)
+        {
+            cli.imprimirLogFormato<NivelLog::Error>("Segmento '%s' no coincide con el resto del historial.", ruta);
+            close(fd);
+            return false;
+        }
+
+        unsigned char* mapa = mapear(fd, tamano, ruta);
+        if (!mapa)
+        {
+            close(fd);
+            return false;
+        }
+
+        Segmento& segmento = segmentos[cantidadSegmentos++];
+        segmento.mapa = mapa;
+        segmento.tamano = tamano;
+        segmento.fd = fd;
+
+        // Lo confirmado es válido; después, cada marca no nula es una lectura
+        // completa que no alcanzó a confirmarse.
+        std::size_t cantidad = static_cast<std::size_t>(encabezado.confirmadas);
+        const std::int64_t* columnaMarcas = marcas(segmento);
+        while (cantidad < capacidad && columnaMarcas[cantidad] != 0)
+        {
+            ++cantidad;
+        }
+        recuperadas += cantidad - static_cast<std::size_t>(encabezado.confirmadas);
+        segmento.cantidad = static_cast<std::uint32_t>(cantidad);
+        total += cantidad;
+        return true;
+    }
+
+    /// Da tamaño, mapea y escribe el encabezado de un segmento vacío.
+    bool inicializarSegmento(int fd, const char* ruta, std::uint32_t numero)
+    {
+        AuxiliarCli cli;
+        std::size_t tamano = tamanoSegmento(capacidad);
+        if (ftruncate(fd, 0) != 0 || ftruncate(fd, static_cast<off_t>(tamano)) != 0)
+        {
+            cli.imprimirLogFormato<NivelLog::Error>("No se pudo dimensionar '%s': %s", ruta, std::strerror(errno));
+            close(fd);
+            return false;
+        }
+
+        unsigned char* mapa = mapear(fd, tamano, ruta);
+        if (!mapa)
+        {
+            close(fd);
+            return false;
+        }
+
+        EncabezadoSegmento* encabezado = reinterpret_cast<EncabezadoSegmento*>(mapa);
+        std::memcpy(encabezado->magia, "GSHIST\0\0", sizeof(encabezado->magia));
+        encabezado->version = VERSION_FORMATO;
+        encabezado->capacidad = capacidad;
+        encabezado->confirmadas = 0;
+        encabezado->numero = numero;
+        encabezado->tipo = tipo;
+        copiarAcotado(encabezado->nombre, sizeof(encabezado->nombre), nombre);
+
+        Segmento& segmento = segmentos[cantidadSegmentos++];
+        segmento.mapa = mapa;
+        segmento.tamano = tamano;
+        segmento.fd = fd;
+        segmento.cantidad = 0;
+        return true;
+    }
+
+    /**
+     * @brief Crea el siguiente segmento.
+     *
+     * El encabezado del segmento lleno no se toca: confirmar sin sincronizar
+     * podría dejar en disco un contador adelantado a los datos.
+     */
+    bool agregarSegmento()
+    {
+        if (!estaAbierta())
+        {
+            return false;
+        }
+        if (cantidadSegmentos == MAX_SEGMENTOS)
+        {
+            if (!avisoLleno)
+            {
+                AuxiliarCli cli;
+                cli.imprimirLogFormato<NivelLog::Error>("El historial de %s alcanzó su máximo de segmentos.", nombre);
+                avisoLleno = true;
+            }
+            return false;
+        }
+        char ruta[PATH_MAX];
+        std::uint32_t numero = static_cast<std::uint32_t>(cantidadSegmentos);
+        if (!rutaSegmento(numero, ruta, sizeof(ruta)))
+        {
+            AuxiliarCli cli;
+            cli.imprimirLogFormato<NivelLog::Error>("La ruta del segmento %u de %s excede PATH_MAX.", numero, nombre);
+            return false;
+        }
+        int fd = open(ruta, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd < 0)
+        {
+            AuxiliarCli cli;
+            cli.imprimirLogFormato<NivelLog::Error>("No se pudo crear '%s': %s", ruta, std::strerror(errno));
+            return false;
+        }
+        return inicializarSegmento(fd, ruta, numero);
+    }
+};
+
+#endif
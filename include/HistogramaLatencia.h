@@ -0,0 +1,195 @@
+/**
+ * @file HistogramaLatencia.h
+ * @brief Histograma de latencias con cubetas logarítmicas subdivididas (estilo HDR).
+ */
+#ifndef HISTOGRAMALATENCIA_H
+#define HISTOGRAMALATENCIA_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Cuenta latencias en nanosegundos con error relativo acotado y memoria fija.
+ *
+ * Los valores menores que SUBCUBETAS tienen cubeta propia; a partir de ahí
+ * cada potencia de dos se divide en SUBCUBETAS cubetas iguales, de modo que
+ * un percentil se reporta con un error menor a 1/SUBCUBETAS (6.25 %) sin
+ * importar si la latencia es de 50 ns o de 3 s. Registrar es un cálculo de
+ * bits y un incremento: no reserva memoria ni toma locks.
+ */
+class HistogramaLatencia
+{
+public:
+    /// Bits de subdivisión por potencia de dos.
+    static constexpr int BITS_SUBCUBETA = 4;
+    /// Cubetas por potencia de dos.
+    static constexpr std::size_t SUBCUBETAS = std::size_t(1) << BITS_SUBCUBETA;
+    /// Cubetas suficientes para cualquier valor de 64 bits.
+    static constexpr std::size_t CUBETAS = (64 - BITS_SUBCUBETA + 1) * SUBCUBETAS;
+
+    HistogramaLatencia()
+    {
+        reiniciar();
+    }
+
+    /// Cuenta una latencia.
+    void registrar(std::uint64_t nanosegundos)
+    {
+        ++conteos[cubeta(nanosegundos)];
+        ++cantidad;
+        suma += nanosegundos;
+        if (nanosegundos < minimo)
+        {
+            minimo = nanosegundos;
+        }
+        if (nanosegundos > maximo)
+        {
+            maximo = nanosegundos;
+        }
+    }
+
+    /// Suma las cuentas de otro histograma (por ejemplo, el de otro hilo).
+    void combinar(const HistogramaLatencia& otro)
+    {
+        for (std::size_t i = 0; i < CUBETAS; ++i)
+        {
+            conteos[i] += otro.conteos[i];
+        }
+        cantidad += otro.cantidad;
+        suma += otro.suma;
+        if (otro.minimo < minimo)
+        {
+            minimo = otro.minimo;
+        }
+        if (otro.maximo > maximo)
+        {
+            maximo = otro.maximo;
+        }
+    }
+
+    /**
+     * @brief Suma cuentas que otro código agrupó con cubeta() (por ejemplo, contadores atómicos de un hilo).
+     * @param conteosCubetas Arreglo de CUBETAS cuentas.
+     */
+    void combinar(const std::uint64_t* conteosCubetas, std::uint64_t sumaValores, std::uint64_t minimoValor,
+                  std::uint64_t maximoValor)
+    {
+        for (std::size_t i = 0; i < CUBETAS; ++i)
+        {
+            conteos[i] += conteosCubetas[i];
+            cantidad += conteosCubetas[i];
+        }
+        suma += sumaValores;
+        if (minimoValor < minimo)
+        {
+            minimo = minimoValor;
+        }
+        if (maximoValor > maximo)
+        {
+            maximo = maximoValor;
+        }
+    }
+
+    /// Descarta todas las cuentas.
+    void reiniciar()
+    {
+        for (std::size_t i = 0; i < CUBETAS; ++i)
+        {
+            conteos[i] = 0;
+        }
+        cantidad = 0;
+        suma = 0;
+        minimo = UINT64_MAX;
+        maximo = 0;
+    }
+
+    /**
+     * @brief Latencia bajo la cual queda el porcentaje indicado de las muestras.
+     * @param porcentaje Entre 0 y 100 (por ejemplo 99.9).
+     * @return Límite superior de la cubeta del percentil, acotado al máximo observado; 0 si no hay muestras.
+     */
+    std::uint64_t percentil(double porcentaje) const
+    {
+        if (cantidad == 0)
+        {
+            return 0;
+        }
+        double exacto = porcentaje / 100.0 * static_cast<double>(cantidad);
+        std::uint64_t objetivo = static_cast<std::uint64_t>(exacto);
+        if (static_cast<double>(objetivo) < exacto || objetivo == 0)
+        {
+            ++objetivo;
+        }
+
+        std::uint64_t acumulado = 0;
+        for (std::size_t i = 0; i < CUBETAS; ++i)
+        {
+            acumulado += conteos[i];
+            if (acumulado >= objetivo)
+            {
+                std::uint64_t limite = limiteSuperior(i);
+                return (limite < maximo) ? limite : maximo;
+            }
+        }
+        return maximo;
+    }
+
+    /// Muestras registradas.
+    std::uint64_t obtenerCantidad() const
+    {
+        return cantidad;
+    }
+
+    /// Menor latencia registrada; 0 si no hay muestras.
+    std::uint64_t obtenerMinimo() const
+    {
+        return (cantidad == 0) ? 0 : minimo;
+    }
+
+    /// Mayor latencia registrada.
+    std::uint64_t obtenerMaximo() const
+    {
+        return maximo;
+    }
+
+    /// Media exacta de las latencias registradas.
+    double promedio() const
+    {
+        return (cantidad == 0) ? 0.0 : static_cast<double>(suma) / static_cast<double>(cantidad);
+    }
+
+    /// Cubeta de un valor: lineal bajo SUBCUBETAS, luego SUBCUBETAS por potencia de dos.
+    static std::size_t cubeta(std::uint64_t valor)
+    {
+        if (valor < SUBCUBETAS)
+        {
+            return static_cast<std::size_t>(valor);
+        }
+        int bitAlto = 63 - __builtin_clzll(valor);
+        int desplazamiento = bitAlto - BITS_SUBCUBETA;
+        std::size_t superiores = static_cast<std::size_t>(valor >> desplazamiento);
+        return static_cast<std::size_t>(desplazamiento + 1) * SUBCUBETAS + (superiores - SUBCUBETAS);
+    }
+
+private:
+    std::uint64_t conteos[CUBETAS];
+    std::uint64_t cantidad;
+    std::uint64_t suma;
+    std::uint64_t minimo;
+    std::uint64_t maximo;
+
+    /// Mayor valor que cae en la cubeta indicada.
+    static std::uint64_t limiteSuperior(std::size_t indice)
+    {
+        if (indice < SUBCUBETAS)
+        {
+            return indice;
+        }
+        int desplazamiento = static_cast<int>(indice / SUBCUBETAS) - 1;
+        std::uint64_t superiores = SUBCUBETAS + indice % SUBCUBETAS;
+        // En la última cubeta el desplazamiento da 2^64, que se envuelve a 0 y resta a UINT64_MAX.
+        return ((superiores + 1) << desplazamiento) - 1;
+    }
+};
+
+#endif
@@ -0,0 +1,424 @@
+/**
+ * @file HistorialVentana.h
+ * @brief Historial acotado en un buffer circular con media, mínimo y máximo deslizantes.
+ */
+#ifndef HISTORIALVENTANA_H
+#define HISTORIALVENTANA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include "IndiceTemporal.h"
+#include "PilaPendientes.h"
+
+/**
+ * @brief Política de retención de lecturas de un sensor.
+ *
+ * maxLecturas fija la capacidad del buffer (y por lo tanto la memoria); con
+ * 0 el sensor vuelve al historial ilimitado en lista enlazada. maxSegundos,
+ * si es mayor que cero, descarta además las lecturas más antiguas que eso.
+ */
+struct PoliticaRetencion
+{
+    /// Tope de maxLecturas: la ventana reserva de golpe unos 28 bytes por lectura (unos 280 MB con float).
+    static constexpr std::size_t MAX_LECTURAS = 10000000;
+
+    std::size_t maxLecturas = 0;
+    double maxSegundos = 0.0;
+};
+
+/**
+ * @brief Ventana de las últimas lecturas sobre un buffer circular contiguo.
+ *
+ * Cada lectura guarda su marca de tiempo. Al insertar con la ventana llena se
+ * descarta la más antigua; la suma se ajusta al entrar y salir cada valor y
+ * dos colas monótonas (una creciente para el mínimo y otra decreciente para
+ * el máximo) dan los extremos, de modo que insertar y consultar cuestan O(1)
+ * amortizado. Toda la memoria se reserva al construir.
+ *
+ * Borrar una lectura intermedia (eliminarPrimeraCoincidencia) recorre la
+ * ventana y reconstruye las colas en O(n); es la operación de procesamiento,
+ * no la de ingesta.
+ */
+template <typename T>
+class HistorialVentana
+{
+public:
+    /**
+     * @brief Reserva la ventana según la política.
+     * @param retencion maxLecturas debe ser mayor que cero.
+     */
+    explicit HistorialVentana(const PoliticaRetencion& retencion)
+        : politica(retencion), capacidad(retencion.maxLecturas > 0 ? retencion.maxLecturas : 1), valores(nullptr),
+          marcas(nullptr), primero(0), siguiente(0), minimos(nullptr), maximos(nullptr), inicioMinimos(0),
+          finMinimos(0), inicioMaximos(0), finMaximos(0), suma(0.0), salidasDesdeRecalculo(0)
+    {
+        // Si una reserva falla se liberan las anteriores antes de propagar std::bad_alloc.
+        try
+        {
+            valores = new T[capacidad];
+            marcas = new std::int64_t[capacidad];
+            minimos = new std::uint64_t[capacidad];
+            maximos = new std::uint64_t[capacidad];
+        }
+        catch (const std::bad_alloc&)
+        {
+            delete[] valores;
+            delete[] marcas;
+            delete[] minimos;
+            delete[] maximos;
+            throw;
+        }
+    }
+
+    HistorialVentana(const HistorialVentana&) = delete;
+    HistorialVentana& operator=(const HistorialVentana&) = delete;
+
+    ~HistorialVentana()
+    {
+        delete[] valores;
+        delete[] marcas;
+        delete[] minimos;
+        delete[] maximos;
+    }
+
+    /// Política con la que se creó la ventana.
+    const PoliticaRetencion& obtenerPolitica() const
+    {
+        return politica;
+    }
+
+    /// Inserta una lectura con la hora actual.
+    void insertarAlFinal(const T& valor)
+    {
+        insertarEn(valor, relojActual());
+    }
+
+    /**
+     * @brief Inserta una lectura con una marca de tiempo explícita (nanosegundos, reloj monotónico).
+     *
+     * Si la ventana está llena sale la lectura más antigua; después se
+     * descartan las que superen la antigüedad máxima respecto a esta marca.
+     */
+    void insertarEn(const T& valor, std::int64_t marcaNs)
+    {
+        if (contar() == static_cast<int>(capacidad))
+        {
+            expulsarPrimera();
+        }
+
+        std::uint64_t posicion = siguiente++;
+        valores[posicion % capacidad] = valor;
+        marcas[posicion % capacidad] = marcaNs;
+        suma += static_cast<double>(valor);
+        encolarExtremos(posicion);
+        expirar(marcaNs);
+    }
+
+    /// Inserta varias lecturas en orden, cada una con su marca; igual que insertarEn() por cada una.
+    void insertarLote(const T* valoresLote, const std::int64_t* marcasLote, std::size_t cantidadLote)
+    {
+        for (std::size_t i = 0; i < cantidadLote; ++i)
+        {
+            insertarEn(valoresLote[i], marcasLote[i]);
+        }
+    }
+
+    /// Agrega una lectura desde cualquier hilo; se incorpora con consolidarPendientes().
+    void insertarConcurrente(const T& valor)
+    {
+        insertarConcurrente(valor, relojActual());
+    }
+
+    /// Variante de insertarConcurrente() con una marca de tiempo explícita.
+    void insertarConcurrente(const T& valor, std::int64_t marcaNs)
+    {
+        pendientes.apilar(valor, marcaNs);
+    }
+
+    /// Variante por lotes de insertarConcurrente(): una sola operación atómica sobre la pila.
+    void insertarLoteConcurrente(const T* valoresLote, const std::int64_t* marcasLote, std::size_t cantidadLote)
+    {
+        pendientes.apilarLote(valoresLote, marcasLote, cantidadLote);
+    }
+
+    /// Incorpora en orden de llegada las lecturas de insertarConcurrente(), con la marca que traían.
+    int consolidarPendientes()
+    {
+        return pendientes.consumir(
+            [this](const T* valoresLote, const std::int64_t* marcasLote, std::size_t cantidadLote)
+            { insertarLote(valoresLote, marcasLote, cantidadLote); });
+    }
+
+    /// Descarta las lecturas más antiguas que maxSegundos respecto a la hora actual.
+    void expirar()
+    {
+        expirar(relojActual());
+    }
+
+    /// Descarta las lecturas más antiguas que maxSegundos respecto a ahoraNs.
+    void expirar(std::int64_t ahoraNs)
+    {
+        if (politica.maxSegundos <= 0.0)
+        {
+            return;
+        }
+
+        std::int64_t limite = ahoraNs - static_cast<std::int64_t>(politica.maxSegundos * 1e9);
+        while (primero < siguiente && marcas[primero % capacidad] < limite)
+        {
+            expulsarPrimera();
+        }
+    }
+
+    /// Indica si la ventana no contiene lecturas.
+    bool estaVacia() const
+    {
+        return primero == siguiente;
+    }
+
+    /// Lecturas dentro de la ventana.
+    int contar() const
+    {
+        return static_cast<int>(siguiente - primero);
+    }
+
+    /// Suma de las lecturas dentro de la ventana.
+    double obtenerSuma() const
+    {
+        return suma;
+    }
+
+    /// Media de la ventana (O(1)).
+    double promedio() const
+    {
+        if (estaVacia())
+        {
+            return 0.0;
+        }
+        return suma / static_cast<double>(contar());
+    }
+
+    /// Mínimo de la ventana (O(1)).
+    bool obtenerMinimo(T& minimo) const
+    {
+        if (inicioMinimos == finMinimos)
+        {
+            return false;
+        }
+        minimo = valores[minimos[inicioMinimos % capacidad] % capacidad];
+        return true;
+    }
+
+    /// Máximo de la ventana (O(1)).
+    bool obtenerMaximo(T& maximo) const
+    {
+        if (inicioMaximos == finMaximos)
+        {
+            return false;
+        }
+        maximo = valores[maximos[inicioMaximos % capacidad] % capacidad];
+        return true;
+    }
+
+    /// Extrae la lectura más antigua.
+    bool extraerPrimero(T& valor)
+    {
+        std::int64_t marca = 0;
+        return extraerPrimero(valor, marca);
+    }
+
+    /// Extrae la lectura más antigua junto con su marca de tiempo.
+    bool extraerPrimero(T& valor, std::int64_t& marcaNs)
+    {
+        if (estaVacia())
+        {
+            return false;
+        }
+        valor = valores[primero % capacidad];
+        marcaNs = marcas[primero % capacidad];
+        expulsarPrimera();
+        return true;
+    }
+
+    /**
+     * @brief Cantidad, suma y extremos de las lecturas con marca en [desdeNs, hastaNs).
+     *
+     * Recorre la ventana (O(capacidad)); al estar acotada no necesita índice.
+     */
+    ResumenRango<T> resumirRango(std::int64_t desdeNs, std::int64_t hastaNs) const
+    {
+        ResumenRango<T> resumen;
+        for (std::uint64_t posicion = primero; posicion < siguiente; ++posicion)
+        {
+            std::int64_t marca = marcas[posicion % capacidad];
+            if (marca >= desdeNs && marca < hastaNs)
+            {
+                resumen.agregar(valores[posicion % capacidad]);
+            }
+        }
+        return resumen;
+    }
+
+    /**
+     * @brief Elimina la lectura más antigua igual al valor, conservando el orden del resto (O(n)).
+     */
+    bool eliminarPrimeraCoincidencia(const T& valor)
+    {
+        std::uint64_t posicion = primero;
+        while (posicion < siguiente && !(valores[posicion % capacidad] == valor))
+        {
+            ++posicion;
+        }
+        if (posicion == siguiente)
+        {
+            return false;
+        }
+
+        for (; posicion + 1 < siguiente; ++posicion)
+        {
+            valores[posicion % capacidad] = valores[(posicion + 1) % capacidad];
+            marcas[posicion % capacidad] = marcas[(posicion + 1) % capacidad];
+        }
+        --siguiente;
+        reconstruir();
+        return true;
+    }
+
+    /**
+     * @brief Elimina la lectura de menor valor (la más antigua si hay empate), O(capacidad).
+     *
+     * Misma interfaz que ListaSensor::eliminarMinimo(); aquí el desplazamiento
+     * queda acotado por la capacidad de la ventana.
+     */
+    bool eliminarMinimo(T& minimo)
+    {
+        return obtenerMinimo(minimo) && eliminarPrimeraCoincidencia(minimo);
+    }
+
+    /// Vacía la ventana sin liberar el buffer.
+    void limpiar()
+    {
+        pendientes.descartar();
+        primero = 0;
+        siguiente = 0;
+        inicioMinimos = finMinimos = 0;
+        inicioMaximos = finMaximos = 0;
+        suma = 0.0;
+        salidasDesdeRecalculo = 0;
+    }
+
+    /// Recorre las lecturas de la más antigua a la más reciente.
+    template <typename Funcion>
+    void recorrer(Funcion&& funcion) const
+    {
+        for (std::uint64_t posicion = primero; posicion < siguiente; ++posicion)
+        {
+            funcion(valores[posicion % capacidad]);
+        }
+    }
+
+    /// Capacidad fija de la ventana.
+    std::size_t obtenerCapacidad() const
+    {
+        return capacidad;
+    }
+
+    /// Bytes reservados por el buffer y las colas de extremos (constante).
+    std::size_t bytesReservados() const
+    {
+        return capacidad * (sizeof(T) + sizeof(std::int64_t) + 2 * sizeof(std::uint64_t));
+    }
+
+    /// Hora actual del reloj monotónico en nanosegundos.
+    static std::int64_t relojActual()
+    {
+        return marcaMonotonica();
+    }
+
+private:
+    PoliticaRetencion politica;
+    std::size_t capacidad;
+    T* valores;
+    std::int64_t* marcas;
+    /// Posiciones absolutas (no módulo) de la lectura más antigua y de la siguiente a escribir.
+    std::uint64_t primero;
+    std::uint64_t siguiente;
+    /// Colas monótonas de posiciones absolutas, también circulares.
+    std::uint64_t* minimos;
+    std::uint64_t* maximos;
+    std::uint64_t inicioMinimos;
+    std::uint64_t finMinimos;
+    std::uint64_t inicioMaximos;
+    std::uint64_t finMaximos;
+    double suma;
+    /// Salidas desde la última suma exacta; acota el error de redondeo acumulado.
+    std::size_t salidasDesdeRecalculo;
+    PilaPendientes<T> pendientes;
+
+    /// Agrega la posición a ambas colas, retirando del final las que ya no pueden ser extremo.
+    void encolarExtremos(std::uint64_t posicion)
+    {
+        const T& valor = valores[posicion % capacidad];
+        while (finMinimos > inicioMinimos && !(valores[minimos[(finMinimos - 1) % capacidad] % capacidad] < valor))
+        {
+            --finMinimos;
+        }
+        minimos[finMinimos++ % capacidad] = posicion;
+
+        while (finMaximos > inicioMaximos && !(valor < valores[maximos[(finMaximos - 1) % capacidad] % capacidad]))
+        {
+            --finMaximos;
+        }
+        maximos[finMaximos++ % capacidad] = posicion;
+    }
+
+    /// Saca la lectura más antigua y, si encabezaba alguna cola, también de ahí.
+    void expulsarPrimera()
+    {
+        suma -= static_cast<double>(valores[primero % capacidad]);
+        if (inicioMinimos < finMinimos && minimos[inicioMinimos % capacidad] == primero)
+        {
+            ++inicioMinimos;
+        }
+        if (inicioMaximos < finMaximos && maximos[inicioMaximos % capacidad] == primero)
+        {
+            ++inicioMaximos;
+        }
+        ++primero;
+
+        if (primero == siguiente)
+        {
+            suma = 0.0;
+            salidasDesdeRecalculo = 0;
+        }
+        else if (++salidasDesdeRecalculo >= capacidad)
+        {
+            recalcularSuma();
+        }
+    }
+
+    void recalcularSuma()
+    {
+        suma = 0.0;
+        for (std::uint64_t posicion = primero; posicion < siguiente; ++posicion)
+        {
+            suma += static_cast<double>(valores[posicion % capacidad]);
+        }
+        salidasDesdeRecalculo = 0;
+    }
+
+    /// Rehace la suma y las colas de extremos a partir del contenido actual.
+    void reconstruir()
+    {
+        inicioMinimos = finMinimos = 0;
+        inicioMaximos = finMaximos = 0;
+        for (std::uint64_t posicion = primero; posicion < siguiente; ++posicion)
+        {
+            encolarExtremos(posicion);
+        }
+        recalcularSuma();
+    }
+};
+
+#endif
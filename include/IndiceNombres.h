@@ -0,0 +1,200 @@
+/**
+ * @file IndiceNombres.h
+ * @brief Tabla hash de direccionamiento abierto que indexa sensores por nombre.
+ */
+#ifndef INDICENOMBRES_H
+#define INDICENOMBRES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "SensorBase.h"
+
+/**
+ * @brief Índice de sensores por nombre con sondeo lineal.
+ *
+ * Solo guarda apuntadores: la propiedad de los sensores sigue en la lista que
+ * mantiene el índice. Cada ranura conserva el hash completo para descartar
+ * colisiones sin comparar cadenas, y la tabla duplica su tamaño al superar
+ * la mitad de ocupación, de modo que búsqueda e inserción son O(1) esperado.
+ */
+class IndiceNombres
+{
+public:
+    IndiceNombres() : ranuras(nullptr), capacidad(0), ocupadas(0) {}
+
+    IndiceNombres(const IndiceNombres&) = delete;
+    IndiceNombres& operator=(const IndiceNombres&) = delete;
+
+    ~IndiceNombres()
+    {
+        vaciar();
+    }
+
+    /**
+     * @brief Busca un sensor por nombre.
+     * @param id Cadena terminada en nulo.
+     * @return Puntero al sensor o nullptr si no está indexado.
+     */
+    SensorBase* buscar(const char* id) const
+    {
+        if (!id)
+        {
+            return nullptr;
+        }
+        return buscar(id, std::strlen(id));
+    }
+
+    /**
+     * @brief Busca un sensor a partir de un fragmento de texto sin terminador.
+     * @param id Inicio del nombre.
+     * @param longitud Número de caracteres del nombre.
+     * @return Puntero al sensor o nullptr si no está indexado.
+     */
+    SensorBase* buscar(const char* id, std::size_t longitud) const
+    {
+        if (!id || ocupadas == 0)
+        {
+            return nullptr;
+        }
+
+        std::uint64_t hash = calcularHash(id, longitud);
+        std::size_t mascara = capacidad - 1;
+        for (std::size_t i = static_cast<std::size_t>(hash) & mascara;; i = (i + 1) & mascara)
+        {
+            const Ranura& ranura = ranuras[i];
+            if (!ranura.sensor)
+            {
+                return nullptr;
+            }
+            if (ranura.hash == hash && coincide(ranura.sensor->obtenerNombre(), id, longitud))
+            {
+                return ranura.sensor;
+            }
+        }
+    }
+
+    /**
+     * @brief Indexa un sensor por su nombre actual.
+     * @param sensor Sensor a indexar; su nombre no debe estar ya presente.
+     * @return true si se indexó, false si era nulo o el nombre ya existía.
+     */
+    bool insertar(SensorBase* sensor)
+    {
+        if (!sensor)
+        {
+            return false;
+        }
+
+        if ((ocupadas + 1) * 2 > capacidad)
+        {
+            redimensionar((capacidad == 0) ? 16 : capacidad * 2);
+        }
+
+        const char* nombre = sensor->obtenerNombre();
+        std::size_t longitud = std::strlen(nombre);
+        std::uint64_t hash = calcularHash(nombre, longitud);
+        std::size_t mascara = capacidad - 1;
+        for (std::size_t i = static_cast<std::size_t>(hash) & mascara;; i = (i + 1) & mascara)
+        {
+            Ranura& ranura = ranuras[i];
+            if (!ranura.sensor)
+            {
+                ranura.sensor = sensor;
+                ranura.hash = hash;
+                ++ocupadas;
+                return true;
+            }
+            if (ranura.hash == hash && coincide(ranura.sensor->obtenerNombre(), nombre, longitud))
+            {
+                return false;
+            }
+        }
+    }
+
+    /// Número de sensores indexados.
+    std::size_t tamano() const
+    {
+        return ocupadas;
+    }
+
+    /// Intercambia en O(1) las tablas de dos índices.
+    void intercambiar(IndiceNombres& otro)
+    {
+        Ranura* ranurasPropias = ranuras;
+        std::size_t capacidadPropia = capacidad;
+        std::size_t ocupadasPropias = ocupadas;
+        ranuras = otro.ranuras;
+        capacidad = otro.capacidad;
+        ocupadas = otro.ocupadas;
+        otro.ranuras = ranurasPropias;
+        otro.capacidad = capacidadPropia;
+        otro.ocupadas = ocupadasPropias;
+    }
+
+    /// Elimina todas las entradas y libera la tabla.
+    void vaciar()
+    {
+        delete[] ranuras;
+        ranuras = nullptr;
+        capacidad = 0;
+        ocupadas = 0;
+    }
+
+private:
+    struct Ranura
+    {
+        std::uint64_t hash;
+        SensorBase* sensor;
+    };
+
+    Ranura* ranuras;
+    std::size_t capacidad;
+    std::size_t ocupadas;
+
+    /// Hash FNV-1a de 64 bits sobre los bytes del nombre.
+    static std::uint64_t calcularHash(const char* texto, std::size_t longitud)
+    {
+        std::uint64_t hash = 1469598103934665603ULL;
+        for (std::size_t i = 0; i < longitud; ++i)
+        {
+            hash ^= static_cast<unsigned char>(texto[i]);
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    /// Compara un nombre terminado en nulo con un fragmento de longitud conocida.
+    static bool coincide(const char* nombre, const char* id, std::size_t longitud)
+    {
+        return std::strncmp(nombre, id, longitud) == 0 && nombre[longitud] == '\0';
+    }
+
+    /// Reubica todas las entradas en una tabla de la capacidad indicada (potencia de dos).
+    void redimensionar(std::size_t nuevaCapacidad)
+    {
+        Ranura* anteriores = ranuras;
+        std::size_t capacidadAnterior = capacidad;
+
+        ranuras = new Ranura[nuevaCapacidad]();
+        capacidad = nuevaCapacidad;
+
+        std::size_t mascara = capacidad - 1;
+        for (std::size_t j = 0; j < capacidadAnterior; ++j)
+        {
+            if (!anteriores[j].sensor)
+            {
+                continue;
+            }
+            std::size_t i = static_cast<std::size_t>(anteriores[j].hash) & mascara;
+            while (ranuras[i].sensor)
+            {
+                i = (i + 1) & mascara;
+            }
+            ranuras[i] = anteriores[j];
+        }
+        delete[] anteriores;
+    }
+};
+
+#endif
@@ -0,0 +1,189 @@
+/**
+ * @file IndiceNumerico.h
+ * @brief Tabla hash que resuelve sensores por (letra, número), la clave que usan las tramas binarias.
+ */
+#ifndef INDICENUMERICO_H
+#define INDICENUMERICO_H
+
+#include <cstddef>
+#include <cstdint>
+#include "SensorBase.h"
+
+/// Combina la letra y el número de un sensor en una sola clave.
+inline std::uint32_t claveNumerica(char tipo, std::uint16_t id)
+{
+    return (static_cast<std::uint32_t>(static_cast<unsigned char>(tipo)) << 16) | id;
+}
+
+/**
+ * @brief Obtiene la clave de un nombre con la forma "<letra>-<dígitos>" (por ejemplo "T-001").
+ * @return false si el nombre no tiene esa forma o el número no cabe en 16 bits.
+ */
+inline bool claveDesdeNombre(const char* nombre, std::uint32_t& clave)
+{
+    if (!nombre || !((nombre[0] >= 'A' && nombre[0] <= 'Z') || (nombre[0] >= 'a' && nombre[0] <= 'z')) ||
+        nombre[1] != '-' || nombre[2] == '\0')
+    {
+        return false;
+    }
+
+    std::uint32_t numero = 0;
+    for (const char* digito = nombre + 2; *digito; ++digito)
+    {
+        if (*digito < '0' || *digito > '9')
+        {
+            return false;
+        }
+        numero = numero * 10 + static_cast<std::uint32_t>(*digito - '0');
+        if (numero > 0xFFFF)
+        {
+            return false;
+        }
+    }
+    clave = claveNumerica(nombre[0], static_cast<std::uint16_t>(numero));
+    return true;
+}
+
+/**
+ * @brief Índice de sensores por clave numérica con sondeo lineal.
+ *
+ * Igual que IndiceNombres solo guarda apuntadores y duplica la tabla al
+ * superar la mitad de ocupación. Dos nombres distintos pueden compartir
+ * clave ("T-1" y "T-001"); en ese caso se conserva el primero registrado.
+ */
+class IndiceNumerico
+{
+public:
+    IndiceNumerico() : ranuras(nullptr), capacidad(0), ocupadas(0) {}
+
+    IndiceNumerico(const IndiceNumerico&) = delete;
+    IndiceNumerico& operator=(const IndiceNumerico&) = delete;
+
+    ~IndiceNumerico()
+    {
+        vaciar();
+    }
+
+    /// Busca el sensor con la clave indicada.
+    SensorBase* buscar(std::uint32_t clave) const
+    {
+        if (ocupadas == 0)
+        {
+            return nullptr;
+        }
+
+        std::size_t mascara = capacidad - 1;
+        for (std::size_t i = dispersar(clave) & mascara;; i = (i + 1) & mascara)
+        {
+            if (!ranuras[i].sensor)
+            {
+                return nullptr;
+            }
+            if (ranuras[i].clave == clave)
+            {
+                return ranuras[i].sensor;
+            }
+        }
+    }
+
+    /**
+     * @brief Indexa el sensor si su nombre tiene la forma "<letra>-<dígitos>".
+     * @return true si quedó indexado.
+     */
+    bool insertar(SensorBase* sensor)
+    {
+        std::uint32_t clave = 0;
+        if (!sensor || !claveDesdeNombre(sensor->obtenerNombre(), clave))
+        {
+            return false;
+        }
+
+        if ((ocupadas + 1) * 2 > capacidad)
+        {
+            redimensionar((capacidad == 0) ? 16 : capacidad * 2);
+        }
+
+        std::size_t mascara = capacidad - 1;
+        for (std::size_t i = dispersar(clave) & mascara;; i = (i + 1) & mascara)
+        {
+            if (!ranuras[i].sensor)
+            {
+                ranuras[i].clave = clave;
+                ranuras[i].sensor = sensor;
+                ++ocupadas;
+                return true;
+            }
+            if (ranuras[i].clave == clave)
+            {
+                return false;
+            }
+        }
+    }
+
+    /// Intercambia en O(1) las tablas de dos índices.
+    void intercambiar(IndiceNumerico& otro)
+    {
+        Ranura* ranurasPropias = ranuras;
+        std::size_t capacidadPropia = capacidad;
+        std::size_t ocupadasPropias = ocupadas;
+        ranuras = otro.ranuras;
+        capacidad = otro.capacidad;
+        ocupadas = otro.ocupadas;
+        otro.ranuras = ranurasPropias;
+        otro.capacidad = capacidadPropia;
+        otro.ocupadas = ocupadasPropias;
+    }
+
+    /// Elimina todas las entradas y libera la tabla.
+    void vaciar()
+    {
+        delete[] ranuras;
+        ranuras = nullptr;
+        capacidad = 0;
+        ocupadas = 0;
+    }
+
+private:
+    struct Ranura
+    {
+        std::uint32_t clave;
+        SensorBase* sensor;
+    };
+
+    Ranura* ranuras;
+    std::size_t capacidad;
+    std::size_t ocupadas;
+
+    /// Mezcla los bits de la clave para que números consecutivos no formen racimos.
+    static std::size_t dispersar(std::uint32_t clave)
+    {
+        return static_cast<std::size_t>((clave * 2654435761u) >> 7);
+    }
+
+    void redimensionar(std::size_t nuevaCapacidad)
+    {
+        Ranura* anteriores = ranuras;
+        std::size_t capacidadAnterior = capacidad;
+
+        ranuras = new Ranura[nuevaCapacidad]();
+        capacidad = nuevaCapacidad;
+
+        std::size_t mascara = capacidad - 1;
+        for (std::size_t j = 0; j < capacidadAnterior; ++j)
+        {
+            if (!anteriores[j].sensor)
+            {
+                continue;
+            }
+            std::size_t i = dispersar(anteriores[j].clave) & mascara;
+            while (ranuras[i].sensor)
+            {
+                i = (i + 1) & mascara;
+            }
+            ranuras[i] = anteriores[j];
+        }
+        delete[] anteriores;
+    }
+};
+
+#endif
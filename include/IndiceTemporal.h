@@ -0,0 +1,490 @@
+/**
+ * @file IndiceTemporal.h
+ * @brief Índice por tramos de una lista de lecturas ordenada por tiempo para resumir intervalos sin recorrerla.
+ */
+#ifndef INDICETEMPORAL_H
+#define INDICETEMPORAL_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include "Nodo.h"
+
+/// Hora actual del reloj monotónico en nanosegundos; es la marca de las lecturas en memoria.
+inline std::int64_t marcaMonotonica()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+/**
+ * @brief Cantidad, suma y extremos de las lecturas de un intervalo de tiempo.
+ */
+template <typename T>
+struct ResumenRango
+{
+    int cantidad = 0;
+    double suma = 0.0;
+    T minimo = T();
+    T maximo = T();
+
+    /// Media de las lecturas, o 0 si no hubo ninguna.
+    double promedio() const
+    {
+        return (cantidad == 0) ? 0.0 : suma / static_cast<double>(cantidad);
+    }
+
+    /// Incorpora una lectura.
+    void agregar(const T& valor)
+    {
+        if (cantidad == 0)
+        {
+            minimo = valor;
+            maximo = valor;
+        }
+        else
+        {
+            minimo = (valor < minimo) ? valor : minimo;
+            maximo = (maximo < valor) ? valor : maximo;
+        }
+        ++cantidad;
+        suma += static_cast<double>(valor);
+    }
+
+    /// Incorpora el resumen de otro grupo de lecturas.
+    void combinar(const ResumenRango& otro)
+    {
+        if (otro.cantidad == 0)
+        {
+            return;
+        }
+        if (cantidad == 0)
+        {
+            *this = otro;
+            return;
+        }
+        minimo = (otro.minimo < minimo) ? otro.minimo : minimo;
+        maximo = (maximo < otro.maximo) ? otro.maximo : maximo;
+        cantidad += otro.cantidad;
+        suma += otro.suma;
+    }
+};
+
+/**
+ * @brief Divide la lista en tramos de hasta LecturasPorTramo nodos consecutivos y los resume en un árbol de segmentos.
+ *
+ * Cada tramo recuerda su primer nodo, su resumen y la menor y mayor marca
+ * de sus lecturas; cada nodo guarda en Nodo::tramo el índice de su tramo.
+ * Los nodos del árbol acumulan además las marcas extremas de su subárbol,
+ * así que resumir [desde, hasta) descarta los subárboles fuera del
+ * intervalo, toma completos los que caen dentro y solo recorre los nodos de
+ * los tramos que cruzan un borde. Con marcas crecientes son dos tramos:
+ * O(log n + LecturasPorTramo) en lugar de O(n). Una lectura que llega tarde
+ * solo ensancha el intervalo de su tramo, que se recorre cuando una
+ * consulta lo corta; el resto del historial sigue resolviéndose por el árbol.
+ *
+ * Anexar al final y borrar un nodo solo marcan su tramo como pendiente; el
+ * árbol se pone al día en la siguiente consulta. Un empalme en medio de la
+ * lista invalida el índice completo, que se rehace en O(n) al consultar.
+ */
+template <typename T, std::size_t LecturasPorTramo = 64>
+class IndiceTemporal
+{
+public:
+    IndiceTemporal()
+        : tramos(nullptr), cantidadTramos(0), capacidadTramos(0), arbol(nullptr), hojas(0), sucios(nullptr),
+          cantidadSucios(0), capacidadSucios(0), desactualizado(false)
+    {
+    }
+
+    IndiceTemporal(const IndiceTemporal&) = delete;
+    IndiceTemporal& operator=(const IndiceTemporal&) = delete;
+
+    ~IndiceTemporal()
+    {
+        delete[] tramos;
+        delete[] arbol;
+        delete[] sucios;
+    }
+
+    /// Registra un nodo recién anexado al final de la lista.
+    void registrarAlta(Nodo<T>* nodo)
+    {
+        if (desactualizado)
+        {
+            return;
+        }
+        if (cantidadTramos == 0 || tramos[cantidadTramos - 1].resumen.cantidad == static_cast<int>(LecturasPorTramo))
+        {
+            agregarTramo(nodo);
+            return;
+        }
+
+        std::uint32_t indice = static_cast<std::uint32_t>(cantidadTramos - 1);
+        Tramo& tramo = tramos[indice];
+        if (tramo.resumen.cantidad == 0)
+        {
+            tramo.primero = nodo;
+        }
+        nodo->tramo = indice;
+        tramo.agregarMarca(nodo->marca);
+        if (tramo.extremosValidos)
+        {
+            tramo.resumen.agregar(nodo->dato);
+        }
+        else
+        {
+            ++tramo.resumen.cantidad;
+            tramo.resumen.suma += static_cast<double>(nodo->dato);
+        }
+        marcarSucio(indice);
+    }
+
+    /**
+     * @brief Registra que un nodo va a salir de la lista.
+     * @param siguiente Nodo que lo sigue en la lista (antes de desenlazarlo).
+     */
+    void registrarBaja(const Nodo<T>* nodo, Nodo<T>* siguiente)
+    {
+        if (desactualizado)
+        {
+            return;
+        }
+
+        Tramo& tramo = tramos[nodo->tramo];
+        --tramo.resumen.cantidad;
+        tramo.resumen.suma -= static_cast<double>(nodo->dato);
+        if (tramo.resumen.cantidad == 0)
+        {
+            tramo.primero = nullptr;
+            tramo.resumen.suma = 0.0;
+            tramo.extremosValidos = true;
+            tramo.marcaMinima = INT64_MAX;
+            tramo.marcaMaxima = INT64_MIN;
+        }
+        else
+        {
+            if (tramo.primero == nodo)
+            {
+                tramo.primero = siguiente;
+            }
+            if (!(tramo.resumen.minimo < nodo->dato) || !(nodo->dato < tramo.resumen.maximo))
+            {
+                tramo.extremosValidos = false;
+            }
+        }
+        marcarSucio(nodo->tramo);
+    }
+
+    /// Indica que la lista cambió de forma que el índice debe rehacerse (empalmes y copias).
+    void invalidar()
+    {
+        desactualizado = true;
+    }
+
+    /// Descarta todos los tramos; la lista quedó vacía.
+    void vaciar()
+    {
+        cantidadTramos = 0;
+        hojas = 0;
+        cantidadSucios = 0;
+        desactualizado = false;
+    }
+
+    /// Intercambia en O(1) el índice con el de otra lista.
+    void intercambiar(IndiceTemporal& otro)
+    {
+        intercambiarValor(tramos, otro.tramos);
+        intercambiarValor(cantidadTramos, otro.cantidadTramos);
+        intercambiarValor(capacidadTramos, otro.capacidadTramos);
+        intercambiarValor(arbol, otro.arbol);
+        intercambiarValor(hojas, otro.hojas);
+        intercambiarValor(sucios, otro.sucios);
+        intercambiarValor(cantidadSucios, otro.cantidadSucios);
+        intercambiarValor(capacidadSucios, otro.capacidadSucios);
+        intercambiarValor(desactualizado, otro.desactualizado);
+    }
+
+    /**
+     * @brief Resume las lecturas con marca en [desde, hasta).
+     * @param cabeza Primer nodo de la lista indexada.
+     */
+    ResumenRango<T> resumir(Nodo<T>* cabeza, std::int64_t desde, std::int64_t hasta)
+    {
+        ResumenRango<T> resumen;
+        if (!(desde < hasta) || !cabeza)
+        {
+            return resumen;
+        }
+
+        actualizar(cabeza);
+        resumirSubarbol(1, desde, hasta, resumen);
+        return resumen;
+    }
+
+    /// Bytes reservados por los tramos, el árbol y la lista de pendientes.
+    std::size_t bytesReservados() const
+    {
+        return capacidadTramos * sizeof(Tramo) + 2 * hojas * sizeof(NodoArbol) +
+               capacidadSucios * sizeof(std::uint32_t);
+    }
+
+private:
+    struct Tramo
+    {
+        /// Primer nodo vivo del tramo; nullptr si se borraron todos.
+        Nodo<T>* primero;
+        /// Cotas de las marcas del tramo; las bajas no las estrechan hasta recalcularExtremos().
+        std::int64_t marcaMinima;
+        std::int64_t marcaMaxima;
+        ResumenRango<T> resumen;
+        /// false si se borró un extremo y hay que recorrer el tramo para recuperarlo.
+        bool extremosValidos;
+        /// true si su hoja del árbol espera actualizarse.
+        bool sucio;
+
+        void agregarMarca(std::int64_t marca)
+        {
+            marcaMinima = (marca < marcaMinima) ? marca : marcaMinima;
+            marcaMaxima = (marcaMaxima < marca) ? marca : marcaMaxima;
+        }
+    };
+
+    /// Resumen de un subárbol junto con las marcas extremas de sus tramos.
+    struct NodoArbol
+    {
+        ResumenRango<T> resumen;
+        std::int64_t marcaMinima = INT64_MAX;
+        std::int64_t marcaMaxima = INT64_MIN;
+
+        void combinar(const NodoArbol& otro)
+        {
+            resumen.combinar(otro.resumen);
+            marcaMinima = (otro.marcaMinima < marcaMinima) ? otro.marcaMinima : marcaMinima;
+            marcaMaxima = (marcaMaxima < otro.marcaMaxima) ? otro.marcaMaxima : marcaMaxima;
+        }
+    };
+
+    Tramo* tramos;
+    std::size_t cantidadTramos;
+    std::size_t capacidadTramos;
+    /// Árbol de segmentos implícito: la hoja del tramo i está en arbol[hojas + i].
+    NodoArbol* arbol;
+    std::size_t hojas;
+    /// Tramos cuyos cambios aún no llegan al árbol.
+    std::uint32_t* sucios;
+    std::size_t cantidadSucios;
+    std::size_t capacidadSucios;
+    bool desactualizado;
+
+    template <typename V>
+    static void intercambiarValor(V& a, V& b)
+    {
+        V temporal = a;
+        a = b;
+        b = temporal;
+    }
+
+    void agregarTramo(Nodo<T>* nodo)
+    {
+        if (cantidadTramos == capacidadTramos)
+        {
+            std::size_t nuevaCapacidad = (capacidadTramos == 0) ? 16 : capacidadTramos * 2;
+            Tramo* nuevos = new Tramo[nuevaCapacidad];
+            for (std::size_t i = 0; i < cantidadTramos; ++i)
+            {
+                nuevos[i] = tramos[i];
+            }
+            delete[] tramos;
+            tramos = nuevos;
+            capacidadTramos = nuevaCapacidad;
+        }
+
+        std::uint32_t indice = static_cast<std::uint32_t>(cantidadTramos++);
+        Tramo& tramo = tramos[indice];
+        tramo.primero = nodo;
+        tramo.marcaMinima = nodo->marca;
+        tramo.marcaMaxima = nodo->marca;
+        tramo.resumen = ResumenRango<T>();
+        tramo.resumen.agregar(nodo->dato);
+        tramo.extremosValidos = true;
+        tramo.sucio = false;
+        nodo->tramo = indice;
+        marcarSucio(indice);
+    }
+
+    void marcarSucio(std::uint32_t indice)
+    {
+        Tramo& tramo = tramos[indice];
+        if (tramo.sucio)
+        {
+            return;
+        }
+        tramo.sucio = true;
+        if (cantidadSucios == capacidadSucios)
+        {
+            std::size_t nuevaCapacidad = (capacidadSucios == 0) ? 16 : capacidadSucios * 2;
+            std::uint32_t* nuevos = new std::uint32_t[nuevaCapacidad];
+            for (std::size_t i = 0; i < cantidadSucios; ++i)
+            {
+                nuevos[i] = sucios[i];
+            }
+            delete[] sucios;
+            sucios = nuevos;
+            capacidadSucios = nuevaCapacidad;
+        }
+        sucios[cantidadSucios++] = indice;
+    }
+
+    /// Rehace tramos y árbol si hace falta y lleva al árbol los tramos pendientes.
+    void actualizar(Nodo<T>* cabeza)
+    {
+        if (desactualizado)
+        {
+            reconstruir(cabeza);
+            return;
+        }
+        if (cantidadTramos > hojas)
+        {
+            reconstruirArbol();
+            return;
+        }
+        for (std::size_t i = 0; i < cantidadSucios; ++i)
+        {
+            Tramo& tramo = tramos[sucios[i]];
+            if (!tramo.extremosValidos)
+            {
+                recalcularExtremos(tramo);
+            }
+            tramo.sucio = false;
+            std::size_t posicion = hojas + sucios[i];
+            arbol[posicion] = hojaDe(tramo);
+            for (posicion /= 2; posicion >= 1; posicion /= 2)
+            {
+                arbol[posicion] = arbol[2 * posicion];
+                arbol[posicion].combinar(arbol[2 * posicion + 1]);
+            }
+        }
+        cantidadSucios = 0;
+    }
+
+    /// Vuelve a partir la lista en tramos completos; O(n).
+    void reconstruir(Nodo<T>* cabeza)
+    {
+        vaciar();
+        for (Nodo<T>* actual = cabeza; actual; actual = actual->siguiente)
+        {
+            registrarAlta(actual);
+        }
+        reconstruirArbol();
+    }
+
+    /// Arma el árbol completo desde los resúmenes de los tramos; O(tramos).
+    void reconstruirArbol()
+    {
+        std::size_t necesarias = 1;
+        while (necesarias < cantidadTramos)
+        {
+            necesarias *= 2;
+        }
+        if (necesarias != hojas)
+        {
+            delete[] arbol;
+            arbol = new NodoArbol[2 * necesarias];
+            hojas = necesarias;
+        }
+
+        for (std::size_t i = 0; i < hojas; ++i)
+        {
+            if (i < cantidadTramos)
+            {
+                Tramo& tramo = tramos[i];
+                if (!tramo.extremosValidos)
+                {
+                    recalcularExtremos(tramo);
+                }
+                tramo.sucio = false;
+                arbol[hojas + i] = hojaDe(tramo);
+            }
+            else
+            {
+                arbol[hojas + i] = NodoArbol();
+            }
+        }
+        for (std::size_t posicion = hojas - 1; posicion >= 1; --posicion)
+        {
+            arbol[posicion] = arbol[2 * posicion];
+            arbol[posicion].combinar(arbol[2 * posicion + 1]);
+        }
+        cantidadSucios = 0;
+    }
+
+    /// Recupera extremos y cotas de marcas exactos recorriendo los nodos vivos del tramo.
+    void recalcularExtremos(Tramo& tramo)
+    {
+        ResumenRango<T> exacto;
+        tramo.marcaMinima = INT64_MAX;
+        tramo.marcaMaxima = INT64_MIN;
+        const Nodo<T>* actual = tramo.primero;
+        for (int i = 0; i < tramo.resumen.cantidad; ++i, actual = actual->siguiente)
+        {
+            exacto.agregar(actual->dato);
+            tramo.agregarMarca(actual->marca);
+        }
+        tramo.resumen = exacto;
+        tramo.extremosValidos = true;
+    }
+
+    static NodoArbol hojaDe(const Tramo& tramo)
+    {
+        NodoArbol hoja;
+        hoja.resumen = tramo.resumen;
+        hoja.marcaMinima = tramo.marcaMinima;
+        hoja.marcaMaxima = tramo.marcaMaxima;
+        return hoja;
+    }
+
+    void recorrerTramo(std::size_t indice, std::int64_t desde, std::int64_t hasta, ResumenRango<T>& resumen) const
+    {
+        const Tramo& tramo = tramos[indice];
+        const Nodo<T>* actual = tramo.primero;
+        for (int i = 0; i < tramo.resumen.cantidad; ++i, actual = actual->siguiente)
+        {
+            if (actual->marca >= desde && actual->marca < hasta)
+            {
+                resumen.agregar(actual->dato);
+            }
+        }
+    }
+
+    /**
+     * @brief Acumula en resumen las lecturas del subárbol con marca en [desde, hasta).
+     *
+     * Un subárbol cuyas marcas caen todas dentro aporta su resumen sin
+     * bajar; uno sin marcas en común se descarta; solo los tramos que cruzan
+     * un borde se recorren nodo a nodo.
+     */
+    void resumirSubarbol(std::size_t posicion, std::int64_t desde, std::int64_t hasta,
+                         ResumenRango<T>& resumen) const
+    {
+        const NodoArbol& nodo = arbol[posicion];
+        if (nodo.resumen.cantidad == 0 || nodo.marcaMaxima < desde || !(nodo.marcaMinima < hasta))
+        {
+            return;
+        }
+        if (!(nodo.marcaMinima < desde) && nodo.marcaMaxima < hasta)
+        {
+            resumen.combinar(nodo.resumen);
+            return;
+        }
+        if (posicion >= hojas)
+        {
+            recorrerTramo(posicion - hojas, desde, hasta, resumen);
+            return;
+        }
+        resumirSubarbol(2 * posicion, desde, hasta, resumen);
+        resumirSubarbol(2 * posicion + 1, desde, hasta, resumen);
+    }
+};
+
+#endif
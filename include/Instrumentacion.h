@@ -0,0 +1,512 @@
+/**
+ * @file Instrumentacion.h
+ * @brief Contadores e histogramas de latencia por etapa del camino de ingesta, acumulados por hilo.
+ */
+#ifndef INSTRUMENTACION_H
+#define INSTRUMENTACION_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include "HistogramaLatencia.h"
+#include "IndiceTemporal.h"
+
+/**
+ * @brief Compila (1) o elimina (0) los puntos de medición del camino de ingesta.
+ *
+ * Se define con -DGESTION_INSTRUMENTACION=n. Con 0, contar() y
+ * CronometroEtapas quedan vacíos y el compilador no genera nada por ellos.
+ */
+#ifndef GESTION_INSTRUMENTACION
+#define GESTION_INSTRUMENTACION 1
+#endif
+
+/// Etapas del camino de una lectura, desde el read() hasta el procesamiento.
+enum class Etapa : int
+{
+    /// read() de un bloque en BufferLineas::leerDesde().
+    Lectura = 0,
+    /// Separar ID y valor de una línea (analizarLineaSerial()).
+    Analisis,
+    /// Buscar el sensor destino por nombre o por (letra, número).
+    Enrutamiento,
+    /// Registrar la lectura en el sensor: inserción en su historial, persistencia y log.
+    Insercion,
+    /// procesarLectura() de un sensor.
+    Procesamiento
+};
+
+/// Número de valores de Etapa.
+constexpr std::size_t CANTIDAD_ETAPAS = 5;
+
+/// Eventos contados en el camino de ingesta.
+enum class Contador : int
+{
+    Bytes = 0,
+    Lineas,
+    LineasMalformadas,
+    SensoresDesconocidos,
+    Tramas,
+    LecturasRegistradas,
+    LecturasRechazadas
+};
+
+/// Número de valores de Contador.
+constexpr std::size_t CANTIDAD_CONTADORES = 7;
+
+/**
+ * @brief Una de cada cuántas líneas o tramas se cronometra en el camino de ingesta.
+ *
+ * Leer el reloj monotónico cuesta decenas de nanosegundos, del orden de
+ * analizar y enrutar una línea completa; cronometrar todas duplicaría el
+ * costo por lectura. Los contadores siempre son exactos. Potencia de dos.
+ */
+constexpr std::uint32_t MUESTREO_INGESTA = 16;
+
+/// Nombre legible de una etapa.
+inline const char* nombreEtapa(std::size_t etapa)
+{
+    static const char* const nombres[CANTIDAD_ETAPAS] = {"lectura", "analisis", "enrutamiento", "insercion",
+                                                         "procesamiento"};
+    return (etapa < CANTIDAD_ETAPAS) ? nombres[etapa] : "?";
+}
+
+/// Nombre legible de un contador.
+inline const char* nombreContador(std::size_t contador)
+{
+    static const char* const nombres[CANTIDAD_CONTADORES] = {"bytes", "lineas", "lineas malformadas",
+                                                             "sensores desconocidos", "tramas",
+                                                             "lecturas registradas", "lecturas rechazadas"};
+    return (contador < CANTIDAD_CONTADORES) ? nombres[contador] : "?";
+}
+
+/**
+ * @brief Contadores y cubetas de latencia de un solo hilo.
+ *
+ * Solo el hilo dueño escribe, así que cada actualización es una carga y un
+ * almacenamiento relajados (un incremento normal en x86, sin lock); otro hilo
+ * puede leer los valores en cualquier momento para armar una instantánea.
+ */
+struct MetricasHilo
+{
+    /// Cubetas de HistogramaLatencia más suma y extremos de una etapa.
+    struct HistogramaEtapa
+    {
+        std::atomic<std::uint64_t> conteos[HistogramaLatencia::CUBETAS];
+        std::atomic<std::uint64_t> suma;
+        std::atomic<std::uint64_t> minimo;
+        std::atomic<std::uint64_t> maximo;
+    };
+
+    std::atomic<std::uint64_t> contadores[CANTIDAD_CONTADORES];
+    HistogramaEtapa etapas[CANTIDAD_ETAPAS];
+    /// Siguiente hilo registrado en Instrumentacion.
+    MetricasHilo* siguiente = nullptr;
+    /// Cronómetros creados con muestreo en este hilo; solo lo usa el hilo dueño.
+    std::uint32_t cronometrosMuestreados = 0;
+
+    MetricasHilo()
+    {
+        for (std::size_t c = 0; c < CANTIDAD_CONTADORES; ++c)
+        {
+            contadores[c].store(0, std::memory_order_relaxed);
+        }
+        for (std::size_t e = 0; e < CANTIDAD_ETAPAS; ++e)
+        {
+            for (std::size_t i = 0; i < HistogramaLatencia::CUBETAS; ++i)
+            {
+                etapas[e].conteos[i].store(0, std::memory_order_relaxed);
+            }
+            etapas[e].suma.store(0, std::memory_order_relaxed);
+            etapas[e].minimo.store(UINT64_MAX, std::memory_order_relaxed);
+            etapas[e].maximo.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /// Suma n al contador (solo desde el hilo dueño).
+    void sumar(Contador contador, std::uint64_t n)
+    {
+        std::atomic<std::uint64_t>& valor = contadores[static_cast<int>(contador)];
+        valor.store(valor.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    /// Cuenta una latencia de la etapa (solo desde el hilo dueño).
+    void registrar(Etapa etapa, std::uint64_t nanosegundos)
+    {
+        HistogramaEtapa& histograma = etapas[static_cast<int>(etapa)];
+        std::atomic<std::uint64_t>& conteo = histograma.conteos[HistogramaLatencia::cubeta(nanosegundos)];
+        conteo.store(conteo.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        histograma.suma.store(histograma.suma.load(std::memory_order_relaxed) + nanosegundos, std::memory_order_relaxed);
+        if (nanosegundos < histograma.minimo.load(std::memory_order_relaxed))
+        {
+            histograma.minimo.store(nanosegundos, std::memory_order_relaxed);
+        }
+        if (nanosegundos > histograma.maximo.load(std::memory_order_relaxed))
+        {
+            histograma.maximo.store(nanosegundos, std::memory_order_relaxed);
+        }
+    }
+};
+
+/**
+ * @brief Contadores e histogramas de todos los hilos sumados en un momento dado.
+ *
+ * Ocupa unos 40 KB; conviene crearla con new.
+ */
+struct InstantaneaInstrumentacion
+{
+    std::uint64_t contadores[CANTIDAD_CONTADORES] = {0};
+    HistogramaLatencia etapas[CANTIDAD_ETAPAS];
+    /// Hilos con métricas vivos al tomar la instantánea.
+    int hilos = 0;
+
+    /// Suma las métricas de un hilo.
+    void agregar(const MetricasHilo& metricas)
+    {
+        for (std::size_t c = 0; c < CANTIDAD_CONTADORES; ++c)
+        {
+            contadores[c] += metricas.contadores[c].load(std::memory_order_relaxed);
+        }
+        std::uint64_t conteos[HistogramaLatencia::CUBETAS];
+        for (std::size_t e = 0; e < CANTIDAD_ETAPAS; ++e)
+        {
+            const MetricasHilo::HistogramaEtapa& origen = metricas.etapas[e];
+            for (std::size_t i = 0; i < HistogramaLatencia::CUBETAS; ++i)
+            {
+                conteos[i] = origen.conteos[i].load(std::memory_order_relaxed);
+            }
+            etapas[e].combinar(conteos, origen.suma.load(std::memory_order_relaxed),
+                               origen.minimo.load(std::memory_order_relaxed),
+                               origen.maximo.load(std::memory_order_relaxed));
+        }
+    }
+};
+
+/**
+ * @brief Registro global de las métricas por hilo, con reporte y volcado periódico a archivo.
+ *
+ * Cada hilo que mide algo recibe su propio MetricasHilo la primera vez
+ * (metricasDelHilo()) y lo escribe sin sincronizarse con nadie. El mutex
+ * solo se toma al registrar o retirar un hilo y al armar una instantánea;
+ * las métricas de un hilo que termina se suman a las de los retirados para
+ * que no se pierdan.
+ */
+class Instrumentacion
+{
+public:
+    /// Instancia única.
+    static Instrumentacion& instancia()
+    {
+        static Instrumentacion instrumentacion;
+        return instrumentacion;
+    }
+
+    /// Indica si los puntos de medición están compilados en este binario.
+    static constexpr bool compilada()
+    {
+        return GESTION_INSTRUMENTACION != 0;
+    }
+
+    Instrumentacion(const Instrumentacion&) = delete;
+    Instrumentacion& operator=(const Instrumentacion&) = delete;
+
+    ~Instrumentacion()
+    {
+        detenerVolcado();
+    }
+
+    /// Incorpora las métricas de un hilo nuevo.
+    void registrarHilo(MetricasHilo* metricas)
+    {
+        std::lock_guard<std::mutex> guardia(mutex);
+        metricas->siguiente = activas;
+        activas = metricas;
+    }
+
+    /// Suma las métricas de un hilo que termina a las de los retirados y las libera.
+    void retirarHilo(MetricasHilo* metricas)
+    {
+        std::lock_guard<std::mutex> guardia(mutex);
+        MetricasHilo** enlace = &activas;
+        while (*enlace && *enlace != metricas)
+        {
+            enlace = &(*enlace)->siguiente;
+        }
+        if (*enlace)
+        {
+            *enlace = metricas->siguiente;
+        }
+        retiradas.agregar(*metricas);
+        delete metricas;
+    }
+
+    /// Suma las métricas de todos los hilos, vivos y retirados.
+    void capturar(InstantaneaInstrumentacion& destino) const
+    {
+        std::lock_guard<std::mutex> guardia(mutex);
+        destino = retiradas;
+        destino.hilos = 0;
+        for (const MetricasHilo* actual = activas; actual; actual = actual->siguiente)
+        {
+            destino.agregar(*actual);
+            ++destino.hilos;
+        }
+    }
+
+    /// Escribe contadores y percentiles por etapa en el flujo indicado.
+    void imprimir(std::FILE* destino) const
+    {
+        if (!compilada())
+        {
+            std::fprintf(destino, "Instrumentación deshabilitada al compilar (GESTION_INSTRUMENTACION=0).\n");
+            return;
+        }
+
+        InstantaneaInstrumentacion* instantanea = new InstantaneaInstrumentacion();
+        capturar(*instantanea);
+        std::fprintf(destino, "--- Instrumentación del camino de ingesta (%d hilo%s activo%s) ---\n",
+                     instantanea->hilos, (instantanea->hilos == 1) ? "" : "s", (instantanea->hilos == 1) ? "" : "s");
+        for (std::size_t c = 0; c < CANTIDAD_CONTADORES; ++c)
+        {
+            std::fprintf(destino, "%-22s %14llu\n", nombreContador(c),
+                         static_cast<unsigned long long>(instantanea->contadores[c]));
+        }
+        std::fprintf(destino, "%-14s %12s %10s %10s %10s %10s %12s %10s\n", "etapa (ns)", "muestras", "p50", "p90",
+                     "p99", "p99.9", "max", "prom");
+        for (std::size_t e = 0; e < CANTIDAD_ETAPAS; ++e)
+        {
+            const HistogramaLatencia& histograma = instantanea->etapas[e];
+            std::fprintf(destino, "%-14s %12llu %10llu %10llu %10llu %10llu %12llu %10.0f\n", nombreEtapa(e),
+                         static_cast<unsigned long long>(histograma.obtenerCantidad()),
+                         static_cast<unsigned long long>(histograma.percentil(50.0)),
+                         static_cast<unsigned long long>(histograma.percentil(90.0)),
+                         static_cast<unsigned long long>(histograma.percentil(99.0)),
+                         static_cast<unsigned long long>(histograma.percentil(99.9)),
+                         static_cast<unsigned long long>(histograma.obtenerMaximo()), histograma.promedio());
+        }
+        delete instantanea;
+    }
+
+    /**
+     * @brief Anexa el reporte al archivo cada cierto número de segundos, en un hilo propio.
+     * @return false si el archivo no puede abrirse o el hilo no pudo crearse.
+     *
+     * Reemplaza cualquier volcado anterior.
+     */
+    bool iniciarVolcado(const char* ruta, int segundos)
+    {
+        detenerVolcado();
+        std::FILE* prueba = std::fopen(ruta, "a");
+        if (!prueba || segundos <= 0)
+        {
+            if (prueba)
+            {
+                std::fclose(prueba);
+            }
+            return false;
+        }
+        std::fclose(prueba);
+
+        std::snprintf(rutaVolcado, sizeof(rutaVolcado), "%s", ruta);
+        intervaloVolcado = segundos;
+        detenerVolcador = false;
+        try
+        {
+            volcador = std::thread(&Instrumentacion::ejecutarVolcado, this);
+        }
+        catch (const std::system_error&)
+        {
+            return false;
+        }
+        return true;
+    }
+
+    /// Detiene el volcado periódico tras escribir un último reporte.
+    void detenerVolcado()
+    {
+        if (!volcador.joinable())
+        {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> guardia(mutexVolcado);
+            detenerVolcador = true;
+        }
+        despertarVolcador.notify_one();
+        volcador.join();
+    }
+
+    /// Indica si hay un volcado periódico en curso.
+    bool volcadoActivo() const
+    {
+        return volcador.joinable();
+    }
+
+    /// Ruta del volcado periódico vigente.
+    const char* obtenerRutaVolcado() const
+    {
+        return rutaVolcado;
+    }
+
+private:
+    mutable std::mutex mutex;
+    MetricasHilo* activas;
+    /// Suma de los hilos que ya terminaron.
+    InstantaneaInstrumentacion retiradas;
+
+    std::mutex mutexVolcado;
+    std::condition_variable despertarVolcador;
+    std::thread volcador;
+    bool detenerVolcador;
+    int intervaloVolcado;
+    char rutaVolcado[256];
+
+    Instrumentacion() : activas(nullptr), detenerVolcador(false), intervaloVolcado(0)
+    {
+        rutaVolcado[0] = '\0';
+    }
+
+    /// Cuerpo del hilo de volcado.
+    void ejecutarVolcado()
+    {
+        std::unique_lock<std::mutex> candado(mutexVolcado);
+        bool ultimo = false;
+        while (!ultimo)
+        {
+            ultimo = despertarVolcador.wait_for(candado, std::chrono::seconds(intervaloVolcado),
+                                                [this] { return detenerVolcador; });
+            volcar();
+        }
+    }
+
+    /// Anexa un reporte con la hora UTC al archivo de volcado.
+    void volcar() const
+    {
+        std::FILE* archivo = std::fopen(rutaVolcado, "a");
+        if (!archivo)
+        {
+            return;
+        }
+        char fecha[32];
+        std::time_t ahora = std::time(nullptr);
+        std::strftime(fecha, sizeof(fecha), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&ahora));
+        std::fprintf(archivo, "\n[%s]\n", fecha);
+        imprimir(archivo);
+        std::fclose(archivo);
+    }
+};
+
+/**
+ * @brief Dueño de las métricas del hilo actual: las registra al crearse y las retira cuando el hilo termina.
+ */
+struct TitularMetricas
+{
+    MetricasHilo* metricas;
+
+    TitularMetricas() : metricas(new MetricasHilo())
+    {
+        Instrumentacion::instancia().registrarHilo(metricas);
+    }
+
+    ~TitularMetricas()
+    {
+        Instrumentacion::instancia().retirarHilo(metricas);
+    }
+
+    TitularMetricas(const TitularMetricas&) = delete;
+    TitularMetricas& operator=(const TitularMetricas&) = delete;
+};
+
+/// Métricas del hilo que llama; se crean en su primer uso.
+inline MetricasHilo& metricasDelHilo()
+{
+    thread_local TitularMetricas titular;
+    return *titular.metricas;
+}
+
+#if GESTION_INSTRUMENTACION
+
+/// Suma n al contador del hilo actual.
+inline void contar(Contador contador, std::uint64_t n = 1)
+{
+    metricasDelHilo().sumar(contador, n);
+}
+
+/**
+ * @brief Mide etapas consecutivas con una sola lectura del reloj por etapa.
+ *
+ * Cada marcar() atribuye a la etapa el tiempo transcurrido desde el marcar()
+ * anterior (o desde la construcción o reanudar()), así que medir tres etapas
+ * seguidas cuesta cuatro lecturas del reloj y no seis.
+ */
+class CronometroEtapas
+{
+public:
+    /**
+     * @param periodo Cronometra solo uno de cada periodo cronómetros creados en el hilo (potencia de dos);
+     *                con 1 cronometra siempre. Los contadores se suman siempre.
+     */
+    explicit CronometroEtapas(std::uint32_t periodo = 1)
+        : metricas(metricasDelHilo()),
+          activo((metricas.cronometrosMuestreados++ & (periodo - 1)) == 0),
+          anterior(activo ? marcaMonotonica() : 0)
+    {
+    }
+
+    /// Atribuye a la etapa el tiempo desde la marca anterior.
+    void marcar(Etapa etapa)
+    {
+        if (!activo)
+        {
+            return;
+        }
+        std::int64_t ahora = marcaMonotonica();
+        metricas.registrar(etapa, static_cast<std::uint64_t>(ahora - anterior));
+        anterior = ahora;
+    }
+
+    /// Descarta el tiempo transcurrido desde la marca anterior (trabajo que no es de ninguna etapa).
+    void reanudar()
+    {
+        if (activo)
+        {
+            anterior = marcaMonotonica();
+        }
+    }
+
+    /// Suma n al contador del hilo sin volver a buscar sus métricas.
+    void contar(Contador contador, std::uint64_t n = 1)
+    {
+        metricas.sumar(contador, n);
+    }
+
+private:
+    MetricasHilo& metricas;
+    bool activo;
+    std::int64_t anterior;
+};
+
+#else
+
+inline void contar(Contador, std::uint64_t = 1) {}
+
+class CronometroEtapas
+{
+public:
+    explicit CronometroEtapas(std::uint32_t = 1) {}
+    void marcar(Etapa) {}
+    void reanudar() {}
+    void contar(Contador, std::uint64_t = 1) {}
+};
+
+#endif
+
+#endif
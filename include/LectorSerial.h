@@ -0,0 +1,602 @@
+/**
+ * @file LectorSerial.h
+ * @brief Lectura por bloques de un puerto serial y separación de líneas ID,valor.
+ */
+#ifndef LECTORSERIAL_H
+#define LECTORSERIAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#ifdef __linux__
+#include <linux/serial.h>
+#endif
+#include "AuxiliarCli.h"
+#include "ListaGeneral.h"
+#include "SensorBase.h"
+#include "AnalizadorLineas.h"
+#include "Instrumentacion.h"
+#include "ProtocoloBinario.h"
+
+/// Longitud máxima permitida para el identificador de un sensor.
+constexpr std::size_t TAM_ID = 50;
+/// Tamaño del buffer usado para leer líneas desde la consola.
+constexpr std::size_t TAM_SERIAL = 128;
+
+/// Clase de elemento que entrega BufferLineas::siguienteElemento().
+enum class ElementoEntrada
+{
+    /// No hay un elemento completo; hay que leer más bytes.
+    Ninguno,
+    /// Línea de texto ID,valor.
+    Linea,
+    /// Trama binaria ya validada.
+    Trama
+};
+
+/**
+ * @brief Acumula bytes leídos en bloque y entrega líneas completas sin copiarlas.
+ *
+ * Cada llamada a leerDesde() pide al sistema todo el espacio libre del buffer
+ * (varios kilobytes) en un solo read(). siguienteLinea() termina cada línea
+ * en su lugar sustituyendo el salto por '\0'; el fragmento incompleto que
+ * queda al final se desplaza al inicio antes de la siguiente lectura.
+ *
+ * siguienteElemento() además reconoce tramas de ProtocoloBinario.h
+ * intercaladas con el texto: un byte de sincronía al inicio de un elemento
+ * abre una trama, y si aparece a mitad de una línea esa línea se descarta.
+ */
+class BufferLineas
+{
+public:
+    /// Capacidad total del buffer en bytes.
+    static constexpr std::size_t CAPACIDAD = 16384;
+
+    BufferLineas() : inicio(0), fin(0), descartando(false), lineasDescartadas(0), tramasInvalidas(0) {}
+
+    /**
+     * @brief Lee en un solo read() todo lo que quepa en el espacio libre.
+     * @param fd Descriptor abierto en modo lectura.
+     * @return Bytes leídos, 0 en fin de archivo o -1 con errno establecido.
+     */
+    ssize_t leerDesde(int fd)
+    {
+        prepararEspacio();
+        CronometroEtapas etapas;
+        ssize_t cantidad = read(fd, datos + fin, CAPACIDAD - fin);
+        etapas.marcar(Etapa::Lectura);
+        if (cantidad > 0)
+        {
+            fin += static_cast<std::size_t>(cantidad);
+            etapas.contar(Contador::Bytes, static_cast<std::uint64_t>(cantidad));
+        }
+        return cantidad;
+    }
+
+    /**
+     * @brief Copia bytes ya recibidos por otra vía (útil al reproducir capturas).
+     * @return Número de bytes aceptados; puede ser menor si no hay espacio.
+     */
+    std::size_t alimentar(const char* origen, std::size_t cantidad)
+    {
+        prepararEspacio();
+        std::size_t libres = CAPACIDAD - fin;
+        if (cantidad > libres)
+        {
+            cantidad = libres;
+        }
+        std::memcpy(datos + fin, origen, cantidad);
+        fin += cantidad;
+        return cantidad;
+    }
+
+    /**
+     * @brief Devuelve la siguiente línea completa dentro del propio buffer.
+     * @param longitud Recibe el número de caracteres sin contar '\r', '\n' ni '\0'.
+     * @return Apuntador a la línea terminada en nulo o nullptr si no hay línea completa.
+     *
+     * El apuntador es válido hasta la siguiente llamada a leerDesde() o alimentar().
+     * Las líneas vacías se omiten.
+     */
+    char* siguienteLinea(std::size_t& longitud)
+    {
+        while (inicio < fin)
+        {
+            char* principio = datos + inicio;
+            char* salto = static_cast<char*>(std::memchr(principio, '\n', fin - inicio));
+            if (!salto)
+            {
+                if (descartando)
+                {
+                    inicio = fin;
+                }
+                return nullptr;
+            }
+
+            inicio = static_cast<std::size_t>(salto - datos) + 1;
+            if (descartando)
+            {
+                descartando = false;
+                continue;
+            }
+
+            if (cortarLinea(principio, salto, longitud))
+            {
+                return principio;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Devuelve el siguiente elemento completo: una línea de texto o una trama binaria.
+     * @param linea Recibe la línea (terminada en nulo, dentro del buffer) si el resultado es Linea.
+     * @param longitud Recibe la longitud de la línea.
+     * @param trama Recibe las lecturas decodificadas si el resultado es Trama.
+     *
+     * Las tramas con CRC o formato inválido se saltan un byte a la vez hasta
+     * encontrar la siguiente sincronía o texto; se cuentan en
+     * obtenerTramasInvalidas().
+     */
+    ElementoEntrada siguienteElemento(char*& linea, std::size_t& longitud, TramaBinaria& trama)
+    {
+        while (inicio < fin)
+        {
+            char* principio = datos + inicio;
+            if (!descartando && static_cast<unsigned char>(*principio) == SINCRONIA_TRAMA)
+            {
+                std::size_t consumidos = 0;
+                ResultadoTrama resultado = decodificarTrama(reinterpret_cast<const unsigned char*>(principio),
+                                                            fin - inicio, trama, consumidos);
+                if (resultado == ResultadoTrama::Incompleta)
+                {
+                    return ElementoEntrada::Ninguno;
+                }
+                if (resultado == ResultadoTrama::Completa)
+                {
+                    inicio += consumidos;
+                    return ElementoEntrada::Trama;
+                }
+                ++tramasInvalidas;
+                ++inicio;
+                continue;
+            }
+
+            char* salto = static_cast<char*>(std::memchr(principio, '\n', fin - inicio));
+            std::size_t alcance = salto ? static_cast<std::size_t>(salto - principio) : fin - inicio;
+            char* sincronia = static_cast<char*>(std::memchr(principio, SINCRONIA_TRAMA, alcance));
+            if (sincronia)
+            {
+                inicio = static_cast<std::size_t>(sincronia - datos);
+                descartando = false;
+                continue;
+            }
+            if (!salto)
+            {
+                if (descartando)
+                {
+                    inicio = fin;
+                }
+                return ElementoEntrada::Ninguno;
+            }
+
+            inicio = static_cast<std::size_t>(salto - datos) + 1;
+            if (descartando)
+            {
+                descartando = false;
+                continue;
+            }
+
+            if (cortarLinea(principio, salto, longitud))
+            {
+                linea = principio;
+                return ElementoEntrada::Linea;
+            }
+        }
+        return ElementoEntrada::Ninguno;
+    }
+
+    /// Número de líneas descartadas por exceder la capacidad del buffer.
+    std::size_t obtenerLineasDescartadas() const
+    {
+        return lineasDescartadas;
+    }
+
+    /// Número de sincronías que no abrieron una trama válida.
+    std::size_t obtenerTramasInvalidas() const
+    {
+        return tramasInvalidas;
+    }
+
+private:
+    char datos[CAPACIDAD];
+    std::size_t inicio;
+    std::size_t fin;
+    bool descartando;
+    std::size_t lineasDescartadas;
+    std::size_t tramasInvalidas;
+
+    /// Termina la línea en su lugar quitando '\r' finales; false si queda vacía.
+    static bool cortarLinea(char* principio, char* salto, std::size_t& longitud)
+    {
+        char* final = salto;
+        while (final > principio && final[-1] == '\r')
+        {
+            --final;
+        }
+        *final = '\0';
+        longitud = static_cast<std::size_t>(final - principio);
+        return longitud > 0;
+    }
+
+    /// Mueve el fragmento pendiente al inicio; si ocupa todo el buffer, lo descarta.
+    void prepararEspacio()
+    {
+        if (inicio > 0)
+        {
+            std::memmove(datos, datos + inicio, fin - inicio);
+            fin -= inicio;
+            inicio = 0;
+        }
+
+        if (fin == CAPACIDAD)
+        {
+            fin = 0;
+            if (!descartando)
+            {
+                descartando = true;
+                ++lineasDescartadas;
+            }
+        }
+    }
+};
+
+/**
+ * @brief Elimina espacios iniciales y finales de una cadena in situ.
+ */
+inline void recortarEspacios(char* texto)
+{
+    if (!texto)
+    {
+        return;
+    }
+
+    std::size_t inicio = 0;
+    while (texto[inicio] == ' ' || texto[inicio] == '\t')
+    {
+        ++inicio;
+    }
+
+    if (inicio > 0)
+    {
+        std::size_t i = 0;
+        while (texto[inicio + i] != '\0')
+        {
+            texto[i] = texto[inicio + i];
+            ++i;
+        }
+        texto[i] = '\0';
+    }
+
+    int fin = static_cast<int>(std::strlen(texto)) - 1;
+    while (fin >= 0 && (texto[fin] == ' ' || texto[fin] == '\t'))
+    {
+        texto[fin] = '\0';
+        --fin;
+    }
+}
+
+/**
+ * @brief Separa una línea con formato ID,valor copiándola en dos buffers.
+ *
+ * La ruta de ingesta usa analizarLineaSerial(), que no copia; esta variante
+ * se conserva para quien necesite los campos como cadenas independientes.
+ */
+inline bool descomponerLineaSerial(const char* linea, char* id, std::size_t tamId, char* valor, std::size_t tamValor)
+{
+    if (!linea || !id || !valor)
+    {
+        return false;
+    }
+
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (linea[i] != '\0' && linea[i] != ',' && j < tamId - 1)
+    {
+        id[j++] = linea[i++];
+    }
+    id[j] = '\0';
+
+    if (linea[i] != ',')
+    {
+        return false;
+    }
+    ++i;
+
+    std::size_t k = 0;
+    while (linea[i] != '\0' && k < tamValor - 1)
+    {
+        valor[k++] = linea[i++];
+    }
+    valor[k] = '\0';
+
+    recortarEspacios(id);
+    recortarEspacios(valor);
+
+    return (id[0] != '\0' && valor[0] != '\0');
+}
+
+/**
+ * @brief Interpreta una línea ID,valor recibida por serial y la entrega al sensor destino.
+ * @param lista Lista donde se busca el sensor.
+ * @param linea Inicio de la línea dentro del buffer de recepción.
+ * @param longitud Número de caracteres de la línea.
+ * @param cli Auxiliar para reportar líneas descartadas.
+ * @return true si la lectura se registró en algún sensor.
+ *
+ * No copia la línea: el identificador y el valor se consultan como vistas
+ * dentro del propio buffer.
+ */
+inline bool enrutarLineaSerial(ListaGeneral& lista, const char* linea, std::size_t longitud, AuxiliarCli& cli)
+{
+    CronometroEtapas etapas(MUESTREO_INGESTA);
+    etapas.contar(Contador::Lineas);
+    LineaSerial campos;
+    bool valida = analizarLineaSerial(linea, longitud, campos);
+    etapas.marcar(Etapa::Analisis);
+    if (!valida)
+    {
+        etapas.contar(Contador::LineasMalformadas);
+        cli.imprimirLog(NivelLog::Advertencia, "Lectura serial ignorada: formato incorrecto.");
+        return false;
+    }
+
+    SensorBase* sensor = lista.buscarPorNombre(campos.id.data(), campos.id.size());
+    etapas.marcar(Etapa::Enrutamiento);
+    if (!sensor)
+    {
+        etapas.contar(Contador::SensoresDesconocidos);
+        char mensaje[160];
+        std::snprintf(mensaje, sizeof(mensaje), "Sensor '%.*s' no se encuentra en la lista.",
+                      static_cast<int>(campos.id.size() < TAM_ID ? campos.id.size() : TAM_ID), campos.id.data());
+        cli.imprimirLog(NivelLog::Advertencia, mensaje);
+        return false;
+    }
+
+    bool registrada = sensor->registrarLecturaDesdeTexto(campos.valor);
+    etapas.marcar(Etapa::Insercion);
+    etapas.contar(registrada ? Contador::LecturasRegistradas : Contador::LecturasRechazadas);
+    return registrada;
+}
+
+/**
+ * @brief Entrega las lecturas de una trama binaria a sus sensores.
+ * @param lista Lista donde se buscan los sensores por (tipo, id).
+ * @param trama Trama ya validada por decodificarTrama().
+ * @param cli Auxiliar para reportar sensores desconocidos.
+ * @return Número de lecturas registradas.
+ *
+ * Todas las lecturas de la trama reciben la misma marca de tiempo: la del
+ * momento en que se enrutó. Las lecturas seguidas de un mismo sensor se
+ * registran juntas con SensorBase::registrarLoteNumericoEn().
+ */
+inline int enrutarTramaBinaria(ListaGeneral& lista, const TramaBinaria& trama, AuxiliarCli& cli)
+{
+    std::int64_t marca = marcaMonotonica();
+    CronometroEtapas etapas(MUESTREO_INGESTA);
+    etapas.contar(Contador::Tramas);
+    double valores[MAX_LECTURAS_TRAMA];
+    std::int64_t marcas[MAX_LECTURAS_TRAMA];
+    int registradas = 0;
+    std::size_t inicio = 0;
+    while (inicio < trama.cantidad)
+    {
+        // Las lecturas seguidas del mismo sensor se buscan una vez y se registran como un lote.
+        const LecturaBinaria& primera = trama.lecturas[inicio];
+        std::size_t enTramo = 0;
+        while (inicio + enTramo < trama.cantidad && trama.lecturas[inicio + enTramo].tipo == primera.tipo &&
+               trama.lecturas[inicio + enTramo].id == primera.id)
+        {
+            valores[enTramo] = trama.lecturas[inicio + enTramo].valor;
+            marcas[enTramo] = marca;
+            ++enTramo;
+        }
+        inicio += enTramo;
+
+        SensorBase* sensor = lista.buscarPorId(primera.tipo, primera.id);
+        etapas.marcar(Etapa::Enrutamiento);
+        if (!sensor)
+        {
+            etapas.contar(Contador::SensoresDesconocidos, enTramo);
+            cli.imprimirLogFormato<NivelLog::Advertencia>("Sensor '%c-%03u' no se encuentra en la lista.", primera.tipo,
+                                                          static_cast<unsigned>(primera.id));
+            etapas.reanudar();
+            continue;
+        }
+        std::size_t registradasTramo = sensor->registrarLoteNumericoEn(valores, marcas, enTramo);
+        etapas.marcar(Etapa::Insercion);
+        etapas.contar(Contador::LecturasRegistradas, registradasTramo);
+        etapas.contar(Contador::LecturasRechazadas, enTramo - registradasTramo);
+        registradas += static_cast<int>(registradasTramo);
+    }
+    return registradas;
+}
+
+/**
+ * @brief Parámetros de un puerto serial seleccionables por dispositivo.
+ */
+struct ConfiguracionPuerto
+{
+    /// Mayor valor de vmin y vtime: c_cc guarda cada uno en un solo byte.
+    static constexpr int MAX_VMIN_VTIME = 255;
+
+    /// Velocidad en baudios; debe ser una de las tasas estándar de termios.
+    int baudios = 9600;
+    /// Bytes mínimos que debe entregar un read() bloqueante (c_cc[VMIN]).
+    int vmin = 0;
+    /// Espera máxima de un read() bloqueante en décimas de segundo (c_cc[VTIME]).
+    int vtime = 10;
+    /// Solicita al controlador el modo ASYNC_LOW_LATENCY cuando lo soporta.
+    bool bajaLatencia = false;
+};
+
+/**
+ * @brief Traduce una velocidad numérica a la constante speed_t de termios.
+ * @return false si la plataforma no define esa velocidad.
+ */
+inline bool velocidadTermios(int baudios, speed_t& velocidad)
+{
+    struct Equivalencia
+    {
+        int baudios;
+        speed_t constante;
+    };
+
+    static const Equivalencia tabla[] = {
+        {1200, B1200}, {2400, B2400}, {4800, B4800}, {9600, B9600}, {19200, B19200},
+        {38400, B38400}, {57600, B57600}, {115200, B115200}, {230400, B230400},
+#ifdef B460800
+        {460800, B460800},
+#endif
+#ifdef B500000
+        {500000, B500000},
+#endif
+#ifdef B576000
+        {576000, B576000},
+#endif
+#ifdef B921600
+        {921600, B921600},
+#endif
+#ifdef B1000000
+        {1000000, B1000000},
+#endif
+#ifdef B1152000
+        {1152000, B1152000},
+#endif
+#ifdef B1500000
+        {1500000, B1500000},
+#endif
+#ifdef B2000000
+        {2000000, B2000000},
+#endif
+#ifdef B2500000
+        {2500000, B2500000},
+#endif
+#ifdef B3000000
+        {3000000, B3000000},
+#endif
+#ifdef B3500000
+        {3500000, B3500000},
+#endif
+#ifdef B4000000
+        {4000000, B4000000},
+#endif
+    };
+
+    for (const Equivalencia& entrada : tabla)
+    {
+        if (entrada.baudios == baudios)
+        {
+            velocidad = entrada.constante;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Activa o desactiva ASYNC_LOW_LATENCY en el controlador del puerto.
+ * @return false si el dispositivo no admite la opción (por ejemplo, un pty).
+ */
+inline bool aplicarBajaLatencia(int fd, bool activar)
+{
+#if defined(__linux__) && defined(ASYNC_LOW_LATENCY)
+    struct serial_struct serie;
+    if (ioctl(fd, TIOCGSERIAL, &serie) != 0)
+    {
+        return false;
+    }
+    if (activar)
+    {
+        serie.flags |= ASYNC_LOW_LATENCY;
+    }
+    else
+    {
+        serie.flags &= ~ASYNC_LOW_LATENCY;
+    }
+    return ioctl(fd, TIOCSSERIAL, &serie) == 0;
+#else
+    (void)fd;
+    (void)activar;
+    return false;
+#endif
+}
+
+/**
+ * @brief Configura un puerto serial abierto en modo crudo 8N1 con los parámetros indicados.
+ * @param fd Descriptor del puerto.
+ * @param cli Auxiliar para reportar problemas.
+ * @param configuracion Velocidad, VMIN/VTIME y baja latencia; por omisión 9600 baudios.
+ */
+inline bool configurarPuertoSerial(int fd, AuxiliarCli& cli, const ConfiguracionPuerto& configuracion = ConfiguracionPuerto())
+{
+    speed_t velocidad;
+    if (!velocidadTermios(configuracion.baudios, velocidad))
+    {
+        char mensaje[120];
+        std::snprintf(mensaje, sizeof(mensaje), "Velocidad de %d baudios no soportada por termios.", configuracion.baudios);
+        cli.imprimirLog(NivelLog::Advertencia, mensaje);
+        return false;
+    }
+
+    if (configuracion.vmin < 0 || configuracion.vmin > ConfiguracionPuerto::MAX_VMIN_VTIME ||
+        configuracion.vtime < 0 || configuracion.vtime > ConfiguracionPuerto::MAX_VMIN_VTIME)
+    {
+        cli.imprimirLogFormato<NivelLog::Advertencia>("VMIN (%d) y VTIME (%d) deben estar entre 0 y %d.",
+                                                      configuracion.vmin, configuracion.vtime,
+                                                      ConfiguracionPuerto::MAX_VMIN_VTIME);
+        return false;
+    }
+
+    struct termios opciones;
+    if (tcgetattr(fd, &opciones) != 0)
+    {
+        cli.imprimirLog(NivelLog::Advertencia, "No se pudo obtener la configuración del puerto serial.");
+        return false;
+    }
+
+    // Solo se tocan tamaño, paridad, bits de parada y control de flujo: asignar c_cflag entero borraría los bits de velocidad.
+    opciones.c_cflag &= ~static_cast<tcflag_t>(CSIZE | PARENB | CSTOPB | CRTSCTS);
+    opciones.c_cflag |= CS8 | CLOCAL | CREAD;
+    if (cfsetispeed(&opciones, velocidad) != 0 || cfsetospeed(&opciones, velocidad) != 0)
+    {
+        cli.imprimirLogFormato<NivelLog::Advertencia>("No se pudo fijar la velocidad de %d baudios.", configuracion.baudios);
+        return false;
+    }
+    opciones.c_iflag = IGNPAR;
+    opciones.c_oflag = 0;
+    opciones.c_lflag = 0;
+    opciones.c_cc[VMIN] = static_cast<cc_t>(configuracion.vmin);
+    opciones.c_cc[VTIME] = static_cast<cc_t>(configuracion.vtime);
+
+    if (tcsetattr(fd, TCSANOW, &opciones) != 0)
+    {
+        cli.imprimirLog(NivelLog::Advertencia, "No se pudo establecer la configuración del puerto serial.");
+        return false;
+    }
+
+    if (configuracion.bajaLatencia && !aplicarBajaLatencia(fd, true))
+    {
+        cli.imprimirLog(NivelLog::Advertencia, "El dispositivo no admite el modo de baja latencia; se continúa sin él.");
+    }
+
+    tcflush(fd, TCIOFLUSH);
+    return true;
+}
+
+#endif
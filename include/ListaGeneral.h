@@ -5,6 +5,10 @@
 #include <cstdio>
 #include "SensorBase.h"
 #include "AuxiliarCli.h"
+#include "IndiceNombres.h"
+#include "IndiceNumerico.h"
+#include "Instrumentacion.h"
+#include "PoolTrabajo.h"
 
 /**
  * @file ListaGeneral.h
@@ -12,11 +16,40 @@
  */
 /**
  * @brief Administra la colección polimórfica de sensores.
+ *
+ * La lista enlazada conserva el orden de registro para procesar y mostrar;
+ * un IndiceNombres paralelo resuelve las búsquedas por nombre en O(1) esperado
+ * y un IndiceNumerico, las de las tramas binarias por (letra, número).
  */
 class ListaGeneral
 {
 public:
-    ListaGeneral() : cabeza(nullptr) {}
+    ListaGeneral() : cabeza(nullptr), cola(nullptr) {}
+
+    /// Toma los sensores de otra lista sin copiarlos; la otra queda vacía.
+    ListaGeneral(ListaGeneral&& otra) : cabeza(otra.cabeza), cola(otra.cola)
+    {
+        indice.intercambiar(otra.indice);
+        numericos.intercambiar(otra.numericos);
+        otra.cabeza = nullptr;
+        otra.cola = nullptr;
+    }
+
+    /// Libera los sensores propios y toma los de otra lista sin copiarlos.
+    ListaGeneral& operator=(ListaGeneral&& otra)
+    {
+        if (this != &otra)
+        {
+            liberar();
+            cabeza = otra.cabeza;
+            cola = otra.cola;
+            indice.intercambiar(otra.indice);
+            numericos.intercambiar(otra.numericos);
+            otra.cabeza = nullptr;
+            otra.cola = nullptr;
+        }
+        return *this;
+    }
 
     ~ListaGeneral()
     {
@@ -33,61 +66,119 @@ public:
         AuxiliarCli cli;
         if (!sensor)
         {
-            cli.imprimirLog("WARNING", "Intento de insertar un sensor nulo.");
+            cli.imprimirLog(NivelLog::Advertencia, "Intento de insertar un sensor nulo.");
             return false;
         }
 
-        if (buscarPorNombre(sensor->obtenerNombre()))
+        if (!indice.insertar(sensor))
         {
             char mensaje[160];
             std::snprintf(mensaje, sizeof(mensaje), "Sensor '%s' ya existe en la lista.", sensor->obtenerNombre());
-            cli.imprimirLog("WARNING", mensaje);
+            cli.imprimirLog(NivelLog::Advertencia, mensaje);
             return false;
         }
 
+        numericos.insertar(sensor);
+
         NodoGeneral* nuevo = new NodoGeneral(sensor);
-        if (!cabeza)
+        if (!cola)
         {
             cabeza = nuevo;
         }
         else
         {
-            NodoGeneral* actual = cabeza;
-            while (actual->siguiente)
-            {
-                actual = actual->siguiente;
-            }
-            actual->siguiente = nuevo;
+            cola->siguiente = nuevo;
         }
+        cola = nuevo;
 
         char mensaje[160];
         std::snprintf(mensaje, sizeof(mensaje), "Sensor '%s' insertado en la lista de gestión.", sensor->obtenerNombre());
-        cli.imprimirLog("SUCCESS", mensaje);
+        cli.imprimirLog(NivelLog::Exito, mensaje);
         return true;
     }
 
     /**
-     * @brief Busca un sensor por identificador.
-     * @param id Cadena con el nombre del sensor.
-     * @return Puntero al sensor o nullptr si no existe.
+     * @brief Pasa todos los sensores de otra lista al final de esta; la otra queda vacía.
+     * @param otra Lista origen.
+     * @return false (sin cambios en ninguna lista) si algún nombre ya existe aquí.
+     *
+     * La cadena de nodos se enlaza en O(1) y ningún sensor se copia ni se
+     * vuelve a reservar; solo el índice por nombre necesita O(m) para
+     * registrar los m sensores incorporados.
      */
-    SensorBase* buscarPorNombre(const char* id) const
+    bool concatenar(ListaGeneral& otra)
     {
-        if (!id)
+        AuxiliarCli cli;
+        if (&otra == this || !otra.cabeza)
         {
-            return nullptr;
+            return true;
         }
 
-        NodoGeneral* actual = cabeza;
-        while (actual)
+        for (NodoGeneral* actual = otra.cabeza; actual; actual = actual->siguiente)
         {
-            if (std::strcmp(actual->sensor->obtenerNombre(), id) == 0)
+            if (indice.buscar(actual->sensor->obtenerNombre()))
             {
-                return actual->sensor;
+                cli.imprimirLogFormato<NivelLog::Advertencia>("Sensor '%s' ya existe en la lista; no se concatenó.",
+                                                              actual->sensor->obtenerNombre());
+                return false;
             }
-            actual = actual->siguiente;
         }
-        return nullptr;
+
+        std::size_t incorporados = otra.indice.tamano();
+        for (NodoGeneral* actual = otra.cabeza; actual; actual = actual->siguiente)
+        {
+            indice.insertar(actual->sensor);
+            numericos.insertar(actual->sensor);
+        }
+        if (!cola)
+        {
+            cabeza = otra.cabeza;
+        }
+        else
+        {
+            cola->siguiente = otra.cabeza;
+        }
+        cola = otra.cola;
+
+        otra.cabeza = nullptr;
+        otra.cola = nullptr;
+        otra.indice.vaciar();
+        otra.numericos.vaciar();
+
+        cli.imprimirLogFormato<NivelLog::Exito>("%zu sensores incorporados a la lista de gestión.", incorporados);
+        return true;
+    }
+
+    /**
+     * @brief Busca un sensor por identificador.
+     * @param id Cadena con el nombre del sensor.
+     * @return Puntero al sensor o nullptr si no existe.
+     */
+    SensorBase* buscarPorNombre(const char* id) const
+    {
+        return indice.buscar(id);
+    }
+
+    /**
+     * @brief Busca un sensor a partir de un nombre sin terminador (por ejemplo, una vista al buffer serial).
+     * @param id Inicio del nombre.
+     * @param longitud Número de caracteres del nombre.
+     * @return Puntero al sensor o nullptr si no existe.
+     */
+    SensorBase* buscarPorNombre(const char* id, std::size_t longitud) const
+    {
+        return indice.buscar(id, longitud);
+    }
+
+    /**
+     * @brief Busca un sensor por la clave de las tramas binarias.
+     * @param tipo Letra del nombre ('T', 'P', ...).
+     * @param id Parte numérica del nombre; ('T', 1) encuentra a "T-001".
+     * @return Puntero al sensor o nullptr si no existe.
+     */
+    SensorBase* buscarPorId(char tipo, std::uint16_t id) const
+    {
+        return numericos.buscar(claveNumerica(tipo, id));
     }
 
     /**
@@ -98,6 +189,21 @@ public:
         return cabeza == nullptr;
     }
 
+    /**
+     * @brief Activa o desactiva la ingesta concurrente en todos los sensores.
+     *
+     * Mientras está activa, varios hilos pueden entregar lecturas (buscarPorNombre()
+     * y registrarLecturaDesdeTexto()) al mismo tiempo que otro hilo procesa; el
+     * conjunto de sensores no debe cambiar durante ese periodo.
+     */
+    void establecerIngestaConcurrente(bool activa)
+    {
+        for (NodoGeneral* actual = cabeza; actual; actual = actual->siguiente)
+        {
+            actual->sensor->establecerIngestaConcurrente(activa);
+        }
+    }
+
     /**
      * @brief Recorre la lista e invoca procesarLectura() de cada sensor.
      */
@@ -106,26 +212,73 @@ public:
         AuxiliarCli cli;
         if (!cabeza)
         {
-            cli.imprimirLog("WARNING", "No hay sensores registrados para procesar.");
+            cli.imprimirLog(NivelLog::Advertencia, "No hay sensores registrados para procesar.");
             return;
         }
 
         NodoGeneral* actual = cabeza;
+        CronometroEtapas etapas;
         while (actual)
         {
-            char mensaje[160];
-            std::snprintf(mensaje, sizeof(mensaje), "-> Procesando Sensor %s...", actual->sensor->obtenerNombre());
-            cli.imprimirLog("STATUS", mensaje);
+            cli.imprimirLogFormato<NivelLog::Estado>("-> Procesando Sensor %s...", actual->sensor->obtenerNombre());
+            etapas.reanudar();
             actual->sensor->procesarLectura();
+            etapas.marcar(Etapa::Procesamiento);
             actual = actual->siguiente;
         }
     }
 
+    /**
+     * @brief Procesa los sensores en paralelo sobre el pool indicado.
+     * @param pool Pool de hilos que reparte los sensores con robo de trabajo.
+     *
+     * Cada sensor se procesa en un solo hilo y sus logs se capturan aparte;
+     * al terminar se emiten en el orden de registro, así que la salida es la
+     * misma que la de procesarSensores() sin importar cuántos hilos haya.
+     */
+    void procesarSensoresEnParalelo(PoolTrabajo& pool)
+    {
+        AuxiliarCli cli;
+        if (!cabeza)
+        {
+            cli.imprimirLog(NivelLog::Advertencia, "No hay sensores registrados para procesar.");
+            return;
+        }
+
+        std::size_t cantidad = indice.tamano();
+        SensorBase** sensores = new SensorBase*[cantidad];
+        CapturaLog* capturas = new CapturaLog[cantidad];
+        std::size_t posicion = 0;
+        for (NodoGeneral* actual = cabeza; actual; actual = actual->siguiente)
+        {
+            sensores[posicion++] = actual->sensor;
+        }
+
+        auto procesar = [sensores, capturas](std::size_t i)
+        {
+            CapturaLog::Activa activa(capturas[i]);
+            CronometroEtapas etapas;
+            sensores[i]->procesarLectura();
+            etapas.marcar(Etapa::Procesamiento);
+        };
+        pool.paraCada(cantidad, procesar);
+
+        for (std::size_t i = 0; i < cantidad; ++i)
+        {
+            cli.imprimirLogFormato<NivelLog::Estado>("-> Procesando Sensor %s...", sensores[i]->obtenerNombre());
+            capturas[i].volcar();
+        }
+
+        delete[] capturas;
+        delete[] sensores;
+    }
+
     /**
      * @brief Imprime un resumen simple de los sensores registrados.
      */
     void mostrarResumen() const
     {
+        AuxiliarCli::sincronizar();
         if (!cabeza)
         {
             std::cout << "Lista de sensores vacía." << std::endl;
@@ -149,9 +302,7 @@ public:
         NodoGeneral* actual = cabeza;
         while (actual)
         {
-            char mensaje[160];
-            std::snprintf(mensaje, sizeof(mensaje), "[Destructor General] Liberando Nodo: %s.", actual->sensor->obtenerNombre());
-            cli.imprimirLog("STATUS", mensaje);
+            cli.imprimirLogFormato<NivelLog::Estado>("[Destructor General] Liberando Nodo: %s.", actual->sensor->obtenerNombre());
 
             NodoGeneral* siguiente = actual->siguiente;
             delete actual->sensor;
@@ -159,6 +310,51 @@ public:
             actual = siguiente;
         }
         cabeza = nullptr;
+        cola = nullptr;
+        indice.vaciar();
+        numericos.vaciar();
+    }
+
+    /**
+     * @brief Libera todos los sensores sin detalle por sensor ni por lectura y reporta un solo resumen.
+     * @return Sensores, lecturas en memoria y bytes de historial liberados.
+     *
+     * Para cerrar con historiales grandes: cada sensor suelta su historial de
+     * una vez con SensorBase::liberarHistorial() antes de destruirse, así que
+     * el costo ya no crece con los mensajes de log por lectura.
+     */
+    ResumenLiberacion liberarEnBloque()
+    {
+        ResumenLiberacion resumen;
+        NodoGeneral* actual = cabeza;
+        while (actual)
+        {
+            NodoGeneral* siguiente = actual->siguiente;
+            actual->sensor->liberarHistorial(resumen);
+            delete actual->sensor;
+            delete actual;
+            actual = siguiente;
+        }
+        cabeza = nullptr;
+        cola = nullptr;
+        indice.vaciar();
+        numericos.vaciar();
+
+        AuxiliarCli cli;
+        cli.imprimirLogFormato<NivelLog::Exito>("Liberados %zu sensores: %zu lecturas y %zu bytes de historial.",
+                                                resumen.sensores, resumen.lecturas, resumen.bytes);
+        return resumen;
+    }
+
+    /// Total de lecturas en memoria de todos los sensores (recorre la lista).
+    std::size_t lecturasEnMemoria() const
+    {
+        std::size_t total = 0;
+        for (NodoGeneral* actual = cabeza; actual; actual = actual->siguiente)
+        {
+            total += actual->sensor->lecturasEnMemoria();
+        }
+        return total;
     }
 
 private:
@@ -171,6 +367,12 @@ private:
     };
 
     NodoGeneral* cabeza;
+    /// Último nodo, permite registrar sensores sin recorrer la lista.
+    NodoGeneral* cola;
+    /// Índice hash por nombre sobre los mismos sensores de la lista.
+    IndiceNombres indice;
+    /// Índice por (letra, número) para las tramas binarias.
+    IndiceNumerico numericos;
 };
 
 #endif
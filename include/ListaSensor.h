@@ -1,29 +1,71 @@
 /**
  * @file ListaSensor.h
- * @brief Lista enlazada simple genérica para lecturas de sensores.
+ * @brief Lista doblemente enlazada genérica para lecturas de sensores.
  */
 #ifndef LISTASENSOR_H
 #define LISTASENSOR_H
 
 #include "Nodo.h"
+#include "IndiceTemporal.h"
+#include "PoolNodos.h"
+#include "MonticuloLecturas.h"
+#include "PilaPendientes.h"
 #include <cstddef>
+#include <type_traits>
 
 /**
- * @brief Lista enlazada simple que almacena lecturas de tipo T.
+ * @brief Lista doblemente enlazada que almacena lecturas de tipo T.
+ *
+ * Los nodos se obtienen del asignador indicado; por omisión un PoolNodos
+ * propio de la lista, que agrupa los nodos en bloques y los recicla.
+ *
+ * La suma y la cantidad se mantienen al insertar y eliminar, y el máximo se
+ * lleva como valor corriente, así que insertar no toca ninguna estructura
+ * auxiliar. El mínimo usa un MonticuloLecturas que se arma en la primera
+ * consulta (O(n)) y después solo incorpora, al consultar, los nodos
+ * agregados desde entonces. Ese montículo y el enlace Nodo::anterior son el
+ * precio de eliminarMinimo() en O(log n): unos 24 bytes por lectura en el
+ * montículo una vez armado y 8 bytes por nodo. obtenerMaximo() vuelve a
+ * recorrer la lista solo si se eliminó la lectura que era el máximo.
+ *
+ * Otros hilos pueden agregar lecturas con insertarConcurrente(): quedan en una
+ * pila sin bloqueos y el hilo dueño las incorpora con consolidarPendientes().
+ * El resto de las operaciones solo debe usarlas el hilo dueño.
+ *
+ * Mover una lista, concatenar() y empalmarDespues() pasan la cadena completa
+ * de nodos a otra lista en O(1), junto con los bloques del asignador que la
+ * contienen; ningún nodo se copia ni se vuelve a reservar.
+ *
+ * Cada lectura lleva la marca de tiempo con la que llegó y un IndiceTemporal
+ * resume la lista por tramos, así que resumirRango() no la recorre completa.
  */
-template <typename T>
+template <typename T, typename Asignador = PoolNodos<T>>
 class ListaSensor
 {
 public:
     /// Construye una lista vacía.
-    ListaSensor() : cabeza(nullptr) {}
+    ListaSensor()
+        : cabeza(nullptr), cola(nullptr), cantidad(0), suma(0.0), maximo(T()), maximoVigente(false), minimosActivos(false),
+          sinMonticulo(nullptr), cantidadSinMonticulo(0)
+    {
+    }
 
-    /// Copia el contenido de otra lista.
-    ListaSensor(const ListaSensor& otra) : cabeza(nullptr)
+    /// Copia el contenido de otra lista en O(n).
+    ListaSensor(const ListaSensor& otra)
+        : cabeza(nullptr), cola(nullptr), cantidad(0), suma(0.0), maximo(T()), maximoVigente(false), minimosActivos(false),
+          sinMonticulo(nullptr), cantidadSinMonticulo(0)
     {
         copiarDesde(otra);
     }
 
+    /// Toma los nodos de otra lista en O(1); la otra queda vacía.
+    ListaSensor(ListaSensor&& otra)
+        : cabeza(nullptr), cola(nullptr), cantidad(0), suma(0.0), maximo(T()), maximoVigente(false), minimosActivos(false),
+          sinMonticulo(nullptr), cantidadSinMonticulo(0)
+    {
+        concatenar(otra);
+    }
+
     /// Asigna el contenido de otra lista.
     ListaSensor& operator=(const ListaSensor& otra)
     {
@@ -35,28 +77,213 @@ public:
         return *this;
     }
 
+    /// Libera el contenido actual y toma los nodos de otra lista en O(1).
+    ListaSensor& operator=(ListaSensor&& otra)
+    {
+        if (this != &otra)
+        {
+            limpiar();
+            concatenar(otra);
+        }
+        return *this;
+    }
+
     /// Libera todos los nodos de la lista.
     ~ListaSensor()
     {
         limpiar();
     }
 
-    /// Inserta un nuevo nodo al final de la lista.
+    /// Inserta un nuevo nodo al final de la lista en tiempo constante, con la hora actual.
     void insertarAlFinal(const T& valor)
     {
-        Nodo<T>* nuevo = new Nodo<T>(valor);
-        if (!cabeza)
+        insertarAlFinal(valor, marcaMonotonica());
+    }
+
+    /**
+     * @brief Inserta al final una lectura con una marca de tiempo explícita.
+     * @param marcaNs Nanosegundos del reloj monotónico (ver marcaMonotonica()).
+     */
+    void insertarAlFinal(const T& valor, std::int64_t marcaNs)
+    {
+        Nodo<T>* nuevo = asignador.crear(valor, marcaNs);
+        nuevo->anterior = cola;
+        if (!cola)
         {
             cabeza = nuevo;
+        }
+        else
+        {
+            cola->siguiente = nuevo;
+        }
+        cola = nuevo;
+        ++cantidad;
+        registrarAlta(nuevo);
+        indice.registrarAlta(nuevo);
+    }
+
+    /**
+     * @brief Inserta al final varias lecturas de una vez, cada una con su marca.
+     * @param marcasNs Marca de cada valor, en el mismo orden.
+     *
+     * Equivale a llamar insertarAlFinal() por cada valor, pero el asignador
+     * reserva de antemano el lugar de todo el lote y los agregados se ponen
+     * al día en la misma pasada que enlaza los nodos.
+     */
+    void insertarLote(const T* valores, const std::int64_t* marcasNs, std::size_t cantidadLote)
+    {
+        if (cantidadLote == 0)
+        {
             return;
         }
 
-        Nodo<T>* actual = cabeza;
-        while (actual->siguiente)
+        asignador.reservar(cantidadLote);
+        Nodo<T>** enlace = cola ? &cola->siguiente : &cabeza;
+        for (std::size_t i = 0; i < cantidadLote; ++i)
         {
-            actual = actual->siguiente;
+            Nodo<T>* nuevo = asignador.crear(valores[i], marcasNs[i]);
+            nuevo->anterior = cola;
+            *enlace = nuevo;
+            enlace = &nuevo->siguiente;
+            cola = nuevo;
+            registrarAlta(nuevo);
+            indice.registrarAlta(nuevo);
         }
-        actual->siguiente = nuevo;
+        cantidad += static_cast<int>(cantidadLote);
+    }
+
+    /// Variante de insertarLote() en la que todas las lecturas reciben la hora actual.
+    void insertarLote(const T* valores, std::size_t cantidadLote)
+    {
+        std::int64_t marca = marcaMonotonica();
+        asignador.reservar(cantidadLote);
+        for (std::size_t i = 0; i < cantidadLote; ++i)
+        {
+            insertarAlFinal(valores[i], marca);
+        }
+    }
+
+    /**
+     * @brief Agrega una lectura desde cualquier hilo sin tomar candados.
+     *
+     * La lectura se apila con compare-and-swap y no cuenta en contar(),
+     * promedio() ni en los extremos hasta que el hilo dueño llame a
+     * consolidarPendientes(). Varios hilos pueden llamarla a la vez. La
+     * marca de tiempo se toma aquí, no al consolidar.
+     */
+    void insertarConcurrente(const T& valor)
+    {
+        insertarConcurrente(valor, marcaMonotonica());
+    }
+
+    /// Variante de insertarConcurrente() con una marca de tiempo explícita.
+    void insertarConcurrente(const T& valor, std::int64_t marcaNs)
+    {
+        pendientes.apilar(valor, marcaNs);
+    }
+
+    /// Agrega varias lecturas desde cualquier hilo con una sola operación atómica sobre la pila.
+    void insertarLoteConcurrente(const T* valores, const std::int64_t* marcasNs, std::size_t cantidadLote)
+    {
+        pendientes.apilarLote(valores, marcasNs, cantidadLote);
+    }
+
+    /**
+     * @brief Incorpora al final, en orden de llegada, las lecturas de insertarConcurrente().
+     * @return Número de lecturas incorporadas.
+     *
+     * Toma toda la pila con un solo intercambio atómico, así que nunca hace
+     * esperar a los hilos que siguen agregando.
+     */
+    int consolidarPendientes()
+    {
+        return pendientes.consumir(
+            [this](const T* valores, const std::int64_t* marcas, std::size_t cantidadLote)
+            { insertarLote(valores, marcas, cantidadLote); });
+    }
+
+    /// Pasa todos los nodos de otra lista al final de esta en O(1); la otra queda vacía.
+    void concatenar(ListaSensor& otra)
+    {
+        empalmarDespues(cola, otra);
+    }
+
+    /**
+     * @brief Inserta la cadena completa de otra lista después de un nodo de esta, en O(1).
+     * @param posicion Nodo de esta lista tras el cual se inserta; nullptr para insertar al inicio.
+     * @param otra Lista origen; queda vacía y sin memoria reservada.
+     *
+     * Antes de transferir se consolidan las lecturas pendientes de otra. La
+     * suma, la cantidad y el máximo se combinan al momento; si ambas listas
+     * tenían lecturas, el montículo de mínimos se arma de nuevo en la
+     * siguiente consulta en lugar de fusionarse aquí; lo mismo ocurre con el
+     * índice temporal.
+     */
+    void empalmarDespues(Nodo<T>* posicion, ListaSensor& otra)
+    {
+        if (&otra == this)
+        {
+            return;
+        }
+        otra.consolidarPendientes();
+        if (!otra.cabeza)
+        {
+            return;
+        }
+
+        asignador.absorber(otra.asignador);
+        if (!cabeza)
+        {
+            cabeza = otra.cabeza;
+            cola = otra.cola;
+            minimos.intercambiar(otra.minimos);
+            minimosActivos = otra.minimosActivos;
+            sinMonticulo = otra.sinMonticulo;
+            cantidadSinMonticulo = otra.cantidadSinMonticulo;
+            maximo = otra.maximo;
+            maximoVigente = otra.maximoVigente;
+            indice.intercambiar(otra.indice);
+        }
+        else
+        {
+            if (posicion)
+            {
+                otra.cola->siguiente = posicion->siguiente;
+                if (posicion->siguiente)
+                {
+                    posicion->siguiente->anterior = otra.cola;
+                }
+                posicion->siguiente = otra.cabeza;
+                otra.cabeza->anterior = posicion;
+                if (posicion == cola)
+                {
+                    cola = otra.cola;
+                }
+            }
+            else
+            {
+                otra.cola->siguiente = cabeza;
+                cabeza->anterior = otra.cola;
+                cabeza = otra.cabeza;
+            }
+            descartarMinimos();
+            maximoVigente = maximoVigente && otra.maximoVigente;
+            if (maximoVigente && maximo < otra.maximo)
+            {
+                maximo = otra.maximo;
+            }
+            indice.invalidar();
+        }
+        cantidad += otra.cantidad;
+        suma += otra.suma;
+
+        otra.cabeza = nullptr;
+        otra.cola = nullptr;
+        otra.cantidad = 0;
+        otra.suma = 0.0;
+        otra.descartarMinimos();
+        otra.maximoVigente = false;
+        otra.indice.vaciar();
     }
 
     /// Busca el primer nodo cuyo dato coincide con el valor.
@@ -77,41 +304,76 @@ public:
     /// Elimina la primera coincidencia del valor solicitado.
     bool eliminarPrimeraCoincidencia(const T& valor)
     {
-        Nodo<T>* actual = cabeza;
-        Nodo<T>* anterior = nullptr;
+        Nodo<T>* encontrado = buscar(valor);
+        if (!encontrado)
+        {
+            return false;
+        }
+        desenlazar(encontrado);
+        return true;
+    }
 
-        while (actual)
+    /**
+     * @brief Elimina la lectura de menor valor (la más antigua si hay empate) en O(log n) amortizado.
+     * @param minimo Recibe el valor eliminado.
+     * @return false si la lista está vacía.
+     *
+     * El montículo de mínimos indica el nodo exacto y el enlace al anterior
+     * permite quitarlo sin recorrer la lista. La primera llamada arma el
+     * montículo en O(n).
+     */
+    bool eliminarMinimo(T& minimo)
+    {
+        prepararMinimos();
+        Nodo<T>* nodo = minimos.topeNodo();
+        if (!nodo)
         {
-            if (actual->dato == valor)
-            {
-                if (anterior)
-                {
-                    anterior->siguiente = actual->siguiente;
-                }
-                else
-                {
-                    cabeza = actual->siguiente;
-                }
-                delete actual;
-                return true;
-            }
-            anterior = actual;
-            actual = actual->siguiente;
+            return false;
         }
-        return false;
+        minimo = nodo->dato;
+        desenlazar(nodo);
+        return true;
     }
 
-    /// Elimina todos los nodos almacenados.
+    /**
+     * @brief Elimina todos los nodos almacenados.
+     *
+     * Con un asignador de liberación masiva los bloques se devuelven de una
+     * sola vez; solo se recorren los nodos si T requiere destructor.
+     * También descarta las lecturas pendientes de consolidar.
+     */
     void limpiar()
     {
-        Nodo<T>* actual = cabeza;
-        while (actual)
+        pendientes.descartar();
+
+        if constexpr (Asignador::liberacionMasiva)
+        {
+            if constexpr (!std::is_trivially_destructible<T>::value)
+            {
+                for (Nodo<T>* actual = cabeza; actual; actual = actual->siguiente)
+                {
+                    actual->dato.~T();
+                }
+            }
+            asignador.liberarTodo();
+        }
+        else
         {
-            Nodo<T>* siguiente = actual->siguiente;
-            delete actual;
-            actual = siguiente;
+            Nodo<T>* actual = cabeza;
+            while (actual)
+            {
+                Nodo<T>* siguiente = actual->siguiente;
+                asignador.destruir(actual);
+                actual = siguiente;
+            }
         }
         cabeza = nullptr;
+        cola = nullptr;
+        cantidad = 0;
+        suma = 0.0;
+        descartarMinimos();
+        maximoVigente = false;
+        indice.vaciar();
     }
 
     /// Indica si la lista no contiene elementos.
@@ -122,50 +384,40 @@ public:
 
     /// Extrae el primer nodo y devuelve su valor.
     bool extraerPrimero(T& valor)
+    {
+        std::int64_t marca = 0;
+        return extraerPrimero(valor, marca);
+    }
+
+    /// Extrae el primer nodo y devuelve su valor y su marca de tiempo.
+    bool extraerPrimero(T& valor, std::int64_t& marcaNs)
     {
         if (!cabeza)
         {
             return false;
         }
 
-        Nodo<T>* eliminado = cabeza;
-        valor = eliminado->dato;
-        cabeza = eliminado->siguiente;
-        delete eliminado;
+        valor = cabeza->dato;
+        marcaNs = cabeza->marca;
+        desenlazar(cabeza);
         return true;
     }
 
-    /// Cuenta cuántos nodos forman la lista.
+    /// Devuelve cuántos nodos forman la lista (valor mantenido, O(1)).
     int contar() const
     {
-        int cantidad = 0;
-        Nodo<T>* actual = cabeza;
-        while (actual)
-        {
-            ++cantidad;
-            actual = actual->siguiente;
-        }
         return cantidad;
     }
 
-    /// Calcula el promedio de los valores almacenados.
-    double promedio() const
+    /// Devuelve la suma acumulada de los valores almacenados.
+    double obtenerSuma() const
     {
-        if (!cabeza)
-        {
-            return 0.0;
-        }
-
-        double suma = 0.0;
-        int cantidad = 0;
-        Nodo<T>* actual = cabeza;
-        while (actual)
-        {
-            suma += static_cast<double>(actual->dato);
-            ++cantidad;
-            actual = actual->siguiente;
-        }
+        return suma;
+    }
 
+    /// Calcula el promedio a partir de la suma y la cantidad mantenidas.
+    double promedio() const
+    {
         if (cantidad == 0)
         {
             return 0.0;
@@ -174,46 +426,253 @@ public:
         return suma / static_cast<double>(cantidad);
     }
 
-    /// Obtiene el valor mínimo almacenado.
+    /// Obtiene el valor mínimo almacenado; O(n) la primera vez, luego O(k log n) por k lecturas nuevas.
     bool obtenerMinimo(T& minimo) const
+    {
+        prepararMinimos();
+        return minimos.tope(minimo);
+    }
+
+    /// Obtiene el valor máximo almacenado; O(1) salvo tras eliminar el propio máximo.
+    bool obtenerMaximo(T& maximoActual) const
     {
         if (!cabeza)
         {
             return false;
         }
-
-        Nodo<T>* actual = cabeza;
-        minimo = actual->dato;
-        actual = actual->siguiente;
-        while (actual)
+        if (!maximoVigente)
         {
-            if (actual->dato < minimo)
+            maximo = cabeza->dato;
+            for (const Nodo<T>* actual = cabeza->siguiente; actual; actual = actual->siguiente)
             {
-                minimo = actual->dato;
+                if (maximo < actual->dato)
+                {
+                    maximo = actual->dato;
+                }
             }
-            actual = actual->siguiente;
+            maximoVigente = true;
         }
+        maximoActual = maximo;
         return true;
     }
 
+    /**
+     * @brief Cantidad, suma y extremos de las lecturas con marca en [desdeNs, hastaNs).
+     *
+     * O(log n + tramo) mientras las marcas lleguen en orden; tras un empalme
+     * intermedio la primera consulta rehace el índice en O(n).
+     */
+    ResumenRango<T> resumirRango(std::int64_t desdeNs, std::int64_t hastaNs) const
+    {
+        return indice.resumir(cabeza, desdeNs, hastaNs);
+    }
+
     /// Devuelve el puntero al primer nodo de la lista.
     Nodo<T>* obtenerCabeza() const
     {
         return cabeza;
     }
 
+    /// Bytes reservados por el asignador para los nodos de esta lista.
+    std::size_t bytesReservados() const
+    {
+        return asignador.bytesReservados() + indice.bytesReservados();
+    }
+
 private:
     /// Apuntador al primer nodo de la lista.
     Nodo<T>* cabeza;
+    /// Apuntador al último nodo, permite insertar al final sin recorrer.
+    Nodo<T>* cola;
+    /// Número de nodos almacenados, actualizado en cada inserción y eliminación.
+    int cantidad;
+    /// Suma de todos los valores almacenados.
+    double suma;
+    /// Máximo corriente; solo es válido si maximoVigente.
+    mutable T maximo;
+    /// Falso tras eliminar el máximo (o empalmar sin conocerlo); obtenerMaximo() lo recalcula.
+    mutable bool maximoVigente;
+    /// Seguimiento del mínimo que sobrevive a la eliminación del propio mínimo; vacío hasta la primera consulta.
+    mutable MonticuloLecturas<T, true> minimos;
+    /// Indica si minimos ya se armó y contiene todos los nodos anteriores a sinMonticulo.
+    mutable bool minimosActivos;
+    /// Primer nodo agregado después de la última puesta al día de minimos; nullptr si no hay.
+    mutable Nodo<T>* sinMonticulo;
+    /// Nodos desde sinMonticulo hasta la cola.
+    mutable std::size_t cantidadSinMonticulo;
+    /// Origen de la memoria de los nodos; cada lista tiene el suyo.
+    Asignador asignador;
+    /// Pila de lecturas agregadas por otros hilos, aún sin consolidar.
+    PilaPendientes<T> pendientes;
+    /// Resumen por tramos para las consultas por intervalo; se pone al día al consultar.
+    mutable IndiceTemporal<T> indice;
+
+    /// Actualiza los agregados tras enlazar un nodo al final; no toca el montículo.
+    void registrarAlta(Nodo<T>* nodo)
+    {
+        suma += static_cast<double>(nodo->dato);
+        if (nodo == cabeza)
+        {
+            maximo = nodo->dato;
+            maximoVigente = true;
+        }
+        else if (maximoVigente && maximo < nodo->dato)
+        {
+            maximo = nodo->dato;
+        }
+        if (minimosActivos)
+        {
+            if (!sinMonticulo)
+            {
+                sinMonticulo = nodo;
+            }
+            ++cantidadSinMonticulo;
+        }
+    }
 
-    /// Copia todos los elementos de otra lista auxiliar.
+    /**
+     * @brief Quita un nodo de la cadena en O(1), actualiza índice y agregados y lo devuelve al asignador.
+     */
+    void desenlazar(Nodo<T>* nodo)
+    {
+        // Un nodo pendiente que no es el primero de los pendientes no se distingue de uno ya incorporado.
+        if (minimosActivos && sinMonticulo && nodo != sinMonticulo)
+        {
+            incorporarPendientes();
+        }
+
+        Nodo<T>* anterior = nodo->anterior;
+        Nodo<T>* siguiente = nodo->siguiente;
+        if (anterior)
+        {
+            anterior->siguiente = siguiente;
+        }
+        else
+        {
+            cabeza = siguiente;
+        }
+        if (siguiente)
+        {
+            siguiente->anterior = anterior;
+        }
+        else
+        {
+            cola = anterior;
+        }
+        indice.registrarBaja(nodo, siguiente);
+        --cantidad;
+        registrarBaja(nodo);
+        asignador.destruir(nodo);
+    }
+
+    /// Actualiza los agregados tras desenlazar un nodo (todavía sin destruir).
+    void registrarBaja(Nodo<T>* nodo)
+    {
+        const T& valor = nodo->dato;
+        if (cantidad == 0)
+        {
+            suma = 0.0;
+            descartarMinimos();
+            maximoVigente = false;
+            indice.vaciar();
+            return;
+        }
+
+        suma -= static_cast<double>(valor);
+        if (maximoVigente && !(valor < maximo))
+        {
+            maximoVigente = false;
+        }
+        if (!minimosActivos)
+        {
+            return;
+        }
+        if (nodo == sinMonticulo)
+        {
+            // Nunca entró al montículo.
+            sinMonticulo = nodo->siguiente;
+            --cantidadSinMonticulo;
+            return;
+        }
+        minimos.retirar(nodo);
+        if (minimos.convieneReconstruir())
+        {
+            armarMinimos();
+        }
+    }
+
+    /// Deja minimos al día: lo arma si nunca se consultó o incorpora los nodos agregados desde la última vez.
+    void prepararMinimos() const
+    {
+        if (!minimosActivos)
+        {
+            armarMinimos();
+        }
+        else if (sinMonticulo)
+        {
+            incorporarPendientes();
+        }
+    }
+
+    /// Arma minimos desde toda la cadena en O(n).
+    void armarMinimos() const
+    {
+        minimos.reconstruirDesde(cabeza, static_cast<std::size_t>(cantidad));
+        minimosActivos = true;
+        sinMonticulo = nullptr;
+        cantidadSinMonticulo = 0;
+    }
+
+    /// Inserta en minimos los nodos desde sinMonticulo; si son muchos, rearma en O(n).
+    void incorporarPendientes() const
+    {
+        if (cantidadSinMonticulo * 2 > static_cast<std::size_t>(cantidad))
+        {
+            armarMinimos();
+            return;
+        }
+        for (Nodo<T>* actual = sinMonticulo; actual; actual = actual->siguiente)
+        {
+            minimos.insertar(actual);
+        }
+        sinMonticulo = nullptr;
+        cantidadSinMonticulo = 0;
+    }
+
+    /// Libera minimos; la próxima consulta lo vuelve a armar.
+    void descartarMinimos()
+    {
+        minimos.vaciar();
+        minimosActivos = false;
+        sinMonticulo = nullptr;
+        cantidadSinMonticulo = 0;
+    }
+
+    /**
+     * @brief Copia todos los elementos de otra lista en O(n); esta debe estar vacía.
+     *
+     * Enlaza los nodos nuevos directamente (con sus marcas de tiempo) y toma la
+     * suma, la cantidad y el máximo de la otra lista; el montículo de mínimos
+     * y el índice temporal se arman en la primera consulta.
+     */
     void copiarDesde(const ListaSensor& otra)
     {
-        Nodo<T>* actual = otra.cabeza;
-        while (actual)
+        Nodo<T>** enlace = &cabeza;
+        for (Nodo<T>* actual = otra.cabeza; actual; actual = actual->siguiente)
         {
-            insertarAlFinal(actual->dato);
-            actual = actual->siguiente;
+            Nodo<T>* nuevo = asignador.crear(actual->dato, actual->marca);
+            nuevo->anterior = cola;
+            *enlace = nuevo;
+            enlace = &nuevo->siguiente;
+            cola = nuevo;
+        }
+        cantidad = otra.cantidad;
+        suma = otra.suma;
+        maximo = otra.maximo;
+        maximoVigente = otra.maximoVigente;
+        if (cabeza)
+        {
+            indice.invalidar();
         }
     }
 };
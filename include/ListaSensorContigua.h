@@ -0,0 +1,282 @@
+/**
+ * @file ListaSensorContigua.h
+ * @brief Variante de ListaSensor sobre un arreglo contiguo con agregados vectorizados.
+ */
+#ifndef LISTASENSORCONTIGUA_H
+#define LISTASENSORCONTIGUA_H
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include "AgregadosSimd.h"
+#include "PilaPendientes.h"
+
+/**
+ * @brief Historial de lecturas float o int en un solo arreglo, con la interfaz pública de ListaSensor.
+ *
+ * Las lecturas válidas ocupan datos[inicio, fin). Insertar al final cuesta
+ * O(1) amortizado (el arreglo duplica su capacidad) y extraer por el frente
+ * solo avanza inicio; el hueco se recupera al crecer.
+ *
+ * A diferencia de ListaSensor no mantiene agregados al insertar: promedio(),
+ * los extremos, contarMayoresQue() y varianza() recorren el arreglo con los
+ * núcleos de AgregadosSimd (AVX2, SSE4.1 o escalar según la CPU), que es lo
+ * que una lista enlazada no permite.
+ */
+template <typename T>
+class ListaSensorContigua
+{
+public:
+    static_assert(std::is_same<T, float>::value || std::is_same<T, int>::value,
+                  "ListaSensorContigua solo admite lecturas float o int.");
+
+    /// Construye una lista vacía.
+    ListaSensorContigua() : datos(nullptr), inicio(0), fin(0), capacidad(0) {}
+
+    /// Copia el contenido de otra lista.
+    ListaSensorContigua(const ListaSensorContigua& otra) : datos(nullptr), inicio(0), fin(0), capacidad(0)
+    {
+        copiarDesde(otra);
+    }
+
+    /// Asigna el contenido de otra lista.
+    ListaSensorContigua& operator=(const ListaSensorContigua& otra)
+    {
+        if (this != &otra)
+        {
+            limpiar();
+            copiarDesde(otra);
+        }
+        return *this;
+    }
+
+    /// Libera el arreglo.
+    ~ListaSensorContigua()
+    {
+        delete[] datos;
+    }
+
+    /// Inserta una lectura al final en O(1) amortizado.
+    void insertarAlFinal(const T& valor)
+    {
+        if (fin == capacidad)
+        {
+            crecer(contar() + 1);
+        }
+        datos[fin++] = valor;
+    }
+
+    /// Agrega una lectura desde cualquier hilo; se incorpora con consolidarPendientes().
+    void insertarConcurrente(const T& valor)
+    {
+        pendientes.apilar(valor);
+    }
+
+    /// Incorpora al final, en orden de llegada, las lecturas de insertarConcurrente().
+    int consolidarPendientes()
+    {
+        return pendientes.consumir(
+            [this](const T* valores, const std::int64_t*, std::size_t cantidadLote)
+            {
+                for (std::size_t i = 0; i < cantidadLote; ++i)
+                {
+                    insertarAlFinal(valores[i]);
+                }
+            });
+    }
+
+    /// Busca la primera lectura igual al valor y devuelve su dirección en el arreglo.
+    T* buscar(const T& valor) const
+    {
+        for (std::size_t i = inicio; i < fin; ++i)
+        {
+            if (datos[i] == valor)
+            {
+                return datos + i;
+            }
+        }
+        return nullptr;
+    }
+
+    /// Elimina la primera coincidencia del valor desplazando las lecturas posteriores.
+    bool eliminarPrimeraCoincidencia(const T& valor)
+    {
+        T* encontrado = buscar(valor);
+        if (!encontrado)
+        {
+            return false;
+        }
+
+        std::size_t posicion = static_cast<std::size_t>(encontrado - datos);
+        if (posicion == inicio)
+        {
+            ++inicio;
+        }
+        else
+        {
+            std::memmove(encontrado, encontrado + 1, (fin - posicion - 1) * sizeof(T));
+            --fin;
+        }
+        reiniciarSiVacia();
+        return true;
+    }
+
+    /// Elimina todas las lecturas; conserva el arreglo para reutilizarlo.
+    void limpiar()
+    {
+        pendientes.descartar();
+        inicio = 0;
+        fin = 0;
+    }
+
+    /// Indica si la lista no contiene elementos.
+    bool estaVacia() const
+    {
+        return inicio == fin;
+    }
+
+    /// Extrae la primera lectura y devuelve su valor.
+    bool extraerPrimero(T& valor)
+    {
+        if (estaVacia())
+        {
+            return false;
+        }
+        valor = datos[inicio++];
+        reiniciarSiVacia();
+        return true;
+    }
+
+    /// Devuelve cuántas lecturas almacena la lista.
+    int contar() const
+    {
+        return static_cast<int>(fin - inicio);
+    }
+
+    /// Suma de las lecturas (recorrido vectorizado).
+    double obtenerSuma() const
+    {
+        return AgregadosSimd::sumar(datos + inicio, fin - inicio);
+    }
+
+    /// Promedio de las lecturas (recorrido vectorizado).
+    double promedio() const
+    {
+        if (estaVacia())
+        {
+            return 0.0;
+        }
+        return obtenerSuma() / static_cast<double>(contar());
+    }
+
+    /// Obtiene el valor mínimo almacenado.
+    bool obtenerMinimo(T& minimo) const
+    {
+        T maximo;
+        return AgregadosSimd::extremos(datos + inicio, fin - inicio, minimo, maximo);
+    }
+
+    /// Obtiene el valor máximo almacenado.
+    bool obtenerMaximo(T& maximo) const
+    {
+        T minimo;
+        return AgregadosSimd::extremos(datos + inicio, fin - inicio, minimo, maximo);
+    }
+
+    /// Obtiene mínimo y máximo en una sola pasada.
+    bool obtenerExtremos(T& minimo, T& maximo) const
+    {
+        return AgregadosSimd::extremos(datos + inicio, fin - inicio, minimo, maximo);
+    }
+
+    /// Cuenta las lecturas estrictamente mayores que el umbral.
+    std::size_t contarMayoresQue(const T& umbral) const
+    {
+        return AgregadosSimd::contarMayoresQue(datos + inicio, fin - inicio, umbral);
+    }
+
+    /// Varianza poblacional de las lecturas.
+    double varianza() const
+    {
+        return AgregadosSimd::varianza(datos + inicio, fin - inicio);
+    }
+
+    /// Apuntador a la primera lectura; las contar() lecturas siguen de forma contigua.
+    const T* obtenerDatos() const
+    {
+        return datos + inicio;
+    }
+
+    /// Bytes reservados por el arreglo.
+    std::size_t bytesReservados() const
+    {
+        return capacidad * sizeof(T);
+    }
+
+private:
+    /// Arreglo de lecturas; las válidas están en [inicio, fin).
+    T* datos;
+    std::size_t inicio;
+    std::size_t fin;
+    std::size_t capacidad;
+    /// Pila de lecturas agregadas por otros hilos, aún sin consolidar.
+    PilaPendientes<T> pendientes;
+
+    /// Reserva un arreglo para al menos minimo lecturas y compacta las vigentes al principio.
+    void crecer(std::size_t minimo)
+    {
+        std::size_t nueva = (capacidad < 16) ? 16 : capacidad * 2;
+        while (nueva < minimo)
+        {
+            nueva *= 2;
+        }
+
+        // Si más de la mitad es hueco del frente, basta con compactar.
+        if (inicio * 2 >= capacidad && minimo <= capacidad)
+        {
+            std::memmove(datos, datos + inicio, (fin - inicio) * sizeof(T));
+            fin -= inicio;
+            inicio = 0;
+            return;
+        }
+
+        T* nuevo = new T[nueva];
+        if (datos)
+        {
+            std::memcpy(nuevo, datos + inicio, (fin - inicio) * sizeof(T));
+        }
+        delete[] datos;
+        datos = nuevo;
+        fin -= inicio;
+        inicio = 0;
+        capacidad = nueva;
+    }
+
+    /// Regresa los índices al principio cuando ya no quedan lecturas.
+    void reiniciarSiVacia()
+    {
+        if (inicio == fin)
+        {
+            inicio = 0;
+            fin = 0;
+        }
+    }
+
+    /// Copia todas las lecturas de otra lista.
+    void copiarDesde(const ListaSensorContigua& otra)
+    {
+        if (otra.estaVacia())
+        {
+            return;
+        }
+        if (capacidad < otra.fin - otra.inicio)
+        {
+            crecer(otra.fin - otra.inicio);
+        }
+        std::memcpy(datos, otra.datos + otra.inicio, (otra.fin - otra.inicio) * sizeof(T));
+        inicio = 0;
+        fin = otra.fin - otra.inicio;
+    }
+};
+
+#endif
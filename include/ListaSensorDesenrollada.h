@@ -0,0 +1,265 @@
+/**
+ * @file ListaSensorDesenrollada.h
+ * @brief Variante desenrollada de ListaSensor: cada nodo guarda un bloque de lecturas.
+ */
+#ifndef LISTASENSORDESENROLLADA_H
+#define LISTASENSORDESENROLLADA_H
+
+#include "NodoBloque.h"
+#include <cstddef>
+
+/**
+ * @brief Lista enlazada de bloques con la misma interfaz pública que ListaSensor.
+ *
+ * Guardar las lecturas en bloques contiguos reduce un salto de apuntador por
+ * cada Capacidad elementos, de modo que los recorridos de promedio(), mínimo y
+ * búsqueda avanzan por memoria secuencial en lugar de saltar entre nodos.
+ */
+template <typename T, std::size_t Capacidad = 64>
+class ListaSensorDesenrollada
+{
+public:
+    /// Tipo de nodo que expone obtenerCabeza().
+    typedef NodoBloque<T, Capacidad> Bloque;
+
+    static_assert(Capacidad > 0, "Cada bloque debe poder almacenar al menos una lectura.");
+
+    /// Construye una lista vacía.
+    ListaSensorDesenrollada() : cabeza(nullptr), cola(nullptr), cantidad(0) {}
+
+    /// Copia el contenido de otra lista.
+    ListaSensorDesenrollada(const ListaSensorDesenrollada& otra) : cabeza(nullptr), cola(nullptr), cantidad(0)
+    {
+        copiarDesde(otra);
+    }
+
+    /// Asigna el contenido de otra lista.
+    ListaSensorDesenrollada& operator=(const ListaSensorDesenrollada& otra)
+    {
+        if (this != &otra)
+        {
+            limpiar();
+            copiarDesde(otra);
+        }
+        return *this;
+    }
+
+    /// Libera todos los bloques de la lista.
+    ~ListaSensorDesenrollada()
+    {
+        limpiar();
+    }
+
+    /// Inserta un valor al final; solo reserva memoria cuando el último bloque se llena.
+    void insertarAlFinal(const T& valor)
+    {
+        if (!cola || cola->estaLleno())
+        {
+            Bloque* nuevo = new Bloque();
+            if (!cola)
+            {
+                cabeza = nuevo;
+            }
+            else
+            {
+                cola->siguiente = nuevo;
+            }
+            cola = nuevo;
+        }
+
+        cola->datos[cola->inicio + cola->cantidad] = valor;
+        ++cola->cantidad;
+        ++cantidad;
+    }
+
+    /// Busca la primera lectura igual al valor y devuelve su dirección dentro del bloque.
+    T* buscar(const T& valor) const
+    {
+        for (Bloque* actual = cabeza; actual; actual = actual->siguiente)
+        {
+            T* datos = actual->primero();
+            for (int i = 0; i < actual->cantidad; ++i)
+            {
+                if (datos[i] == valor)
+                {
+                    return datos + i;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    /// Elimina la primera coincidencia del valor solicitado.
+    bool eliminarPrimeraCoincidencia(const T& valor)
+    {
+        Bloque* anterior = nullptr;
+        for (Bloque* actual = cabeza; actual; actual = actual->siguiente)
+        {
+            T* datos = actual->primero();
+            for (int i = 0; i < actual->cantidad; ++i)
+            {
+                if (datos[i] == valor)
+                {
+                    if (i == 0)
+                    {
+                        ++actual->inicio;
+                    }
+                    else
+                    {
+                        for (int j = i + 1; j < actual->cantidad; ++j)
+                        {
+                            datos[j - 1] = datos[j];
+                        }
+                    }
+                    --actual->cantidad;
+                    --cantidad;
+
+                    if (actual->cantidad == 0)
+                    {
+                        desenlazar(actual, anterior);
+                    }
+                    return true;
+                }
+            }
+            anterior = actual;
+        }
+        return false;
+    }
+
+    /// Elimina todos los bloques almacenados.
+    void limpiar()
+    {
+        Bloque* actual = cabeza;
+        while (actual)
+        {
+            Bloque* siguiente = actual->siguiente;
+            delete actual;
+            actual = siguiente;
+        }
+        cabeza = nullptr;
+        cola = nullptr;
+        cantidad = 0;
+    }
+
+    /// Indica si la lista no contiene elementos.
+    bool estaVacia() const
+    {
+        return cantidad == 0;
+    }
+
+    /// Extrae la primera lectura y devuelve su valor.
+    bool extraerPrimero(T& valor)
+    {
+        if (!cabeza)
+        {
+            return false;
+        }
+
+        valor = cabeza->datos[cabeza->inicio];
+        ++cabeza->inicio;
+        --cabeza->cantidad;
+        --cantidad;
+
+        if (cabeza->cantidad == 0)
+        {
+            desenlazar(cabeza, nullptr);
+        }
+        return true;
+    }
+
+    /// Devuelve cuántas lecturas almacena la lista.
+    int contar() const
+    {
+        return cantidad;
+    }
+
+    /// Calcula el promedio recorriendo cada bloque de forma secuencial.
+    double promedio() const
+    {
+        if (cantidad == 0)
+        {
+            return 0.0;
+        }
+
+        double suma = 0.0;
+        for (Bloque* actual = cabeza; actual; actual = actual->siguiente)
+        {
+            const T* datos = actual->primero();
+            for (int i = 0; i < actual->cantidad; ++i)
+            {
+                suma += static_cast<double>(datos[i]);
+            }
+        }
+        return suma / static_cast<double>(cantidad);
+    }
+
+    /// Obtiene el valor mínimo almacenado.
+    bool obtenerMinimo(T& minimo) const
+    {
+        if (!cabeza)
+        {
+            return false;
+        }
+
+        minimo = cabeza->datos[cabeza->inicio];
+        for (Bloque* actual = cabeza; actual; actual = actual->siguiente)
+        {
+            const T* datos = actual->primero();
+            for (int i = 0; i < actual->cantidad; ++i)
+            {
+                if (datos[i] < minimo)
+                {
+                    minimo = datos[i];
+                }
+            }
+        }
+        return true;
+    }
+
+    /// Devuelve el primer bloque; se recorre con Bloque::siguiente.
+    Bloque* obtenerCabeza() const
+    {
+        return cabeza;
+    }
+
+private:
+    /// Primer bloque de la lista.
+    Bloque* cabeza;
+    /// Último bloque, donde se insertan las lecturas nuevas.
+    Bloque* cola;
+    /// Total de lecturas almacenadas entre todos los bloques.
+    int cantidad;
+
+    /// Retira un bloque vacío de la cadena y lo libera.
+    void desenlazar(Bloque* bloque, Bloque* anterior)
+    {
+        if (anterior)
+        {
+            anterior->siguiente = bloque->siguiente;
+        }
+        else
+        {
+            cabeza = bloque->siguiente;
+        }
+        if (bloque == cola)
+        {
+            cola = anterior;
+        }
+        delete bloque;
+    }
+
+    /// Copia todos los elementos de otra lista auxiliar.
+    void copiarDesde(const ListaSensorDesenrollada& otra)
+    {
+        for (Bloque* actual = otra.cabeza; actual; actual = actual->siguiente)
+        {
+            const T* datos = actual->primero();
+            for (int i = 0; i < actual->cantidad; ++i)
+            {
+                insertarAlFinal(datos[i]);
+            }
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,249 @@
+/**
+ * @file MonticuloLecturas.h
+ * @brief Montículo binario con borrado diferido para seguir el mínimo o máximo de un historial.
+ */
+#ifndef MONTICULOLECTURAS_H
+#define MONTICULOLECTURAS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include "Nodo.h"
+
+/**
+ * @brief Montículo de lecturas que tolera eliminar cualquier nodo, incluido el tope.
+ *
+ * Cada entrada guarda el valor, la marca y el nodo de la lista que la
+ * contiene, así que el tope identifica el nodo exacto que hay que desenlazar
+ * sin recorrer la lista. Las eliminaciones se registran en un segundo
+ * montículo ("retirados") y se descartan cuando ambos topes coinciden, así
+ * que insertar y retirar cuestan O(log n) y consultar el tope es O(1)
+ * amortizado. Con Minimo = true el tope es el menor valor; con false, el
+ * mayor. Entre valores iguales va primero la lectura más antigua.
+ *
+ * Una entrada retirada puede apuntar a un nodo ya liberado: nunca se
+ * desreferencia, solo se compara. Si la ranura se reutiliza para un nodo
+ * nuevo con el mismo valor y marca, las dos entradas iguales se cancelan por
+ * pares y queda la vigente, que es lo correcto.
+ */
+template <typename T, bool Minimo>
+class MonticuloLecturas
+{
+public:
+    MonticuloLecturas() = default;
+    MonticuloLecturas(const MonticuloLecturas&) = delete;
+    MonticuloLecturas& operator=(const MonticuloLecturas&) = delete;
+
+    /// Agrega la lectura de un nodo recién enlazado.
+    void insertar(Nodo<T>* nodo)
+    {
+        vigentes.agregar(entradaDe(nodo));
+    }
+
+    /// Marca como eliminada la lectura del nodo; debe llamarse antes de destruirlo.
+    void retirar(Nodo<T>* nodo)
+    {
+        retirados.agregar(entradaDe(nodo));
+    }
+
+    /// Obtiene el valor del tope vigente.
+    bool tope(T& valor)
+    {
+        Nodo<T>* nodo = topeNodo();
+        if (!nodo)
+        {
+            return false;
+        }
+        valor = vigentes.datos[0].valor;
+        return true;
+    }
+
+    /// Nodo que contiene el tope vigente, descartando antes las entradas retiradas; nullptr si no hay.
+    Nodo<T>* topeNodo()
+    {
+        while (vigentes.cantidad > 0 && retirados.cantidad > 0 &&
+               !antes(retirados.datos[0], vigentes.datos[0]) && !antes(vigentes.datos[0], retirados.datos[0]))
+        {
+            vigentes.quitarTope();
+            retirados.quitarTope();
+        }
+        return (vigentes.cantidad == 0) ? nullptr : vigentes.datos[0].nodo;
+    }
+
+    /// Indica si los retirados pendientes ya ocupan más que la mitad del montículo.
+    bool convieneReconstruir() const
+    {
+        return retirados.cantidad > 64 && retirados.cantidad * 2 > vigentes.cantidad;
+    }
+
+    /// Reconstruye el montículo en O(n) a partir de la cadena de nodos vigente.
+    void reconstruirDesde(Nodo<T>* cabeza, std::size_t cantidad)
+    {
+        vigentes.cantidad = 0;
+        retirados.cantidad = 0;
+        vigentes.asegurarCapacidad(cantidad);
+        for (Nodo<T>* actual = cabeza; actual; actual = actual->siguiente)
+        {
+            vigentes.datos[vigentes.cantidad++] = entradaDe(actual);
+        }
+        for (std::size_t i = vigentes.cantidad / 2; i > 0; --i)
+        {
+            vigentes.hundir(i - 1);
+        }
+    }
+
+    /// Intercambia el contenido con otro montículo en O(1).
+    void intercambiar(MonticuloLecturas& otro)
+    {
+        vigentes.intercambiar(otro.vigentes);
+        retirados.intercambiar(otro.retirados);
+    }
+
+    /// Descarta todo el contenido y libera la memoria de ambos montículos.
+    void vaciar()
+    {
+        vigentes.liberar();
+        retirados.liberar();
+    }
+
+private:
+    /// Lectura con el nodo que la contiene; la marca y el nodo desempatan valores iguales.
+    struct Entrada
+    {
+        T valor;
+        std::int64_t marca;
+        Nodo<T>* nodo;
+    };
+
+    /// Arreglo dinámico organizado como montículo binario.
+    struct Arreglo
+    {
+        Entrada* datos = nullptr;
+        std::size_t cantidad = 0;
+        std::size_t capacidad = 0;
+
+        ~Arreglo()
+        {
+            liberar();
+        }
+
+        void liberar()
+        {
+            delete[] datos;
+            datos = nullptr;
+            cantidad = 0;
+            capacidad = 0;
+        }
+
+        void intercambiar(Arreglo& otro)
+        {
+            Entrada* datosPropios = datos;
+            std::size_t cantidadPropia = cantidad;
+            std::size_t capacidadPropia = capacidad;
+            datos = otro.datos;
+            cantidad = otro.cantidad;
+            capacidad = otro.capacidad;
+            otro.datos = datosPropios;
+            otro.cantidad = cantidadPropia;
+            otro.capacidad = capacidadPropia;
+        }
+
+        void asegurarCapacidad(std::size_t requerida)
+        {
+            if (requerida <= capacidad)
+            {
+                return;
+            }
+
+            std::size_t nueva = (capacidad == 0) ? 16 : capacidad;
+            while (nueva < requerida)
+            {
+                nueva *= 2;
+            }
+
+            Entrada* ampliado = new Entrada[nueva];
+            for (std::size_t i = 0; i < cantidad; ++i)
+            {
+                ampliado[i] = datos[i];
+            }
+            delete[] datos;
+            datos = ampliado;
+            capacidad = nueva;
+        }
+
+        void agregar(const Entrada& valor)
+        {
+            asegurarCapacidad(cantidad + 1);
+            std::size_t i = cantidad++;
+            while (i > 0)
+            {
+                std::size_t padre = (i - 1) / 2;
+                if (!antes(valor, datos[padre]))
+                {
+                    break;
+                }
+                datos[i] = datos[padre];
+                i = padre;
+            }
+            datos[i] = valor;
+        }
+
+        void quitarTope()
+        {
+            --cantidad;
+            if (cantidad > 0)
+            {
+                datos[0] = datos[cantidad];
+                hundir(0);
+            }
+        }
+
+        void hundir(std::size_t i)
+        {
+            Entrada valor = datos[i];
+            while (true)
+            {
+                std::size_t hijo = 2 * i + 1;
+                if (hijo >= cantidad)
+                {
+                    break;
+                }
+                if (hijo + 1 < cantidad && antes(datos[hijo + 1], datos[hijo]))
+                {
+                    ++hijo;
+                }
+                if (!antes(datos[hijo], valor))
+                {
+                    break;
+                }
+                datos[i] = datos[hijo];
+                i = hijo;
+            }
+            datos[i] = valor;
+        }
+    };
+
+    static Entrada entradaDe(Nodo<T>* nodo)
+    {
+        return Entrada{nodo->dato, nodo->marca, nodo};
+    }
+
+    /// Criterio de orden: menor (o mayor, según Minimo) valor primero; luego la marca más antigua y el nodo.
+    static bool antes(const Entrada& a, const Entrada& b)
+    {
+        if (a.valor < b.valor || b.valor < a.valor)
+        {
+            return Minimo ? (a.valor < b.valor) : (b.valor < a.valor);
+        }
+        if (a.marca != b.marca)
+        {
+            return a.marca < b.marca;
+        }
+        return std::less<const Nodo<T>*>()(a.nodo, b.nodo);
+    }
+
+    Arreglo vigentes;
+    Arreglo retirados;
+};
+
+#endif
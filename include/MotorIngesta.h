@@ -0,0 +1,397 @@
+/**
+ * @file MotorIngesta.h
+ * @brief Motor de ingesta que atiende varios puertos seriales, pipes o FIFOs con epoll.
+ */
+#ifndef MOTORINGESTA_H
+#define MOTORINGESTA_H
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "AuxiliarCli.h"
+#include "ColaIngesta.h"
+#include "ListaGeneral.h"
+#include "LectorSerial.h"
+
+/**
+ * @brief Multiplexa N fuentes de lecturas ID,valor sobre la misma ListaGeneral.
+ *
+ * Cada fuente conserva su propio BufferLineas, de modo que una línea partida
+ * entre dos lecturas de un puerto nunca se mezcla con bytes de otro. epoll
+ * avisa qué descriptores tienen datos y cada aviso se atiende con un read()
+ * por bloque; una fuente que llega a fin de archivo o falla se retira sola.
+ *
+ * Cada fuente puede enviar texto ID,valor, tramas binarias o ambos mezclados;
+ * el formato se reconoce elemento por elemento. Por fuente se sigue el número
+ * de secuencia de las tramas para reportar las que se perdieron.
+ *
+ * Con establecerCola() el motor solo analiza y enruta: cada lectura se
+ * publica en una ColaIngesta y la inserta el hilo de un ConsumidorIngesta,
+ * de modo que una inserción o un log lentos no detienen la lectura del puerto.
+ */
+class MotorIngesta
+{
+public:
+    /// Número máximo de fuentes simultáneas.
+    static constexpr int MAX_FUENTES = 64;
+
+    /**
+     * @brief Crea el motor sobre la lista de sensores destino.
+     * @param listaDestino Lista donde se buscan los sensores de cada línea.
+     * @param cliLog Auxiliar usado para reportar eventos.
+     */
+    MotorIngesta(ListaGeneral& listaDestino, AuxiliarCli& cliLog)
+        : lista(listaDestino), cli(cliLog), epollFd(epoll_create1(EPOLL_CLOEXEC)), cantidadFuentes(0),
+          lineasTotales(0), tramasRecibidas(0), tramasPerdidas(0), detenido(false)
+    {
+        for (int i = 0; i < MAX_FUENTES; ++i)
+        {
+            fuentes[i] = nullptr;
+        }
+    }
+
+    MotorIngesta(const MotorIngesta&) = delete;
+    MotorIngesta& operator=(const MotorIngesta&) = delete;
+
+    ~MotorIngesta()
+    {
+        for (int i = 0; i < MAX_FUENTES; ++i)
+        {
+            if (fuentes[i])
+            {
+                retirarFuente(fuentes[i], false);
+            }
+        }
+        if (epollFd >= 0)
+        {
+            close(epollFd);
+        }
+    }
+
+    /**
+     * @brief Publica las lecturas en la cola indicada en lugar de insertarlas en los sensores.
+     * @param destino Cola compartida con un ConsumidorIngesta; nullptr vuelve a insertar directamente.
+     *
+     * Con cola, obtenerLineasTotales() cuenta las lecturas que entraron a ella.
+     */
+    void establecerCola(ColaIngesta* destino)
+    {
+        cola = destino;
+    }
+
+    /**
+     * @brief Abre una ruta y la agrega como fuente.
+     * @param ruta Puerto serial, FIFO o cualquier archivo legible.
+     * @param configuracion Parámetros termios aplicados si la ruta es un tty.
+     * @return true si la fuente quedó registrada.
+     *
+     * Los puertos tty se configuran con configurarPuertoSerial(). Las FIFOs se
+     * abren en lectura/escritura para no recibir fin de archivo mientras no haya
+     * un emisor conectado.
+     */
+    bool agregarDispositivo(const char* ruta, const ConfiguracionPuerto& configuracion = ConfiguracionPuerto())
+    {
+        struct stat info;
+        bool esFifo = (stat(ruta, &info) == 0 && S_ISFIFO(info.st_mode));
+
+        int fd = open(ruta, (esFifo ? O_RDWR : O_RDONLY) | O_NOCTTY | O_NONBLOCK);
+        if (fd == -1)
+        {
+            char mensaje[160];
+            std::snprintf(mensaje, sizeof(mensaje), "No se pudo abrir '%s'. Cierra otros monitores y verifica la ruta.", ruta);
+            cli.imprimirLog(NivelLog::Advertencia, mensaje);
+            return false;
+        }
+
+        if (isatty(fd) && !configurarPuertoSerial(fd, cli, configuracion))
+        {
+            close(fd);
+            return false;
+        }
+
+        if (!agregarDescriptor(fd, ruta))
+        {
+            close(fd);
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Registra un descriptor ya abierto; el motor pasa a ser su dueño.
+     * @param fd Descriptor legible (se cambia a modo no bloqueante).
+     * @param etiqueta Nombre usado en los mensajes de log.
+     * @return true si se registró.
+     */
+    bool agregarDescriptor(int fd, const char* etiqueta)
+    {
+        if (epollFd < 0 || cantidadFuentes == MAX_FUENTES)
+        {
+            cli.imprimirLog(NivelLog::Advertencia, "No se pueden registrar más fuentes de ingesta.");
+            return false;
+        }
+
+        // Un descriptor bloqueante detendría el ciclo de epoll entero en el primer read() sin datos.
+        int banderas = fcntl(fd, F_GETFL);
+        if (banderas == -1 || fcntl(fd, F_SETFL, banderas | O_NONBLOCK) == -1)
+        {
+            cli.imprimirLogFormato<NivelLog::Advertencia>("No se pudo pasar '%s' a modo no bloqueante: %s.",
+                                                          etiqueta ? etiqueta : "fuente", std::strerror(errno));
+            return false;
+        }
+
+        Fuente* fuente = new Fuente();
+        fuente->fd = fd;
+        std::snprintf(fuente->etiqueta, sizeof(fuente->etiqueta), "%s", etiqueta ? etiqueta : "fuente");
+
+        struct epoll_event evento;
+        evento.events = EPOLLIN;
+        evento.data.ptr = fuente;
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &evento) != 0)
+        {
+            cli.imprimirLog(NivelLog::Advertencia, "epoll no acepta el descriptor indicado.");
+            delete fuente;
+            return false;
+        }
+
+        for (int i = 0; i < MAX_FUENTES; ++i)
+        {
+            if (!fuentes[i])
+            {
+                fuentes[i] = fuente;
+                fuente->indice = i;
+                break;
+            }
+        }
+        ++cantidadFuentes;
+        return true;
+    }
+
+    /**
+     * @brief Vigila además un descriptor de control (por ejemplo, stdin) para detener el ciclo.
+     * @param fd Descriptor que, al volverse legible, termina ejecutar().
+     */
+    bool vigilarDetencion(int fd)
+    {
+        struct epoll_event evento;
+        evento.events = EPOLLIN;
+        evento.data.ptr = nullptr;
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &evento) != 0)
+        {
+            return false;
+        }
+        fdDetencion = fd;
+        return true;
+    }
+
+    /**
+     * @brief Atiende una ronda de eventos.
+     * @param esperaMs Tiempo máximo de espera (-1 para esperar indefinidamente).
+     * @return Número de lecturas (líneas o lecturas de tramas) entregadas a los sensores en esta ronda.
+     */
+    long long procesarEventos(int esperaMs)
+    {
+        struct epoll_event eventos[MAX_FUENTES + 1];
+        int listos = epoll_wait(epollFd, eventos, MAX_FUENTES + 1, esperaMs);
+        if (listos < 0)
+        {
+            if (errno != EINTR)
+            {
+                cli.imprimirLog(NivelLog::Advertencia, "epoll_wait falló, se detiene la ingesta.");
+                detenido = true;
+            }
+            return 0;
+        }
+
+        long long lineasRonda = 0;
+        for (int i = 0; i < listos; ++i)
+        {
+            Fuente* fuente = static_cast<Fuente*>(eventos[i].data.ptr);
+            if (!fuente)
+            {
+                descartarControl();
+                cli.imprimirLog(NivelLog::Estado, "Ingesta detenida por el usuario.");
+                detenido = true;
+                continue;
+            }
+            lineasRonda += atenderFuente(fuente);
+        }
+        lineasTotales += lineasRonda;
+        return lineasRonda;
+    }
+
+    /**
+     * @brief Atiende eventos hasta que se detenga o no queden fuentes abiertas.
+     * @return Total de lecturas entregadas a sensores durante la ejecución.
+     */
+    long long ejecutar()
+    {
+        while (!detenido && cantidadFuentes > 0)
+        {
+            procesarEventos(-1);
+        }
+        if (cantidadFuentes == 0)
+        {
+            cli.imprimirLog(NivelLog::Estado, "Todas las fuentes se cerraron; fin de la ingesta.");
+        }
+        return lineasTotales;
+    }
+
+    /// Número de fuentes abiertas.
+    int fuentesActivas() const
+    {
+        return cantidadFuentes;
+    }
+
+    /// Lecturas (líneas o lecturas de tramas) entregadas a sensores desde la creación del motor.
+    long long obtenerLineasTotales() const
+    {
+        return lineasTotales;
+    }
+
+    /// Tramas binarias válidas recibidas.
+    long long obtenerTramasRecibidas() const
+    {
+        return tramasRecibidas;
+    }
+
+    /// Tramas que faltaron según los saltos en los números de secuencia.
+    long long obtenerTramasPerdidas() const
+    {
+        return tramasPerdidas;
+    }
+
+private:
+    /// Estado de reensamblado de líneas de una fuente.
+    struct Fuente
+    {
+        int fd = -1;
+        int indice = -1;
+        char etiqueta[80] = {0};
+        BufferLineas buffer;
+        SeguimientoSecuencia secuencia;
+    };
+
+    ListaGeneral& lista;
+    AuxiliarCli& cli;
+    int epollFd;
+    int fdDetencion = -1;
+    Fuente* fuentes[MAX_FUENTES];
+    /// Trama de trabajo reutilizada al atender cualquier fuente.
+    TramaBinaria trama;
+    /// Cola donde se publican las lecturas; nullptr para insertarlas aquí mismo.
+    ColaIngesta* cola = nullptr;
+    int cantidadFuentes;
+    long long lineasTotales;
+    long long tramasRecibidas;
+    long long tramasPerdidas;
+    bool detenido;
+
+    /// Consume la entrada que provocó la detención para que no llegue al menú.
+    void descartarControl()
+    {
+        char descarte[64];
+        if (fdDetencion == STDIN_FILENO)
+        {
+            if (!fgets(descarte, sizeof(descarte), stdin))
+            {
+                clearerr(stdin);
+            }
+            return;
+        }
+        ssize_t leidos = read(fdDetencion, descarte, sizeof(descarte));
+        (void)leidos;
+    }
+
+    /// Lee un bloque de la fuente y enruta las líneas y tramas completas.
+    long long atenderFuente(Fuente* fuente)
+    {
+        ssize_t cantidad = fuente->buffer.leerDesde(fuente->fd);
+        if (cantidad < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+        {
+            return 0;
+        }
+        if (cantidad <= 0)
+        {
+            retirarFuente(fuente, true);
+            return 0;
+        }
+
+        long long lecturas = 0;
+        std::size_t invalidasPrevias = fuente->buffer.obtenerTramasInvalidas();
+        char* linea = nullptr;
+        std::size_t longitud = 0;
+        ElementoEntrada elemento;
+        while ((elemento = fuente->buffer.siguienteElemento(linea, longitud, trama)) != ElementoEntrada::Ninguno)
+        {
+            if (elemento == ElementoEntrada::Linea)
+            {
+                bool entregada = cola ? encolarLineaSerial(lista, linea, longitud, *cola, cli)
+                                      : enrutarLineaSerial(lista, linea, longitud, cli);
+                if (entregada)
+                {
+                    ++lecturas;
+                }
+                continue;
+            }
+
+            registrarSecuencia(fuente, trama.secuencia);
+            lecturas += cola ? encolarTramaBinaria(lista, trama, *cola, cli) : enrutarTramaBinaria(lista, trama, cli);
+        }
+
+        std::size_t invalidas = fuente->buffer.obtenerTramasInvalidas() - invalidasPrevias;
+        if (invalidas > 0)
+        {
+            cli.imprimirLogFormato<NivelLog::Advertencia>("Fuente '%s': %zu tramas binarias descartadas por CRC o formato.",
+                                                          fuente->etiqueta, invalidas);
+        }
+        return lecturas;
+    }
+
+    /// Cuenta la trama y reporta el hueco si su secuencia no es la esperada.
+    void registrarSecuencia(Fuente* fuente, std::uint16_t secuencia)
+    {
+        ++tramasRecibidas;
+        std::uint16_t esperada = fuente->secuencia.esperada;
+        std::uint16_t perdidas = 0;
+        SaltoSecuencia salto = fuente->secuencia.registrar(secuencia, perdidas);
+        if (salto == SaltoSecuencia::Perdidas)
+        {
+            tramasPerdidas += perdidas;
+            cli.imprimirLogFormato<NivelLog::Advertencia>("Fuente '%s': %u tramas perdidas (secuencia %u, se esperaba %u).",
+                                                          fuente->etiqueta, static_cast<unsigned>(perdidas),
+                                                          static_cast<unsigned>(secuencia), static_cast<unsigned>(esperada));
+        }
+        else if (salto == SaltoSecuencia::Resincronizacion)
+        {
+            cli.imprimirLogFormato<NivelLog::Advertencia>("Fuente '%s': secuencia %u fuera de orden (se esperaba %u); se resincroniza.",
+                                                          fuente->etiqueta, static_cast<unsigned>(secuencia),
+                                                          static_cast<unsigned>(esperada));
+        }
+    }
+
+    /// Quita la fuente de epoll, cierra su descriptor y libera su estado.
+    void retirarFuente(Fuente* fuente, bool informar)
+    {
+        if (informar)
+        {
+            char mensaje[160];
+            std::snprintf(mensaje, sizeof(mensaje), "Fuente '%s' cerrada; posible desconexión del dispositivo.", fuente->etiqueta);
+            cli.imprimirLog(NivelLog::Estado, mensaje);
+        }
+
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, fuente->fd, nullptr);
+        close(fuente->fd);
+        fuentes[fuente->indice] = nullptr;
+        --cantidadFuentes;
+        delete fuente;
+    }
+};
+
+#endif
@@ -1,23 +1,34 @@
 /**
  * @file Nodo.h
- * @brief Nodo simple usado por las listas genéricas de sensores.
+ * @brief Nodo doblemente enlazado usado por las listas genéricas de sensores.
  */
 #ifndef NODO_H
 #define NODO_H
 
+#include <cstdint>
+
 /**
- * @brief Nodo sencillo para listas enlazadas.
+ * @brief Nodo para listas enlazadas con enlace al siguiente y al anterior.
  */
 template <typename T>
 struct Nodo
 {
     /// Dato almacenado en este nodo.
     T dato;
+    /// Tramo del IndiceTemporal al que pertenece el nodo (lo mantiene la lista).
+    std::uint32_t tramo;
+    /// Momento de la lectura en nanosegundos del reloj monotónico.
+    std::int64_t marca;
     /// Apuntador al siguiente nodo de la lista.
     Nodo<T>* siguiente;
+    /// Apuntador al nodo previo; cuesta 8 bytes por nodo y permite desenlazar un nodo conocido (el mínimo) sin recorrer la lista.
+    Nodo<T>* anterior;
 
-    /// Construye un nodo con el valor indicado.
-    explicit Nodo(const T& valor) : dato(valor), siguiente(nullptr) {}
+    /// Construye un nodo con el valor y la marca de tiempo indicados.
+    explicit Nodo(const T& valor, std::int64_t marcaNs = 0)
+        : dato(valor), tramo(0), marca(marcaNs), siguiente(nullptr), anterior(nullptr)
+    {
+    }
 };
 
 #endif
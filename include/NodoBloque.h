@@ -0,0 +1,50 @@
+/**
+ * @file NodoBloque.h
+ * @brief Nodo de lista desenrollada que guarda un bloque contiguo de lecturas.
+ */
+#ifndef NODOBLOQUE_H
+#define NODOBLOQUE_H
+
+#include <cstddef>
+
+/**
+ * @brief Nodo que almacena hasta Capacidad lecturas consecutivas.
+ *
+ * Los elementos válidos ocupan datos[inicio, inicio + cantidad), lo que permite
+ * extraer por el frente sin desplazar el resto del bloque.
+ */
+template <typename T, std::size_t Capacidad>
+struct NodoBloque
+{
+    /// Lecturas almacenadas de forma contigua.
+    T datos[Capacidad];
+    /// Índice del primer elemento válido dentro de datos.
+    int inicio;
+    /// Número de elementos válidos en el bloque.
+    int cantidad;
+    /// Apuntador al siguiente bloque de la lista.
+    NodoBloque<T, Capacidad>* siguiente;
+
+    /// Construye un bloque vacío.
+    NodoBloque() : inicio(0), cantidad(0), siguiente(nullptr) {}
+
+    /// Devuelve el apuntador al primer elemento válido.
+    T* primero()
+    {
+        return datos + inicio;
+    }
+
+    /// Versión constante de primero().
+    const T* primero() const
+    {
+        return datos + inicio;
+    }
+
+    /// Indica si ya no caben más elementos al final del bloque.
+    bool estaLleno() const
+    {
+        return inicio + cantidad == static_cast<int>(Capacidad);
+    }
+};
+
+#endif
@@ -0,0 +1,157 @@
+/**
+ * @file PilaPendientes.h
+ * @brief Pila sin bloqueos donde otros hilos dejan lecturas para que el dueño del historial las incorpore.
+ */
+#ifndef PILAPENDIENTES_H
+#define PILAPENDIENTES_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Pila de Treiber con muchos productores y un solo consumidor.
+ *
+ * apilar() usa compare-and-swap y puede llamarse desde cualquier hilo; el
+ * consumidor toma la pila entera con un intercambio atómico, así que ninguno
+ * de los dos lados espera al otro. Como el consumidor nunca saca elementos
+ * sueltos no hay problema ABA.
+ *
+ * Cada elemento de la pila es un lote: apilarLote() copia los valores y las
+ * marcas en dos arreglos y publica el lote completo, y consumir() lo entrega
+ * tal cual para que el historial lo anexe con su propio insertarLote(). Así
+ * la copia intermedia cuesta tres reservas por lote en lugar de una por
+ * lectura. apilar() publica un lote de una lectura sin arreglos aparte.
+ */
+template <typename T>
+class PilaPendientes
+{
+public:
+    PilaPendientes() : tope(nullptr) {}
+    PilaPendientes(const PilaPendientes&) = delete;
+    PilaPendientes& operator=(const PilaPendientes&) = delete;
+
+    ~PilaPendientes()
+    {
+        descartar();
+    }
+
+    /// Deja un valor pendiente con su marca de tiempo; seguro desde varios hilos a la vez.
+    void apilar(const T& valor, std::int64_t marca = 0)
+    {
+        Lote* nuevo = new Lote();
+        nuevo->valorUnico = valor;
+        nuevo->marcaUnica = marca;
+        nuevo->valores = &nuevo->valorUnico;
+        nuevo->marcas = &nuevo->marcaUnica;
+        nuevo->cantidad = 1;
+        publicar(nuevo);
+    }
+
+    /**
+     * @brief Deja varios valores pendientes con un solo compare-and-swap.
+     *
+     * consumir() los entrega juntos y en el orden del arreglo.
+     */
+    void apilarLote(const T* valores, const std::int64_t* marcas, std::size_t cantidad)
+    {
+        if (cantidad == 0)
+        {
+            return;
+        }
+
+        Lote* nuevo = new Lote();
+        nuevo->valores = new T[cantidad];
+        nuevo->marcas = new std::int64_t[cantidad];
+        for (std::size_t i = 0; i < cantidad; ++i)
+        {
+            nuevo->valores[i] = valores[i];
+            nuevo->marcas[i] = marcas[i];
+        }
+        nuevo->cantidad = cantidad;
+        publicar(nuevo);
+    }
+
+    /**
+     * @brief Entrega al consumidor todos los lotes pendientes en orden de llegada.
+     * @param funcion Invocable con firma void(const T* valores, const std::int64_t* marcas, std::size_t cantidad).
+     * @return Número de valores entregados.
+     */
+    template <typename Funcion>
+    int consumir(Funcion&& funcion)
+    {
+        if (!tope.load(std::memory_order_relaxed))
+        {
+            return 0;
+        }
+
+        Lote* pila = tope.exchange(nullptr, std::memory_order_acquire);
+        Lote* enOrden = nullptr;
+        while (pila)
+        {
+            Lote* siguiente = pila->siguiente;
+            pila->siguiente = enOrden;
+            enOrden = pila;
+            pila = siguiente;
+        }
+
+        int entregados = 0;
+        while (enOrden)
+        {
+            Lote* siguiente = enOrden->siguiente;
+            funcion(static_cast<const T*>(enOrden->valores), static_cast<const std::int64_t*>(enOrden->marcas),
+                    enOrden->cantidad);
+            entregados += static_cast<int>(enOrden->cantidad);
+            destruir(enOrden);
+            enOrden = siguiente;
+        }
+        return entregados;
+    }
+
+    /// Libera los valores pendientes sin entregarlos.
+    void descartar()
+    {
+        Lote* pendiente = tope.exchange(nullptr, std::memory_order_acquire);
+        while (pendiente)
+        {
+            Lote* siguiente = pendiente->siguiente;
+            destruir(pendiente);
+            pendiente = siguiente;
+        }
+    }
+
+private:
+    /// Lecturas publicadas juntas; con una sola lectura los arreglos apuntan a los campos únicos.
+    struct Lote
+    {
+        Lote* siguiente = nullptr;
+        std::size_t cantidad = 0;
+        T* valores = nullptr;
+        std::int64_t* marcas = nullptr;
+        T valorUnico = T();
+        std::int64_t marcaUnica = 0;
+    };
+
+    std::atomic<Lote*> tope;
+
+    void publicar(Lote* nuevo)
+    {
+        Lote* actual = tope.load(std::memory_order_relaxed);
+        do
+        {
+            nuevo->siguiente = actual;
+        } while (!tope.compare_exchange_weak(actual, nuevo, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    static void destruir(Lote* lote)
+    {
+        if (lote->valores != &lote->valorUnico)
+        {
+            delete[] lote->valores;
+            delete[] lote->marcas;
+        }
+        delete lote;
+    }
+};
+
+#endif
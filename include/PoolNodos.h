@@ -0,0 +1,300 @@
+/**
+ * @file PoolNodos.h
+ * @brief Asignadores de nodos para ListaSensor: heap directo y pool por bloques.
+ */
+#ifndef POOLNODOS_H
+#define POOLNODOS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include "Nodo.h"
+
+/**
+ * @brief Asignador que reserva cada nodo con new/delete (comportamiento clásico).
+ */
+template <typename T>
+class AsignadorHeap
+{
+public:
+    /// Indica que este asignador no puede liberar todos sus nodos de una sola vez.
+    static constexpr bool liberacionMasiva = false;
+
+    AsignadorHeap() = default;
+    AsignadorHeap(const AsignadorHeap&) = delete;
+    AsignadorHeap& operator=(const AsignadorHeap&) = delete;
+
+    /// Reserva y construye un nodo con el valor y la marca indicados.
+    Nodo<T>* crear(const T& valor, std::int64_t marca = 0)
+    {
+        return new Nodo<T>(valor, marca);
+    }
+
+    /// Destruye y libera un nodo individual.
+    void destruir(Nodo<T>* nodo)
+    {
+        delete nodo;
+    }
+
+    /// Sin efecto: cada nodo se reserva por separado en crear().
+    void reservar(std::size_t) {}
+
+    /// Sin efecto: cada nodo se libera individualmente con destruir().
+    void liberarTodo() {}
+
+    /// Sin efecto: los nodos del heap no pertenecen a ningún asignador.
+    void absorber(AsignadorHeap&) {}
+
+    /// Bytes reservados a través de este asignador (no se contabilizan).
+    std::size_t bytesReservados() const
+    {
+        return 0;
+    }
+};
+
+/**
+ * @brief Pool de nodos que reserva memoria en bloques y recicla los nodos liberados.
+ *
+ * Cada bloque duplica el tamaño del anterior (hasta NodosMaximosPorBloque), de modo
+ * que un historial corto apenas reserva memoria y uno largo hace muy pocas
+ * llamadas al sistema de memoria. Los nodos liberados pasan a una lista libre
+ * que se reutiliza antes de tocar un bloque nuevo.
+ */
+template <typename T, std::size_t NodosMaximosPorBloque = 4096>
+class PoolNodos
+{
+public:
+    /// Indica que liberarTodo() devuelve todos los bloques sin recorrer los nodos.
+    static constexpr bool liberacionMasiva = true;
+
+    PoolNodos()
+        : bloques(nullptr), ultimoBloque(nullptr), libres(nullptr), ultimaLibre(nullptr), usadosEnBloque(0),
+          capacidadBloque(0), totalBytes(0)
+    {
+    }
+
+    PoolNodos(const PoolNodos&) = delete;
+    PoolNodos& operator=(const PoolNodos&) = delete;
+
+    ~PoolNodos()
+    {
+        liberarTodo();
+    }
+
+    /// Construye un nodo en una ranura libre o en el bloque activo.
+    Nodo<T>* crear(const T& valor, std::int64_t marca = 0)
+    {
+        void* memoria = nullptr;
+        if (libres)
+        {
+            memoria = libres;
+            libres = libres->siguiente;
+            if (!libres)
+            {
+                ultimaLibre = nullptr;
+            }
+        }
+        else
+        {
+            if (!bloques || usadosEnBloque == capacidadBloque)
+            {
+                reservarBloque();
+            }
+            memoria = bloques->ranuras() + usadosEnBloque * sizeof(Nodo<T>);
+            ++usadosEnBloque;
+        }
+        return new (memoria) Nodo<T>(valor, marca);
+    }
+
+    /**
+     * @brief Prepara lugar para los próximos n nodos con a lo sumo una reserva de memoria.
+     *
+     * Si hay ranuras recicladas no hace nada: crear() las usa primero. Si al
+     * bloque activo no le caben n nodos, sus ranuras restantes pasan a la
+     * lista libre y se pide un solo bloque con lugar para el resto (sin
+     * superar NodosMaximosPorBloque), en vez de ir duplicando desde el tamaño
+     * actual con una reserva por bloque.
+     */
+    void reservar(std::size_t n)
+    {
+        if (libres || (bloques && capacidadBloque - usadosEnBloque >= n))
+        {
+            return;
+        }
+
+        std::size_t restantes = n;
+        while (bloques && usadosEnBloque < capacidadBloque)
+        {
+            Ranura* ranura = reinterpret_cast<Ranura*>(bloques->ranuras() + usadosEnBloque * sizeof(Nodo<T>));
+            ranura->siguiente = libres;
+            libres = ranura;
+            if (!ultimaLibre)
+            {
+                ultimaLibre = ranura;
+            }
+            ++usadosEnBloque;
+            --restantes;
+        }
+        reservarBloque(restantes);
+    }
+
+    /// Destruye el nodo y deja su ranura disponible para reutilizarse.
+    void destruir(Nodo<T>* nodo)
+    {
+        if (!nodo)
+        {
+            return;
+        }
+
+        nodo->~Nodo<T>();
+        Ranura* ranura = reinterpret_cast<Ranura*>(nodo);
+        ranura->siguiente = libres;
+        libres = ranura;
+        if (!ultimaLibre)
+        {
+            ultimaLibre = ranura;
+        }
+    }
+
+    /**
+     * @brief Toma en O(1) todos los bloques y ranuras libres de otro pool, que queda vacío.
+     *
+     * Permite pasar nodos de una lista a otra sin copiarlos: los nodos siguen
+     * donde estaban, pero ahora los libera este pool. Si este pool ya tenía un
+     * bloque activo, lo que quedaba sin usar del bloque activo del otro no se
+     * reparte hasta liberarTodo().
+     */
+    void absorber(PoolNodos& otro)
+    {
+        if (&otro == this || !otro.bloques)
+        {
+            return;
+        }
+
+        if (!bloques)
+        {
+            bloques = otro.bloques;
+            usadosEnBloque = otro.usadosEnBloque;
+            capacidadBloque = otro.capacidadBloque;
+        }
+        else
+        {
+            ultimoBloque->siguiente = otro.bloques;
+        }
+        ultimoBloque = otro.ultimoBloque;
+
+        if (otro.libres)
+        {
+            otro.ultimaLibre->siguiente = libres;
+            libres = otro.libres;
+            if (!ultimaLibre)
+            {
+                ultimaLibre = otro.ultimaLibre;
+            }
+        }
+        totalBytes += otro.totalBytes;
+
+        otro.bloques = nullptr;
+        otro.ultimoBloque = nullptr;
+        otro.libres = nullptr;
+        otro.ultimaLibre = nullptr;
+        otro.usadosEnBloque = 0;
+        otro.capacidadBloque = 0;
+        otro.totalBytes = 0;
+    }
+
+    /**
+     * @brief Devuelve todos los bloques de una sola vez.
+     *
+     * No invoca destructores: quien lo usa debe haber destruido antes los nodos
+     * vivos si T no es trivialmente destructible.
+     */
+    void liberarTodo()
+    {
+        Bloque* actual = bloques;
+        while (actual)
+        {
+            Bloque* siguiente = actual->siguiente;
+            ::operator delete(actual);
+            actual = siguiente;
+        }
+        bloques = nullptr;
+        ultimoBloque = nullptr;
+        libres = nullptr;
+        ultimaLibre = nullptr;
+        usadosEnBloque = 0;
+        capacidadBloque = 0;
+        totalBytes = 0;
+    }
+
+    /// Bytes solicitados al sistema para los bloques vigentes.
+    std::size_t bytesReservados() const
+    {
+        return totalBytes;
+    }
+
+private:
+    /// Ranura libre reinterpretada como eslabón de la lista libre.
+    struct Ranura
+    {
+        Ranura* siguiente;
+    };
+
+    /// Encabezado de bloque; las ranuras se ubican inmediatamente después.
+    struct Bloque
+    {
+        Bloque* siguiente;
+
+        unsigned char* ranuras()
+        {
+            return reinterpret_cast<unsigned char*>(this) + desplazamientoRanuras;
+        }
+    };
+
+    static_assert(sizeof(Nodo<T>) >= sizeof(Ranura), "Nodo<T> debe poder alojar un apuntador de la lista libre.");
+
+    /// Desplazamiento de la primera ranura respetando la alineación de Nodo<T>.
+    static constexpr std::size_t desplazamientoRanuras =
+        ((sizeof(Bloque) + alignof(Nodo<T>) - 1) / alignof(Nodo<T>)) * alignof(Nodo<T>);
+
+    /// Primer tamaño de bloque; los siguientes crecen al doble.
+    static constexpr std::size_t NodosInicialesPorBloque = 16;
+
+    /// Bloques del más nuevo (el activo) al más viejo.
+    Bloque* bloques;
+    Bloque* ultimoBloque;
+    /// Lista libre; ultimaLibre permite encadenarle la de otro pool.
+    Ranura* libres;
+    Ranura* ultimaLibre;
+    std::size_t usadosEnBloque;
+    std::size_t capacidadBloque;
+    std::size_t totalBytes;
+
+    /// Solicita un bloque nuevo, el doble de grande que el anterior o de al menos minimo nodos.
+    void reservarBloque(std::size_t minimo = 0)
+    {
+        std::size_t nodos = (capacidadBloque == 0) ? NodosInicialesPorBloque : capacidadBloque * 2;
+        if (nodos < minimo)
+        {
+            nodos = minimo;
+        }
+        if (nodos > NodosMaximosPorBloque)
+        {
+            nodos = NodosMaximosPorBloque;
+        }
+
+        std::size_t bytes = desplazamientoRanuras + nodos * sizeof(Nodo<T>);
+        Bloque* nuevo = static_cast<Bloque*>(::operator new(bytes));
+        nuevo->siguiente = bloques;
+        bloques = nuevo;
+        if (!ultimoBloque)
+        {
+            ultimoBloque = nuevo;
+        }
+        usadosEnBloque = 0;
+        capacidadBloque = nodos;
+        totalBytes += bytes;
+    }
+};
+
+#endif
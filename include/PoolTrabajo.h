@@ -0,0 +1,264 @@
+/**
+ * @file PoolTrabajo.h
+ * @brief Pool de hilos con robo de trabajo para recorrer rangos de índices en paralelo.
+ */
+#ifndef POOLTRABAJO_H
+#define POOLTRABAJO_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief Ejecuta tareas independientes indexadas 0..n-1 sobre varios hilos.
+ *
+ * Cada participante recibe un tramo contiguo de índices guardado en un solo
+ * entero atómico (inicio en los 32 bits altos, fin en los bajos). El dueño
+ * toma índices del frente con compare-and-swap; cuando se queda sin trabajo
+ * roba la mitad final del tramo de otro participante con el mismo CAS, así
+ * que ningún índice se ejecuta dos veces y no hay mutex en el camino de las
+ * tareas. El hilo que llama a paraCada() participa como trabajador 0.
+ */
+class PoolTrabajo
+{
+public:
+    /// Máximo de participantes (incluido el hilo que llama).
+    static constexpr unsigned MAX_HILOS = 64;
+
+    /**
+     * @brief Arranca los hilos trabajadores.
+     * @param hilos Participantes totales; 0 usa std::thread::hardware_concurrency().
+     */
+    explicit PoolTrabajo(unsigned hilos = 0)
+        : cantidadHilos(ajustarHilos(hilos)), generacion(0), detener(false), activos(0), tarea(nullptr),
+          contexto(nullptr), robos(0)
+    {
+        for (unsigned i = 0; i < MAX_HILOS; ++i)
+        {
+            tramos[i].valor.store(0, std::memory_order_relaxed);
+        }
+        for (unsigned i = 1; i < cantidadHilos; ++i)
+        {
+            trabajadores[i] = std::thread(&PoolTrabajo::ejecutarTrabajador, this, i);
+        }
+    }
+
+    PoolTrabajo(const PoolTrabajo&) = delete;
+    PoolTrabajo& operator=(const PoolTrabajo&) = delete;
+
+    ~PoolTrabajo()
+    {
+        {
+            std::lock_guard<std::mutex> guardia(mutexPool);
+            detener = true;
+        }
+        hayTrabajo.notify_all();
+        for (unsigned i = 1; i < cantidadHilos; ++i)
+        {
+            trabajadores[i].join();
+        }
+    }
+
+    /// Participantes que reparten cada recorrido.
+    unsigned obtenerHilos() const
+    {
+        return cantidadHilos;
+    }
+
+    /// Tramos robados desde la creación del pool.
+    std::uint64_t obtenerRobos() const
+    {
+        return robos.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Invoca funcion(i) para cada i en [0, cantidad) y regresa al terminar todas.
+     * @param cantidad Número de índices (menor que 2^32).
+     * @param funcion Invocable con firma void(std::size_t); no debe lanzar excepciones.
+     *
+     * El orden de ejecución no está definido; quien necesite resultados en orden
+     * debe guardarlos por índice.
+     */
+    template <typename Funcion>
+    void paraCada(std::size_t cantidad, Funcion& funcion)
+    {
+        if (cantidad == 0)
+        {
+            return;
+        }
+        if (cantidadHilos == 1 || cantidad == 1)
+        {
+            for (std::size_t i = 0; i < cantidad; ++i)
+            {
+                funcion(i);
+            }
+            return;
+        }
+
+        std::uint32_t total = static_cast<std::uint32_t>(cantidad);
+        for (unsigned i = 0; i < cantidadHilos; ++i)
+        {
+            std::uint32_t inicio = static_cast<std::uint32_t>(static_cast<std::uint64_t>(total) * i / cantidadHilos);
+            std::uint32_t fin = static_cast<std::uint32_t>(static_cast<std::uint64_t>(total) * (i + 1) / cantidadHilos);
+            tramos[i].valor.store(empaquetar(inicio, fin), std::memory_order_relaxed);
+        }
+
+        {
+            std::lock_guard<std::mutex> guardia(mutexPool);
+            tarea = &PoolTrabajo::invocar<Funcion>;
+            contexto = &funcion;
+            activos = cantidadHilos - 1;
+            ++generacion;
+        }
+        hayTrabajo.notify_all();
+
+        trabajar(0);
+
+        std::unique_lock<std::mutex> candado(mutexPool);
+        terminado.wait(candado, [this]() { return activos == 0; });
+        tarea = nullptr;
+        contexto = nullptr;
+    }
+
+private:
+    /// Tramo de un participante en su propia línea de caché.
+    struct alignas(64) Tramo
+    {
+        std::atomic<std::uint64_t> valor;
+    };
+
+    unsigned cantidadHilos;
+    Tramo tramos[MAX_HILOS];
+    std::thread trabajadores[MAX_HILOS];
+
+    std::mutex mutexPool;
+    std::condition_variable hayTrabajo;
+    std::condition_variable terminado;
+    std::uint64_t generacion;
+    bool detener;
+    unsigned activos;
+    void (*tarea)(void*, std::size_t);
+    void* contexto;
+    std::atomic<std::uint64_t> robos;
+
+    static unsigned ajustarHilos(unsigned hilos)
+    {
+        if (hilos == 0)
+        {
+            hilos = std::thread::hardware_concurrency();
+        }
+        if (hilos == 0)
+        {
+            hilos = 1;
+        }
+        return (hilos > MAX_HILOS) ? MAX_HILOS : hilos;
+    }
+
+    static std::uint64_t empaquetar(std::uint32_t inicio, std::uint32_t fin)
+    {
+        return (static_cast<std::uint64_t>(inicio) << 32) | fin;
+    }
+
+    static std::uint32_t inicioDe(std::uint64_t tramo)
+    {
+        return static_cast<std::uint32_t>(tramo >> 32);
+    }
+
+    static std::uint32_t finDe(std::uint64_t tramo)
+    {
+        return static_cast<std::uint32_t>(tramo);
+    }
+
+    template <typename Funcion>
+    static void invocar(void* contexto, std::size_t indice)
+    {
+        (*static_cast<Funcion*>(contexto))(indice);
+    }
+
+    /// Toma el siguiente índice del frente del tramo propio.
+    bool tomarPropio(unsigned yo, std::uint32_t& indice)
+    {
+        std::atomic<std::uint64_t>& propio = tramos[yo].valor;
+        std::uint64_t actual = propio.load(std::memory_order_acquire);
+        while (inicioDe(actual) < finDe(actual))
+        {
+            if (propio.compare_exchange_weak(actual, empaquetar(inicioDe(actual) + 1, finDe(actual)),
+                                             std::memory_order_acq_rel))
+            {
+                indice = inicioDe(actual);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Roba la mitad final del tramo de otro participante y la adopta como propia.
+    bool robar(unsigned yo)
+    {
+        for (unsigned paso = 1; paso < cantidadHilos; ++paso)
+        {
+            std::atomic<std::uint64_t>& victima = tramos[(yo + paso) % cantidadHilos].valor;
+            std::uint64_t actual = victima.load(std::memory_order_acquire);
+            while (inicioDe(actual) < finDe(actual))
+            {
+                std::uint32_t inicio = inicioDe(actual);
+                std::uint32_t fin = finDe(actual);
+                std::uint32_t mitad = inicio + (fin - inicio) / 2;
+                if (victima.compare_exchange_weak(actual, empaquetar(inicio, mitad), std::memory_order_acq_rel))
+                {
+                    tramos[yo].valor.store(empaquetar(mitad, fin), std::memory_order_release);
+                    robos.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    /// Ejecuta índices propios y robados hasta que no quede trabajo sin tomar.
+    void trabajar(unsigned yo)
+    {
+        std::uint32_t indice = 0;
+        do
+        {
+            while (tomarPropio(yo, indice))
+            {
+                tarea(contexto, indice);
+            }
+        } while (robar(yo));
+    }
+
+    void ejecutarTrabajador(unsigned yo)
+    {
+        std::uint64_t vista = 0;
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> candado(mutexPool);
+                hayTrabajo.wait(candado, [this, vista]() { return detener || generacion != vista; });
+                if (detener)
+                {
+                    return;
+                }
+                vista = generacion;
+            }
+
+            trabajar(yo);
+
+            bool ultimo = false;
+            {
+                std::lock_guard<std::mutex> guardia(mutexPool);
+                ultimo = (--activos == 0);
+            }
+            if (ultimo)
+            {
+                terminado.notify_one();
+            }
+        }
+    }
+};
+
+#endif
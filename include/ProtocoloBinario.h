@@ -0,0 +1,336 @@
+/**
+ * @file ProtocoloBinario.h
+ * @brief Tramas binarias con sincronía, secuencia y CRC que agrupan varias lecturas de sensores.
+ */
+#ifndef PROTOCOLOBINARIO_H
+#define PROTOCOLOBINARIO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * Formato de una trama (todos los enteros en little-endian):
+ *
+ * | Bytes | Campo                                                    |
+ * |-------|----------------------------------------------------------|
+ * | 1     | Sincronía 0xA5                                           |
+ * | 1     | Cantidad de lecturas (1..MAX_LECTURAS_TRAMA)             |
+ * | 2     | Número de secuencia (uint16, aumenta 1 por trama)        |
+ * | 7 × n | Lecturas: id (uint16), tipo (uint8), valor (4 bytes)     |
+ * | 2     | CRC-16/CCITT-FALSE de todo lo anterior sin la sincronía  |
+ *
+ * El tipo es la letra del sensor y fija cómo leer el valor: 'T' es un float
+ * IEEE-754 y 'P' un int32. El par (tipo, id) corresponde al sensor cuyo
+ * nombre es "<tipo>-<id>", por ejemplo ('T', 1) es "T-001".
+ *
+ * El texto ID,valor es ASCII, así que el byte 0xA5 nunca inicia una línea
+ * válida; eso permite mezclar ambos formatos en la misma fuente.
+ */
+
+/// Byte que abre cada trama.
+constexpr unsigned char SINCRONIA_TRAMA = 0xA5;
+/// Máximo de lecturas agrupadas en una trama.
+constexpr std::size_t MAX_LECTURAS_TRAMA = 32;
+/// Bytes de sincronía, cantidad y secuencia.
+constexpr std::size_t TAM_ENCABEZADO_TRAMA = 4;
+/// Bytes que ocupa cada lectura dentro de la trama.
+constexpr std::size_t TAM_LECTURA_TRAMA = 7;
+/// Bytes del CRC final.
+constexpr std::size_t TAM_CRC_TRAMA = 2;
+/// Tamaño de la trama más grande posible.
+constexpr std::size_t TAM_MAX_TRAMA = TAM_ENCABEZADO_TRAMA + MAX_LECTURAS_TRAMA * TAM_LECTURA_TRAMA + TAM_CRC_TRAMA;
+
+/// Lectura transportada en una trama.
+struct LecturaBinaria
+{
+    /// Parte numérica del nombre del sensor.
+    std::uint16_t id = 0;
+    /// Letra del sensor: 'T' (float) o 'P' (int32).
+    char tipo = 0;
+    /// Valor ya convertido; float e int32 se representan exactamente.
+    double valor = 0.0;
+};
+
+/// Contenido decodificado de una trama.
+struct TramaBinaria
+{
+    std::uint16_t secuencia = 0;
+    std::size_t cantidad = 0;
+    LecturaBinaria lecturas[MAX_LECTURAS_TRAMA];
+};
+
+/// Resultado de intentar decodificar una trama al inicio de un buffer.
+enum class ResultadoTrama
+{
+    /// La trama estaba completa y su CRC coincide.
+    Completa,
+    /// Faltan bytes; hay que esperar más datos.
+    Incompleta,
+    /// No es una trama válida; conviene avanzar un byte y volver a buscar la sincronía.
+    Invalida
+};
+
+/// Cómo encaja la secuencia de una trama con la que se esperaba.
+enum class SaltoSecuencia
+{
+    /// Es la trama esperada (o la primera de la fuente).
+    Ninguno,
+    /// Adelantó hasta medio espacio de 16 bits; las intermedias se dan por perdidas.
+    Perdidas,
+    /// Retrocedió o saltó más de medio espacio: reinicio del emisor o duplicado; no se cuentan pérdidas.
+    Resincronizacion
+};
+
+/**
+ * @brief Sigue los números de secuencia de una fuente de tramas.
+ *
+ * La secuencia es de 16 bits y da la vuelta, así que un salto hacia atrás
+ * se ve como un adelanto enorme. Los saltos de más de medio espacio se
+ * toman como resincronización en lugar de miles de tramas perdidas.
+ */
+struct SeguimientoSecuencia
+{
+    /// Mayor adelanto que todavía se interpreta como tramas perdidas.
+    static constexpr std::uint16_t MAX_ADELANTO = 0x8000;
+
+    /// Secuencia que se espera en la siguiente trama (válida si hayTramas).
+    std::uint16_t esperada = 0;
+    bool hayTramas = false;
+
+    /// Olvida la secuencia esperada; la siguiente trama se acepta sin comparar.
+    void reiniciar()
+    {
+        hayTramas = false;
+    }
+
+    /**
+     * @brief Registra la trama y clasifica el salto respecto de la esperada.
+     * @param perdidas Tramas que faltaron; 0 salvo con SaltoSecuencia::Perdidas.
+     */
+    SaltoSecuencia registrar(std::uint16_t secuencia, std::uint16_t& perdidas)
+    {
+        std::uint16_t salto = static_cast<std::uint16_t>(secuencia - esperada);
+        bool habiaTramas = hayTramas;
+        esperada = static_cast<std::uint16_t>(secuencia + 1);
+        hayTramas = true;
+        perdidas = 0;
+        if (!habiaTramas || salto == 0)
+        {
+            return SaltoSecuencia::Ninguno;
+        }
+        if (salto > MAX_ADELANTO)
+        {
+            return SaltoSecuencia::Resincronizacion;
+        }
+        perdidas = salto;
+        return SaltoSecuencia::Perdidas;
+    }
+};
+
+/// Indica si el tipo de lectura está definido por el protocolo.
+inline bool tipoLecturaValido(char tipo)
+{
+    return tipo == 'T' || tipo == 'P';
+}
+
+/**
+ * @brief CRC-16/CCITT-FALSE (polinomio 0x1021, valor inicial 0xFFFF).
+ *
+ * Procesa cuatro bytes por iteración con cuatro tablas ("slicing-by-4"): las
+ * cuatro consultas son independientes entre sí, mientras que la versión de
+ * una tabla encadena cada byte con el anterior. Da el mismo resultado que el
+ * cálculo bit a bit del emisor.
+ */
+inline std::uint16_t calcularCrc16(const unsigned char* datos, std::size_t cantidad)
+{
+    struct Tablas
+    {
+        /// valores[k][x]: CRC del byte x seguido de k bytes en cero.
+        std::uint16_t valores[4][256];
+
+        Tablas()
+        {
+            for (unsigned i = 0; i < 256; ++i)
+            {
+                std::uint16_t crc = static_cast<std::uint16_t>(i << 8);
+                for (int bit = 0; bit < 8; ++bit)
+                {
+                    crc = static_cast<std::uint16_t>((crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1));
+                }
+                valores[0][i] = crc;
+            }
+            for (int k = 1; k < 4; ++k)
+            {
+                for (unsigned i = 0; i < 256; ++i)
+                {
+                    std::uint16_t previo = valores[k - 1][i];
+                    valores[k][i] = static_cast<std::uint16_t>((previo << 8) ^ valores[0][previo >> 8]);
+                }
+            }
+        }
+    };
+    static const Tablas tablas;
+
+    std::uint16_t crc = 0xFFFF;
+    std::size_t i = 0;
+    for (; i + 4 <= cantidad; i += 4)
+    {
+        crc ^= static_cast<std::uint16_t>((datos[i] << 8) | datos[i + 1]);
+        crc = static_cast<std::uint16_t>(tablas.valores[3][crc >> 8] ^ tablas.valores[2][crc & 0xFF] ^
+                                         tablas.valores[1][datos[i + 2]] ^ tablas.valores[0][datos[i + 3]]);
+    }
+    for (; i < cantidad; ++i)
+    {
+        crc = static_cast<std::uint16_t>((crc << 8) ^ tablas.valores[0][((crc >> 8) ^ datos[i]) & 0xFF]);
+    }
+    return crc;
+}
+
+/// Lee un uint16 little-endian.
+inline std::uint16_t leerU16(const unsigned char* datos)
+{
+    return static_cast<std::uint16_t>(datos[0] | (datos[1] << 8));
+}
+
+/// Lee un uint32 little-endian.
+inline std::uint32_t leerU32(const unsigned char* datos)
+{
+    return static_cast<std::uint32_t>(datos[0]) | (static_cast<std::uint32_t>(datos[1]) << 8) |
+           (static_cast<std::uint32_t>(datos[2]) << 16) | (static_cast<std::uint32_t>(datos[3]) << 24);
+}
+
+/// Escribe un uint16 little-endian.
+inline void escribirU16(unsigned char* destino, std::uint16_t valor)
+{
+    destino[0] = static_cast<unsigned char>(valor);
+    destino[1] = static_cast<unsigned char>(valor >> 8);
+}
+
+/// Escribe un uint32 little-endian.
+inline void escribirU32(unsigned char* destino, std::uint32_t valor)
+{
+    destino[0] = static_cast<unsigned char>(valor);
+    destino[1] = static_cast<unsigned char>(valor >> 8);
+    destino[2] = static_cast<unsigned char>(valor >> 16);
+    destino[3] = static_cast<unsigned char>(valor >> 24);
+}
+
+/**
+ * @brief Decodifica la trama que empieza en datos[0].
+ * @param datos Bytes recibidos; datos[0] debería ser SINCRONIA_TRAMA.
+ * @param disponibles Bytes válidos a partir de datos.
+ * @param trama Recibe las lecturas si el resultado es Completa.
+ * @param consumidos Recibe la longitud de la trama si el resultado es Completa.
+ *
+ * Una cantidad fuera de rango, un tipo desconocido o un CRC distinto hacen
+ * la trama Invalida sin esperar más bytes de los necesarios para saberlo.
+ */
+inline ResultadoTrama decodificarTrama(const unsigned char* datos, std::size_t disponibles, TramaBinaria& trama,
+                                       std::size_t& consumidos)
+{
+    if (disponibles == 0)
+    {
+        return ResultadoTrama::Incompleta;
+    }
+    if (datos[0] != SINCRONIA_TRAMA)
+    {
+        return ResultadoTrama::Invalida;
+    }
+    if (disponibles < 2)
+    {
+        return ResultadoTrama::Incompleta;
+    }
+
+    std::size_t cantidad = datos[1];
+    if (cantidad == 0 || cantidad > MAX_LECTURAS_TRAMA)
+    {
+        return ResultadoTrama::Invalida;
+    }
+
+    std::size_t longitud = TAM_ENCABEZADO_TRAMA + cantidad * TAM_LECTURA_TRAMA + TAM_CRC_TRAMA;
+    if (disponibles < longitud)
+    {
+        return ResultadoTrama::Incompleta;
+    }
+
+    std::size_t cubierto = longitud - TAM_CRC_TRAMA;
+    if (calcularCrc16(datos + 1, cubierto - 1) != leerU16(datos + cubierto))
+    {
+        return ResultadoTrama::Invalida;
+    }
+
+    trama.secuencia = leerU16(datos + 2);
+    trama.cantidad = cantidad;
+    const unsigned char* lectura = datos + TAM_ENCABEZADO_TRAMA;
+    for (std::size_t i = 0; i < cantidad; ++i, lectura += TAM_LECTURA_TRAMA)
+    {
+        LecturaBinaria& destino = trama.lecturas[i];
+        destino.id = leerU16(lectura);
+        destino.tipo = static_cast<char>(lectura[2]);
+        std::uint32_t bits = leerU32(lectura + 3);
+        if (destino.tipo == 'T')
+        {
+            float valor;
+            std::memcpy(&valor, &bits, sizeof(valor));
+            destino.valor = valor;
+        }
+        else if (destino.tipo == 'P')
+        {
+            destino.valor = static_cast<std::int32_t>(bits);
+        }
+        else
+        {
+            return ResultadoTrama::Invalida;
+        }
+    }
+
+    consumidos = longitud;
+    return ResultadoTrama::Completa;
+}
+
+/**
+ * @brief Arma una trama con las lecturas indicadas (lado emisor; lo usan pruebas, bench y reproducción).
+ * @param destino Debe tener espacio para TAM_MAX_TRAMA bytes.
+ * @return Bytes escritos, o 0 si la cantidad o algún tipo no son válidos.
+ */
+inline std::size_t codificarTrama(const LecturaBinaria* lecturas, std::size_t cantidad, std::uint16_t secuencia,
+                                  unsigned char* destino)
+{
+    if (!lecturas || cantidad == 0 || cantidad > MAX_LECTURAS_TRAMA)
+    {
+        return 0;
+    }
+
+    destino[0] = SINCRONIA_TRAMA;
+    destino[1] = static_cast<unsigned char>(cantidad);
+    escribirU16(destino + 2, secuencia);
+
+    unsigned char* lectura = destino + TAM_ENCABEZADO_TRAMA;
+    for (std::size_t i = 0; i < cantidad; ++i, lectura += TAM_LECTURA_TRAMA)
+    {
+        std::uint32_t bits = 0;
+        if (lecturas[i].tipo == 'T')
+        {
+            float valor = static_cast<float>(lecturas[i].valor);
+            std::memcpy(&bits, &valor, sizeof(bits));
+        }
+        else if (lecturas[i].tipo == 'P')
+        {
+            bits = static_cast<std::uint32_t>(static_cast<std::int32_t>(lecturas[i].valor));
+        }
+        else
+        {
+            return 0;
+        }
+        escribirU16(lectura, lecturas[i].id);
+        lectura[2] = static_cast<unsigned char>(lecturas[i].tipo);
+        escribirU32(lectura + 3, bits);
+    }
+
+    std::size_t cubierto = static_cast<std::size_t>(lectura - destino);
+    escribirU16(lectura, calcularCrc16(destino + 1, cubierto - 1));
+    return cubierto + TAM_CRC_TRAMA;
+}
+
+#endif
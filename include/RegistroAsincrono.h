@@ -0,0 +1,476 @@
+/**
+ * @file RegistroAsincrono.h
+ * @brief Backend de logs con niveles, cola sin bloqueos y un hilo escritor que agrupa las escrituras.
+ */
+#ifndef REGISTROASINCRONO_H
+#define REGISTROASINCRONO_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
+/**
+ * @brief Nivel mínimo que se compila; los logs por debajo desaparecen del binario.
+ *
+ * Se define con -DGESTION_LOG_NIVEL_MINIMO=n (0 = depuración ... 4 = error).
+ */
+#ifndef GESTION_LOG_NIVEL_MINIMO
+#define GESTION_LOG_NIVEL_MINIMO 0
+#endif
+
+/// Severidad de un mensaje de log, de menor a mayor.
+enum class NivelLog : int
+{
+    Depuracion = 0,
+    Estado = 1,
+    Exito = 2,
+    Advertencia = 3,
+    Error = 4
+};
+
+/// Indica si los logs del nivel dado se compilan en este binario.
+constexpr bool nivelCompilado(NivelLog nivel)
+{
+    return static_cast<int>(nivel) >= GESTION_LOG_NIVEL_MINIMO;
+}
+
+/**
+ * @brief Acumula los logs de un hilo para emitirlos después en un orden elegido.
+ *
+ * Mientras una captura está activa en un hilo (ver CapturaLog::Activa), los
+ * mensajes que ese hilo registra se guardan aquí en vez de ir a la cola. El
+ * procesamiento paralelo usa una captura por sensor y las vuelca en el orden
+ * de registro, de modo que la salida no depende del reparto entre hilos.
+ */
+class CapturaLog
+{
+public:
+    CapturaLog() : datos(nullptr), usados(0), capacidad(0) {}
+
+    CapturaLog(const CapturaLog&) = delete;
+    CapturaLog& operator=(const CapturaLog&) = delete;
+
+    ~CapturaLog()
+    {
+        delete[] datos;
+    }
+
+    /// Activa una captura en el hilo actual durante su alcance.
+    class Activa
+    {
+    public:
+        explicit Activa(CapturaLog& captura) : anterior(actual())
+        {
+            actual() = &captura;
+        }
+
+        ~Activa()
+        {
+            actual() = anterior;
+        }
+
+        Activa(const Activa&) = delete;
+        Activa& operator=(const Activa&) = delete;
+
+    private:
+        CapturaLog* anterior;
+    };
+
+    /// Captura activa en el hilo que llama, o nullptr.
+    static CapturaLog*& actual()
+    {
+        thread_local CapturaLog* captura = nullptr;
+        return captura;
+    }
+
+    /// Guarda un mensaje con su nivel.
+    void agregar(NivelLog nivel, const char* msj, std::size_t longitud)
+    {
+        std::size_t necesario = usados + 1 + sizeof(std::size_t) + longitud;
+        if (necesario > capacidad)
+        {
+            std::size_t nuevaCapacidad = (capacidad == 0) ? 256 : capacidad * 2;
+            while (nuevaCapacidad < necesario)
+            {
+                nuevaCapacidad *= 2;
+            }
+            char* nuevos = new char[nuevaCapacidad];
+            if (usados > 0)
+            {
+                std::memcpy(nuevos, datos, usados);
+            }
+            delete[] datos;
+            datos = nuevos;
+            capacidad = nuevaCapacidad;
+        }
+
+        datos[usados++] = static_cast<char>(nivel);
+        std::memcpy(datos + usados, &longitud, sizeof(longitud));
+        usados += sizeof(longitud);
+        std::memcpy(datos + usados, msj, longitud);
+        usados += longitud;
+    }
+
+    /// Envía los mensajes capturados a la cola de logs, en el orden en que llegaron, y la vacía.
+    void volcar();
+
+    /// Descarta los mensajes capturados.
+    void vaciar()
+    {
+        usados = 0;
+    }
+
+private:
+    char* datos;
+    std::size_t usados;
+    std::size_t capacidad;
+};
+
+/**
+ * @brief Escritor de logs compartido por todo el proceso.
+ *
+ * Los productores copian el mensaje en una cola circular acotada (algoritmo de
+ * Vyukov: cada ranura lleva un número de secuencia y los productores reservan
+ * posiciones con compare-and-swap), así que encolar no toma ningún mutex. Un
+ * único hilo escritor vacía la cola, arma un lote con el color de cada nivel y
+ * lo envía con un fwrite() y un fflush() por lote en lugar de uno por mensaje.
+ *
+ * Si la cola se llena el productor espera a que haya espacio: los logs forman
+ * parte de la salida del programa y no se descartan. Antes de escribir en la
+ * consola por otra vía (menús, prompts) hay que llamar a sincronizar() para
+ * que los mensajes previos aparezcan primero.
+ */
+class RegistroAsincrono
+{
+public:
+    /// Ranuras de la cola; potencia de dos.
+    static constexpr std::size_t CAPACIDAD = 4096;
+    /// Longitud máxima de un mensaje (los más largos se truncan).
+    static constexpr std::size_t TAM_MENSAJE = 240;
+
+    /// Instancia única; el hilo escritor arranca en el primer uso.
+    static RegistroAsincrono& instancia()
+    {
+        static RegistroAsincrono registro;
+        return registro;
+    }
+
+    RegistroAsincrono(const RegistroAsincrono&) = delete;
+    RegistroAsincrono& operator=(const RegistroAsincrono&) = delete;
+
+    ~RegistroAsincrono()
+    {
+        if (escritor.joinable())
+        {
+            {
+                std::lock_guard<std::mutex> guardia(mutexEscritor);
+                detener = true;
+            }
+            hayTrabajo.notify_one();
+            escritor.join();
+        }
+        vaciarCola();
+        delete[] ranuras;
+        delete[] lote;
+    }
+
+    /// Cambia en tiempo de ejecución el nivel mínimo que se registra.
+    void establecerNivelMinimo(NivelLog nivel)
+    {
+        nivelMinimo.store(static_cast<int>(nivel), std::memory_order_relaxed);
+    }
+
+    /// Nivel mínimo vigente; al inicio coincide con GESTION_LOG_NIVEL_MINIMO.
+    NivelLog obtenerNivelMinimo() const
+    {
+        return static_cast<NivelLog>(nivelMinimo.load(std::memory_order_relaxed));
+    }
+
+    /// Indica si un mensaje del nivel dado se registraría.
+    bool habilitado(NivelLog nivel) const
+    {
+        return static_cast<int>(nivel) >= nivelMinimo.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Copia el mensaje en la cola (o en la captura activa del hilo); no escribe en la consola.
+     * @param nivel Severidad del mensaje.
+     * @param msj Texto terminado en nulo.
+     * @param longitud Número de caracteres de msj.
+     */
+    void encolar(NivelLog nivel, const char* msj, std::size_t longitud)
+    {
+        if (CapturaLog* captura = CapturaLog::actual())
+        {
+            captura->agregar(nivel, msj, (longitud < TAM_MENSAJE) ? longitud : TAM_MENSAJE);
+            return;
+        }
+        if (!escritor.joinable())
+        {
+            escribirDirecto(nivel, msj, longitud);
+            return;
+        }
+
+        Ranura* ranura = reservarRanura();
+        ranura->nivel = nivel;
+        ranura->longitud = (longitud < TAM_MENSAJE) ? longitud : TAM_MENSAJE;
+        std::memcpy(ranura->texto, msj, ranura->longitud);
+        ranura->secuencia.store(ranura->posicion + 1, std::memory_order_release);
+
+        encolados.fetch_add(1, std::memory_order_seq_cst);
+        if (escritorDormido.load(std::memory_order_seq_cst))
+        {
+            std::lock_guard<std::mutex> guardia(mutexEscritor);
+            hayTrabajo.notify_one();
+        }
+    }
+
+    /**
+     * @brief Espera a que todo lo encolado hasta ahora esté escrito en stdout.
+     */
+    void sincronizar()
+    {
+        if (!escritor.joinable())
+        {
+            return;
+        }
+
+        std::uint64_t objetivo = encolados.load(std::memory_order_acquire);
+        if (escritos.load(std::memory_order_acquire) >= objetivo)
+        {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> guardia(mutexEscritor);
+            hayTrabajo.notify_one();
+        }
+        std::unique_lock<std::mutex> candado(mutexSincronia);
+        loteEscrito.wait(candado, [this, objetivo]() { return escritos.load(std::memory_order_acquire) >= objetivo; });
+    }
+
+    /// Mensajes que ya llegaron a stdout.
+    std::uint64_t obtenerEscritos() const
+    {
+        return escritos.load(std::memory_order_acquire);
+    }
+
+    /// Lotes enviados con fwrite(); junto con obtenerEscritos() da el tamaño medio de lote.
+    std::uint64_t obtenerLotes() const
+    {
+        return lotes.load(std::memory_order_relaxed);
+    }
+
+private:
+    /// Posición de la cola: secuencia de Vyukov más el mensaje copiado.
+    struct Ranura
+    {
+        std::atomic<std::uint64_t> secuencia;
+        std::uint64_t posicion;
+        NivelLog nivel;
+        std::size_t longitud;
+        char texto[TAM_MENSAJE];
+    };
+
+    /// Tamaño del buffer donde el escritor arma cada lote.
+    static constexpr std::size_t TAM_LOTE = 64 * 1024;
+
+    Ranura* ranuras;
+    alignas(64) std::atomic<std::uint64_t> posicionProductor;
+    alignas(64) std::uint64_t posicionConsumidor;
+    std::atomic<std::uint64_t> encolados;
+    std::atomic<std::uint64_t> escritos;
+    std::atomic<std::uint64_t> lotes;
+    std::atomic<int> nivelMinimo;
+    std::atomic<bool> escritorDormido;
+    bool detener;
+    char* lote;
+
+    std::mutex mutexEscritor;
+    std::condition_variable hayTrabajo;
+    std::mutex mutexSincronia;
+    std::condition_variable loteEscrito;
+    std::thread escritor;
+
+    RegistroAsincrono()
+        : ranuras(new Ranura[CAPACIDAD]), posicionProductor(0), posicionConsumidor(0), encolados(0), escritos(0),
+          lotes(0), nivelMinimo(GESTION_LOG_NIVEL_MINIMO), escritorDormido(false), detener(false),
+          lote(new char[TAM_LOTE])
+    {
+        for (std::size_t i = 0; i < CAPACIDAD; ++i)
+        {
+            ranuras[i].secuencia.store(i, std::memory_order_relaxed);
+        }
+
+        try
+        {
+            escritor = std::thread(&RegistroAsincrono::ejecutarEscritor, this);
+        }
+        catch (const std::system_error&)
+        {
+            // Sin hilo escritor cada mensaje se escribe en el momento.
+        }
+    }
+
+    /// Reserva la siguiente ranura libre; si la cola está llena espera al escritor.
+    Ranura* reservarRanura()
+    {
+        std::uint64_t posicion = posicionProductor.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Ranura& ranura = ranuras[posicion & (CAPACIDAD - 1)];
+            std::uint64_t secuencia = ranura.secuencia.load(std::memory_order_acquire);
+            if (secuencia == posicion)
+            {
+                if (posicionProductor.compare_exchange_weak(posicion, posicion + 1, std::memory_order_relaxed))
+                {
+                    ranura.posicion = posicion;
+                    return &ranura;
+                }
+            }
+            else if (secuencia < posicion)
+            {
+                {
+                    std::lock_guard<std::mutex> guardia(mutexEscritor);
+                    hayTrabajo.notify_one();
+                }
+                std::this_thread::yield();
+                posicion = posicionProductor.load(std::memory_order_relaxed);
+            }
+            else
+            {
+                posicion = posicionProductor.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// Saca de la cola todos los mensajes publicados y los escribe como un solo lote.
+    std::size_t vaciarCola()
+    {
+        std::size_t usados = 0;
+        std::size_t mensajes = 0;
+        for (;;)
+        {
+            Ranura& ranura = ranuras[posicionConsumidor & (CAPACIDAD - 1)];
+            if (ranura.secuencia.load(std::memory_order_acquire) != posicionConsumidor + 1)
+            {
+                break;
+            }
+            if (usados + ranura.longitud + 32 > TAM_LOTE)
+            {
+                escribirLote(usados, mensajes);
+                usados = 0;
+                mensajes = 0;
+            }
+
+            usados += formatear(ranura.nivel, ranura.texto, ranura.longitud, lote + usados);
+            ++mensajes;
+            ranura.secuencia.store(posicionConsumidor + CAPACIDAD, std::memory_order_release);
+            ++posicionConsumidor;
+        }
+
+        if (mensajes > 0)
+        {
+            escribirLote(usados, mensajes);
+        }
+        return mensajes;
+    }
+
+    /// Envía el lote a stdout y avisa a quien espera en sincronizar().
+    void escribirLote(std::size_t bytes, std::size_t mensajes)
+    {
+        std::fwrite(lote, 1, bytes, stdout);
+        std::fflush(stdout);
+        lotes.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> guardia(mutexSincronia);
+            escritos.fetch_add(mensajes, std::memory_order_release);
+        }
+        loteEscrito.notify_all();
+    }
+
+    /// Ciclo del hilo escritor: vacía la cola y duerme cuando no hay mensajes.
+    void ejecutarEscritor()
+    {
+        for (;;)
+        {
+            if (vaciarCola() > 0)
+            {
+                continue;
+            }
+
+            std::unique_lock<std::mutex> candado(mutexEscritor);
+            escritorDormido.store(true, std::memory_order_seq_cst);
+            if (!detener && !hayPublicados())
+            {
+                hayTrabajo.wait_for(candado, std::chrono::milliseconds(50));
+            }
+            escritorDormido.store(false, std::memory_order_relaxed);
+            if (detener)
+            {
+                break;
+            }
+        }
+    }
+
+    /**
+     * @brief Indica si hay mensajes publicados que el escritor aún no consume.
+     *
+     * Junto con la marca escritorDormido (ambas seq_cst) evita que el escritor
+     * se duerma justo después de que un productor publicó sin avisarle.
+     */
+    bool hayPublicados() const
+    {
+        return encolados.load(std::memory_order_seq_cst) != posicionConsumidor;
+    }
+
+    /// Escribe un mensaje sin pasar por la cola (sin hilo escritor disponible).
+    void escribirDirecto(NivelLog nivel, const char* msj, std::size_t longitud)
+    {
+        char linea[TAM_MENSAJE + 32];
+        std::size_t bytes = formatear(nivel, msj, (longitud < TAM_MENSAJE) ? longitud : TAM_MENSAJE, linea);
+        std::fwrite(linea, 1, bytes, stdout);
+        std::fflush(stdout);
+    }
+
+    /// Da formato "\033[<color>m[<ETIQUETA>] mensaje\n\033[0m" y devuelve los bytes escritos.
+    static std::size_t formatear(NivelLog nivel, const char* msj, std::size_t longitud, char* destino)
+    {
+        static const char* const prefijos[] = {
+            "\033[37m[DEBUG] ", "\033[36m[STATUS] ", "\033[32m[SUCCESS] ", "\033[33m[WARNING] ", "\033[31m[ERROR] ",
+        };
+        static const char sufijo[] = "\n\033[0m";
+
+        const char* prefijo = prefijos[static_cast<int>(nivel)];
+        std::size_t tamPrefijo = std::strlen(prefijo);
+        std::memcpy(destino, prefijo, tamPrefijo);
+        std::memcpy(destino + tamPrefijo, msj, longitud);
+        std::memcpy(destino + tamPrefijo + longitud, sufijo, sizeof(sufijo) - 1);
+        return tamPrefijo + longitud + sizeof(sufijo) - 1;
+    }
+};
+
+inline void CapturaLog::volcar()
+{
+    RegistroAsincrono& registro = RegistroAsincrono::instancia();
+    std::size_t posicion = 0;
+    while (posicion < usados)
+    {
+        NivelLog nivel = static_cast<NivelLog>(datos[posicion++]);
+        std::size_t longitud = 0;
+        std::memcpy(&longitud, datos + posicion, sizeof(longitud));
+        posicion += sizeof(longitud);
+        registro.encolar(nivel, datos + posicion, longitud);
+        posicion += longitud;
+    }
+    usados = 0;
+}
+
+#endif
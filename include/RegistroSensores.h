@@ -0,0 +1,379 @@
+/**
+ * @file RegistroSensores.h
+ * @brief Registro de sensores agrupados por tipo concreto en bloques contiguos, sin nodos ni llamadas virtuales al procesar.
+ */
+#ifndef REGISTROSENSORES_H
+#define REGISTROSENSORES_H
+
+#include <cstddef>
+#include <iostream>
+#include <new>
+#include "AuxiliarCli.h"
+#include "IndiceNombres.h"
+#include "IndiceNumerico.h"
+#include "Instrumentacion.h"
+#include "PoolTrabajo.h"
+#include "SensorPresion.h"
+#include "SensorTemperatura.h"
+
+/**
+ * @brief Sensores de un mismo tipo concreto construidos en su lugar dentro de bloques contiguos.
+ *
+ * Un sensor no puede reubicarse (los índices guardan su dirección y él es
+ * dueño de sus listas), así que el grupo no crece copiando un arreglo: agrega
+ * bloques de SensoresPorBloque sensores consecutivos y ninguno se mueve hasta
+ * vaciar(). paraCada() recorre los bloques en orden y entrega cada sensor con
+ * su tipo concreto, de modo que las llamadas se resuelven en compilación.
+ */
+template <typename S, std::size_t SensoresPorBloque = 1024>
+class GrupoSensores
+{
+public:
+    GrupoSensores() : bloques(nullptr), cantidadBloques(0), capacidadBloques(0), cantidad(0) {}
+
+    GrupoSensores(const GrupoSensores&) = delete;
+    GrupoSensores& operator=(const GrupoSensores&) = delete;
+
+    ~GrupoSensores()
+    {
+        vaciar();
+    }
+
+    /// Construye un sensor al final del grupo; su dirección no cambia mientras exista.
+    S* emplazar(const char* nombre)
+    {
+        if (cantidad == cantidadBloques * SensoresPorBloque)
+        {
+            agregarBloque();
+        }
+        S* ranura = bloques[cantidad / SensoresPorBloque] + cantidad % SensoresPorBloque;
+        S* sensor = new (ranura) S(nombre);
+        ++cantidad;
+        return sensor;
+    }
+
+    /// Destruye el último sensor construido (por ejemplo, si su nombre resultó duplicado).
+    void descartarUltimo()
+    {
+        if (cantidad > 0)
+        {
+            --cantidad;
+            (*this)[cantidad].~S();
+        }
+    }
+
+    /// Sensor en la posición indicada, en orden de alta.
+    S& operator[](std::size_t posicion)
+    {
+        return bloques[posicion / SensoresPorBloque][posicion % SensoresPorBloque];
+    }
+
+    /// Sensor en la posición indicada, en orden de alta.
+    const S& operator[](std::size_t posicion) const
+    {
+        return bloques[posicion / SensoresPorBloque][posicion % SensoresPorBloque];
+    }
+
+    /// Invoca funcion(S&) sobre cada sensor en orden de alta.
+    template <typename Funcion>
+    void paraCada(Funcion&& funcion)
+    {
+        recorrer<S>(bloques, cantidad, funcion);
+    }
+
+    /// Invoca funcion(const S&) sobre cada sensor en orden de alta.
+    template <typename Funcion>
+    void paraCada(Funcion&& funcion) const
+    {
+        recorrer<const S>(bloques, cantidad, funcion);
+    }
+
+    /// Sensores en el grupo.
+    std::size_t tamano() const
+    {
+        return cantidad;
+    }
+
+    /// Destruye los sensores en orden de alta y devuelve los bloques.
+    void vaciar()
+    {
+        paraCada([](S& sensor) { sensor.~S(); });
+        for (std::size_t b = 0; b < cantidadBloques; ++b)
+        {
+            ::operator delete(bloques[b]);
+        }
+        delete[] bloques;
+        bloques = nullptr;
+        cantidadBloques = 0;
+        capacidadBloques = 0;
+        cantidad = 0;
+    }
+
+private:
+    /// Tabla de bloques; cada uno es memoria sin construir para SensoresPorBloque sensores.
+    S** bloques;
+    std::size_t cantidadBloques;
+    std::size_t capacidadBloques;
+    std::size_t cantidad;
+
+    /// Recorre los primeros cantidad sensores bloque por bloque; Elemento fija si se entregan como const.
+    template <typename Elemento, typename Funcion>
+    static void recorrer(S* const* bloques, std::size_t cantidad, Funcion& funcion)
+    {
+        std::size_t restantes = cantidad;
+        for (std::size_t b = 0; restantes > 0; ++b)
+        {
+            std::size_t enBloque = (restantes < SensoresPorBloque) ? restantes : SensoresPorBloque;
+            Elemento* bloque = bloques[b];
+            for (std::size_t i = 0; i < enBloque; ++i)
+            {
+                funcion(bloque[i]);
+            }
+            restantes -= enBloque;
+        }
+    }
+
+    void agregarBloque()
+    {
+        if (cantidadBloques == capacidadBloques)
+        {
+            std::size_t nuevaCapacidad = (capacidadBloques == 0) ? 4 : capacidadBloques * 2;
+            S** nuevos = new S*[nuevaCapacidad];
+            for (std::size_t b = 0; b < cantidadBloques; ++b)
+            {
+                nuevos[b] = bloques[b];
+            }
+            delete[] bloques;
+            bloques = nuevos;
+            capacidadBloques = nuevaCapacidad;
+        }
+        bloques[cantidadBloques++] = static_cast<S*>(::operator new(sizeof(S) * SensoresPorBloque));
+    }
+};
+
+/**
+ * @brief Alternativa a ListaGeneral con un grupo contiguo por tipo concreto de sensor.
+ *
+ * ListaGeneral sigue un NodoGeneral y luego un SensorBase por cada sensor y
+ * despacha con una llamada virtual. Aquí cada grupo es un arreglo de
+ * SensorTemperatura o SensorPresion (ambas clases final), así que procesar
+ * recorre memoria consecutiva y el compilador resuelve (y puede expandir) las
+ * llamadas. Las búsquedas devuelven SensorBase* con los mismos índices que
+ * ListaGeneral para el código que necesita polimorfismo (lectores seriales,
+ * AlmacenHistorial).
+ *
+ * El orden de proceso y de resumen es por grupo (primero temperatura, luego
+ * presión) y dentro de cada grupo el de alta, no el orden global de registro.
+ */
+class RegistroSensores
+{
+public:
+    RegistroSensores() = default;
+    RegistroSensores(const RegistroSensores&) = delete;
+    RegistroSensores& operator=(const RegistroSensores&) = delete;
+
+    ~RegistroSensores()
+    {
+        liberar();
+    }
+
+    /// Da de alta un sensor de temperatura; nullptr si el nombre ya existe.
+    SensorTemperatura* agregarTemperatura(const char* nombre)
+    {
+        return agregar(temperaturas, nombre);
+    }
+
+    /// Da de alta un sensor de presión; nullptr si el nombre ya existe.
+    SensorPresion* agregarPresion(const char* nombre)
+    {
+        return agregar(presiones, nombre);
+    }
+
+    /// Busca un sensor por identificador.
+    SensorBase* buscarPorNombre(const char* id) const
+    {
+        return indice.buscar(id);
+    }
+
+    /// Busca un sensor a partir de un nombre sin terminador.
+    SensorBase* buscarPorNombre(const char* id, std::size_t longitud) const
+    {
+        return indice.buscar(id, longitud);
+    }
+
+    /// Busca un sensor por la clave de las tramas binarias.
+    SensorBase* buscarPorId(char tipo, std::uint16_t id) const
+    {
+        return numericos.buscar(claveNumerica(tipo, id));
+    }
+
+    /// Sensores registrados.
+    std::size_t tamano() const
+    {
+        return temperaturas.tamano() + presiones.tamano();
+    }
+
+    /// Indica si el registro está vacío.
+    bool estaVacia() const
+    {
+        return tamano() == 0;
+    }
+
+    /**
+     * @brief Invoca funcion sobre cada sensor con su tipo concreto.
+     * @param funcion Invocable con SensorTemperatura& y con SensorPresion& (por ejemplo, una lambda genérica).
+     */
+    template <typename Funcion>
+    void paraCada(Funcion&& funcion)
+    {
+        temperaturas.paraCada(funcion);
+        presiones.paraCada(funcion);
+    }
+
+    /// Como paraCada(), pero entrega const SensorTemperatura& y const SensorPresion&.
+    template <typename Funcion>
+    void paraCada(Funcion&& funcion) const
+    {
+        temperaturas.paraCada(funcion);
+        presiones.paraCada(funcion);
+    }
+
+    /// Activa o desactiva la ingesta concurrente en todos los sensores.
+    void establecerIngestaConcurrente(bool activa)
+    {
+        paraCada([activa](SensorBase& sensor) { sensor.establecerIngestaConcurrente(activa); });
+    }
+
+    /// Invoca procesarLectura() de cada sensor, grupo por grupo y sin despacho virtual.
+    void procesarSensores()
+    {
+        AuxiliarCli cli;
+        if (estaVacia())
+        {
+            cli.imprimirLog(NivelLog::Advertencia, "No hay sensores registrados para procesar.");
+            return;
+        }
+
+        CronometroEtapas etapas;
+        paraCada([&cli, &etapas](auto& sensor)
+        {
+            cli.imprimirLogFormato<NivelLog::Estado>("-> Procesando Sensor %s...", sensor.obtenerNombre());
+            etapas.reanudar();
+            sensor.procesarLectura();
+            etapas.marcar(Etapa::Procesamiento);
+        });
+    }
+
+    /**
+     * @brief Procesa los sensores en paralelo sobre el pool indicado.
+     *
+     * Igual que ListaGeneral::procesarSensoresEnParalelo(): los logs de cada
+     * sensor se capturan y se emiten en el orden de procesarSensores().
+     */
+    void procesarSensoresEnParalelo(PoolTrabajo& pool)
+    {
+        AuxiliarCli cli;
+        if (estaVacia())
+        {
+            cli.imprimirLog(NivelLog::Advertencia, "No hay sensores registrados para procesar.");
+            return;
+        }
+
+        std::size_t cantidadTemperaturas = temperaturas.tamano();
+        std::size_t cantidad = tamano();
+        CapturaLog* capturas = new CapturaLog[cantidad];
+        auto procesar = [this, capturas, cantidadTemperaturas](std::size_t i)
+        {
+            CapturaLog::Activa activa(capturas[i]);
+            CronometroEtapas etapas;
+            if (i < cantidadTemperaturas)
+            {
+                temperaturas[i].procesarLectura();
+            }
+            else
+            {
+                presiones[i - cantidadTemperaturas].procesarLectura();
+            }
+            etapas.marcar(Etapa::Procesamiento);
+        };
+        pool.paraCada(cantidad, procesar);
+
+        for (std::size_t i = 0; i < cantidad; ++i)
+        {
+            const char* nombre = (i < cantidadTemperaturas) ? temperaturas[i].obtenerNombre()
+                                                            : presiones[i - cantidadTemperaturas].obtenerNombre();
+            cli.imprimirLogFormato<NivelLog::Estado>("-> Procesando Sensor %s...", nombre);
+            capturas[i].volcar();
+        }
+        delete[] capturas;
+    }
+
+    /// Imprime un resumen de los sensores registrados.
+    void mostrarResumen() const
+    {
+        AuxiliarCli::sincronizar();
+        if (estaVacia())
+        {
+            std::cout << "Registro de sensores vacío." << std::endl;
+            return;
+        }
+        paraCada([](const auto& sensor) { sensor.imprimirInfo(); });
+    }
+
+    /// Destruye todos los sensores y vacía los índices.
+    void liberar()
+    {
+        AuxiliarCli cli;
+        paraCada([&cli](const SensorBase& sensor)
+        {
+            cli.imprimirLogFormato<NivelLog::Estado>("[Destructor Registro] Liberando Sensor: %s.",
+                                                     sensor.obtenerNombre());
+        });
+        indice.vaciar();
+        numericos.vaciar();
+        temperaturas.vaciar();
+        presiones.vaciar();
+    }
+
+    /// Como ListaGeneral::liberarEnBloque(): un solo resumen en lugar del detalle por sensor y lectura.
+    ResumenLiberacion liberarEnBloque()
+    {
+        ResumenLiberacion resumen;
+        paraCada([&resumen](auto& sensor) { sensor.liberarHistorial(resumen); });
+        indice.vaciar();
+        numericos.vaciar();
+        temperaturas.vaciar();
+        presiones.vaciar();
+
+        AuxiliarCli cli;
+        cli.imprimirLogFormato<NivelLog::Exito>("Liberados %zu sensores: %zu lecturas y %zu bytes de historial.",
+                                                resumen.sensores, resumen.lecturas, resumen.bytes);
+        return resumen;
+    }
+
+private:
+    GrupoSensores<SensorTemperatura> temperaturas;
+    GrupoSensores<SensorPresion> presiones;
+    /// Índice hash por nombre sobre los sensores de ambos grupos.
+    IndiceNombres indice;
+    /// Índice por (letra, número) para las tramas binarias.
+    IndiceNumerico numericos;
+
+    template <typename S>
+    S* agregar(GrupoSensores<S>& grupo, const char* nombre)
+    {
+        AuxiliarCli cli;
+        S* sensor = grupo.emplazar(nombre);
+        if (!indice.insertar(sensor))
+        {
+            cli.imprimirLogFormato<NivelLog::Advertencia>("Sensor '%s' ya existe en el registro.", sensor->obtenerNombre());
+            grupo.descartarUltimo();
+            return nullptr;
+        }
+        numericos.insertar(sensor);
+        cli.imprimirLogFormato<NivelLog::Exito>("Sensor '%s' insertado en el registro.", sensor->obtenerNombre());
+        return sensor;
+    }
+};
+
+#endif
@@ -0,0 +1,426 @@
+/**
+ * @file ReproductorCapturas.h
+ * @brief Reproduce archivos de captura ID,valor sobre una ListaGeneral sin menú interactivo.
+ */
+#ifndef REPRODUCTORCAPTURAS_H
+#define REPRODUCTORCAPTURAS_H
+
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <limits>
+#include <thread>
+#include <unistd.h>
+#include "AlmacenHistorial.h"
+#include "AuxiliarCli.h"
+#include "HistogramaLatencia.h"
+#include "IndiceTemporal.h"
+#include "LectorSerial.h"
+#include "ListaGeneral.h"
+#include "SensorPresion.h"
+#include "SensorTemperatura.h"
+
+/**
+ * @brief Entrega el contenido de archivos de captura a la lista como si llegara de un puerto.
+ *
+ * Cada archivo se lee por bloques en un BufferLineas y cada elemento pasa por
+ * enrutarLineaSerial() o enrutarTramaBinaria(), el mismo camino que siguen
+ * los lectores seriales y MotorIngesta. Las líneas que empiezan con '#' no
+ * son lecturas sino directivas o comentarios:
+ *
+ *     # sensores: T-001, T-002, P-105
+ *     # tasa: 200
+ *
+ * "sensores" da de alta los sensores que falten (la letra inicial T crea un
+ * SensorTemperatura y P un SensorPresion) y "tasa" declara cuántos elementos
+ * por segundo producía el dispositivo al grabarse la captura.
+ *
+ * Sin ritmo, los elementos se entregan tan rápido como se leen; la latencia
+ * de cada uno es entonces lo que tarda en enrutarse. Con ritmo, cada
+ * elemento tiene un instante de llegada programado y su latencia se mide
+ * desde ese instante, de modo que incluye la espera si la ingesta se atrasa.
+ */
+class ReproductorCapturas
+{
+public:
+    /**
+     * @brief Crea el reproductor sobre la lista destino.
+     * @param listaDestino Lista donde se buscan y se dan de alta los sensores.
+     * @param cliLog Auxiliar usado para reportar eventos.
+     * @param almacenDestino Almacén al que se adjuntan los sensores nuevos; puede ser nullptr.
+     */
+    ReproductorCapturas(ListaGeneral& listaDestino, AuxiliarCli& cliLog, AlmacenHistorial* almacenDestino = nullptr)
+        : lista(listaDestino), cli(cliLog), almacen(almacenDestino)
+    {
+    }
+
+    ReproductorCapturas(const ReproductorCapturas&) = delete;
+    ReproductorCapturas& operator=(const ReproductorCapturas&) = delete;
+
+    /**
+     * @brief Indica si una tasa sirve como ritmo: finita, positiva y con un período que cabe en int64 nanosegundos.
+     *
+     * NaN, infinito o una tasa tan baja que su período desborda harían que
+     * esperarLlegada() convirtiera a entero un valor fuera de rango.
+     */
+    static bool ritmoValido(double elementosPorSegundo)
+    {
+        return std::isfinite(elementosPorSegundo) && elementosPorSegundo > 0.0 &&
+               1e9 / elementosPorSegundo < static_cast<double>(std::numeric_limits<std::int64_t>::max());
+    }
+
+    /**
+     * @brief Fija un ritmo constante para todos los archivos.
+     * @param elementosPorSegundo Líneas o tramas por segundo; 0 (o un valor que no pase ritmoValido()) reproduce a máxima velocidad.
+     */
+    void establecerRitmo(double elementosPorSegundo)
+    {
+        ritmoFijo = ritmoValido(elementosPorSegundo) ? elementosPorSegundo : 0.0;
+        tiempoReal = false;
+        reiniciarRitmo(ritmoFijo);
+    }
+
+    /// Reproduce cada archivo a la tasa que declara su directiva "tasa".
+    void usarTasaDeclarada()
+    {
+        ritmoFijo = 0.0;
+        tiempoReal = true;
+        reiniciarRitmo(0.0);
+    }
+
+    /**
+     * @brief Da de alta los sensores de una lista separada por comas o espacios.
+     * @return Número de nombres que no pudieron darse de alta.
+     */
+    int declararSensores(const char* nombres)
+    {
+        int fallidos = 0;
+        const char* actual = nombres;
+        while (*actual)
+        {
+            while (*actual == ',' || *actual == ' ' || *actual == '\t')
+            {
+                ++actual;
+            }
+            std::size_t longitud = std::strcspn(actual, ", \t");
+            if (longitud == 0)
+            {
+                break;
+            }
+            if (!declararSensor(actual, longitud))
+            {
+                ++fallidos;
+            }
+            actual += longitud;
+        }
+        return fallidos;
+    }
+
+    /**
+     * @brief Reproduce un archivo completo.
+     * @return false si el archivo no pudo abrirse o leerse hasta el final.
+     */
+    bool reproducir(const char* ruta)
+    {
+        int fd = open(ruta, O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            cli.imprimirLogFormato<NivelLog::Error>("No se pudo abrir la captura '%s': %s.", ruta, std::strerror(errno));
+            return false;
+        }
+        posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+        BufferLineas* buffer = new BufferLineas();
+        secuencia.reiniciar();
+        avisoSinTasa = false;
+        if (tiempoReal)
+        {
+            reiniciarRitmo(0.0);
+        }
+
+        std::int64_t inicio = marcaMonotonica();
+        bool completo = true;
+        while (true)
+        {
+            ssize_t cantidad = buffer->leerDesde(fd);
+            if (cantidad < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (cantidad < 0)
+            {
+                cli.imprimirLogFormato<NivelLog::Error>("Error leyendo la captura '%s': %s.", ruta, std::strerror(errno));
+                completo = false;
+                break;
+            }
+            if (cantidad == 0)
+            {
+                // Una última línea sin salto también es una lectura.
+                buffer->alimentar("\n", 1);
+                atenderBuffer(*buffer);
+                break;
+            }
+            bytes += static_cast<std::uint64_t>(cantidad);
+            atenderBuffer(*buffer);
+        }
+        nanosegundos += marcaMonotonica() - inicio;
+
+        std::size_t invalidas = buffer->obtenerTramasInvalidas();
+        std::size_t excedidas = buffer->obtenerLineasDescartadas();
+        tramasInvalidas += invalidas;
+        descartadas += excedidas;
+        if (invalidas > 0 || excedidas > 0)
+        {
+            cli.imprimirLogFormato<NivelLog::Advertencia>(
+                "Captura '%s': %zu tramas inválidas y %zu líneas demasiado largas descartadas.", ruta, invalidas, excedidas);
+        }
+        delete buffer;
+        close(fd);
+        ++archivos;
+        return completo;
+    }
+
+    /// Imprime el volumen reproducido, el rendimiento y los percentiles de latencia.
+    void imprimirEstadisticas() const
+    {
+        AuxiliarCli::sincronizar();
+        double segundos = static_cast<double>(nanosegundos) / 1e9;
+        double porSegundo = (segundos > 0.0) ? static_cast<double>(lecturas) / segundos : 0.0;
+        double megabytes = static_cast<double>(bytes) / (1024.0 * 1024.0);
+
+        std::printf("\n--- Reproducción de capturas ---\n");
+        std::printf("Archivos: %d | %.2f MiB en %.3f s (%.2f MiB/s)\n", archivos, megabytes, segundos,
+                    (segundos > 0.0) ? megabytes / segundos : 0.0);
+        std::printf("Líneas: %llu | tramas: %llu (inválidas %llu, perdidas %llu)\n",
+                    static_cast<unsigned long long>(lineas), static_cast<unsigned long long>(tramas),
+                    static_cast<unsigned long long>(tramasInvalidas), static_cast<unsigned long long>(tramasPerdidas));
+        std::printf("Lecturas registradas: %llu | descartadas: %llu | %.0f lecturas/s\n",
+                    static_cast<unsigned long long>(lecturas), static_cast<unsigned long long>(descartadas), porSegundo);
+        if (latencias.obtenerCantidad() > 0)
+        {
+            std::printf("Latencia por elemento (ns): p50 %llu | p90 %llu | p99 %llu | p99.9 %llu | máx %llu | prom %.0f\n",
+                        static_cast<unsigned long long>(latencias.percentil(50.0)),
+                        static_cast<unsigned long long>(latencias.percentil(90.0)),
+                        static_cast<unsigned long long>(latencias.percentil(99.0)),
+                        static_cast<unsigned long long>(latencias.percentil(99.9)),
+                        static_cast<unsigned long long>(latencias.obtenerMaximo()), latencias.promedio());
+        }
+        std::fflush(stdout);
+    }
+
+    /// Lecturas entregadas a sensores.
+    std::uint64_t obtenerLecturas() const
+    {
+        return lecturas;
+    }
+
+    /// Lecturas o líneas que no llegaron a ningún sensor.
+    std::uint64_t obtenerDescartadas() const
+    {
+        return descartadas;
+    }
+
+    /// Latencias por elemento acumuladas en todos los archivos.
+    const HistogramaLatencia& obtenerLatencias() const
+    {
+        return latencias;
+    }
+
+private:
+    /// Espera mayor a ésta se duerme; una menor se cubre procesando el elemento antes de tiempo.
+    static constexpr std::int64_t ESPERA_MINIMA_NS = 50000;
+
+    ListaGeneral& lista;
+    AuxiliarCli& cli;
+    AlmacenHistorial* almacen;
+    TramaBinaria trama;
+    HistogramaLatencia latencias;
+
+    double ritmoFijo = 0.0;
+    bool tiempoReal = false;
+    /// Separación entre llegadas programadas; 0 sin ritmo.
+    double periodoNs = 0.0;
+    std::int64_t inicioRitmo = 0;
+    std::uint64_t elementosRitmo = 0;
+    bool avisoSinTasa = false;
+
+    SeguimientoSecuencia secuencia;
+
+    int archivos = 0;
+    std::uint64_t bytes = 0;
+    std::uint64_t lineas = 0;
+    std::uint64_t tramas = 0;
+    std::uint64_t tramasInvalidas = 0;
+    std::uint64_t tramasPerdidas = 0;
+    std::uint64_t lecturas = 0;
+    std::uint64_t descartadas = 0;
+    std::int64_t nanosegundos = 0;
+
+    /// Reinicia el calendario de llegadas a partir de ahora.
+    void reiniciarRitmo(double elementosPorSegundo)
+    {
+        periodoNs = ritmoValido(elementosPorSegundo) ? 1e9 / elementosPorSegundo : 0.0;
+        inicioRitmo = marcaMonotonica();
+        elementosRitmo = 0;
+    }
+
+    /// Entrega todos los elementos completos que hay en el buffer.
+    void atenderBuffer(BufferLineas& buffer)
+    {
+        char* linea = nullptr;
+        std::size_t longitud = 0;
+        ElementoEntrada elemento;
+        while ((elemento = buffer.siguienteElemento(linea, longitud, trama)) != ElementoEntrada::Ninguno)
+        {
+            if (elemento == ElementoEntrada::Linea && linea[0] == '#')
+            {
+                interpretarDirectiva(linea + 1);
+                continue;
+            }
+
+            std::int64_t llegada = esperarLlegada();
+            if (elemento == ElementoEntrada::Linea)
+            {
+                ++lineas;
+                if (enrutarLineaSerial(lista, linea, longitud, cli))
+                {
+                    ++lecturas;
+                }
+                else
+                {
+                    ++descartadas;
+                }
+            }
+            else
+            {
+                registrarSecuencia(trama.secuencia);
+                int registradas = enrutarTramaBinaria(lista, trama, cli);
+                lecturas += static_cast<std::uint64_t>(registradas);
+                descartadas += trama.cantidad - static_cast<std::size_t>(registradas);
+            }
+
+            std::int64_t latencia = marcaMonotonica() - llegada;
+            latencias.registrar((latencia > 0) ? static_cast<std::uint64_t>(latencia) : 0);
+        }
+    }
+
+    /**
+     * @brief Espera el instante programado del siguiente elemento.
+     * @return Instante desde el que se mide la latencia del elemento.
+     */
+    std::int64_t esperarLlegada()
+    {
+        if (periodoNs == 0.0)
+        {
+            if (tiempoReal && !avisoSinTasa)
+            {
+                cli.imprimirLog(NivelLog::Advertencia, "La captura no declara '# tasa:'; se reproduce a máxima velocidad.");
+                avisoSinTasa = true;
+            }
+            return marcaMonotonica();
+        }
+
+        // Con períodos enormes el desplazamiento acumulado también puede salirse de int64; se satura.
+        double desplazamiento = static_cast<double>(elementosRitmo) * periodoNs;
+        double maximo = static_cast<double>(std::numeric_limits<std::int64_t>::max() - inicioRitmo);
+        std::int64_t programada = (desplazamiento < maximo) ? inicioRitmo + static_cast<std::int64_t>(desplazamiento)
+                                                            : std::numeric_limits<std::int64_t>::max();
+        ++elementosRitmo;
+        std::int64_t espera = programada - marcaMonotonica();
+        if (espera > ESPERA_MINIMA_NS)
+        {
+            std::this_thread::sleep_for(std::chrono::nanoseconds(espera));
+        }
+        return programada;
+    }
+
+    /// Aplica una línea '#': "sensores: ..." o "tasa: N"; cualquier otra es un comentario.
+    void interpretarDirectiva(const char* texto)
+    {
+        while (*texto == ' ' || *texto == '\t')
+        {
+            ++texto;
+        }
+        if (std::strncmp(texto, "sensores:", 9) == 0)
+        {
+            declararSensores(texto + 9);
+        }
+        else if (std::strncmp(texto, "tasa:", 5) == 0)
+        {
+            double tasa = std::strtod(texto + 5, nullptr);
+            if (!ritmoValido(tasa))
+            {
+                cli.imprimirLog(NivelLog::Advertencia, "Directiva '# tasa:' sin un valor positivo y finito; se ignora.");
+            }
+            else if (tiempoReal)
+            {
+                reiniciarRitmo(tasa);
+            }
+        }
+    }
+
+    /// Da de alta un sensor si todavía no existe; el tipo sale de la letra inicial del nombre.
+    bool declararSensor(const char* nombre, std::size_t longitud)
+    {
+        if (longitud >= TAM_ID)
+        {
+            cli.imprimirLogFormato<NivelLog::Advertencia>("Nombre de sensor '%.*s...' demasiado largo.", 20, nombre);
+            return false;
+        }
+        if (lista.buscarPorNombre(nombre, longitud))
+        {
+            return true;
+        }
+
+        char id[TAM_ID];
+        std::memcpy(id, nombre, longitud);
+        id[longitud] = '\0';
+
+        SensorBase* sensor = nullptr;
+        if (id[0] == 'T' || id[0] == 't')
+        {
+            sensor = new SensorTemperatura(id);
+        }
+        else if (id[0] == 'P' || id[0] == 'p')
+        {
+            sensor = new SensorPresion(id);
+        }
+        else
+        {
+            cli.imprimirLogFormato<NivelLog::Advertencia>(
+                "Sensor '%s' sin tipo reconocible: el nombre debe empezar con T (temperatura) o P (presión).", id);
+            return false;
+        }
+
+        if (!lista.insertar(sensor))
+        {
+            delete sensor;
+            return false;
+        }
+        if (almacen && almacen->estaAbierto())
+        {
+            almacen->adjuntar(*sensor);
+        }
+        return true;
+    }
+
+    /// Cuenta la trama y acumula las perdidas según su número de secuencia.
+    void registrarSecuencia(std::uint16_t numero)
+    {
+        ++tramas;
+        std::uint16_t perdidas = 0;
+        if (secuencia.registrar(numero, perdidas) == SaltoSecuencia::Perdidas)
+        {
+            tramasPerdidas += perdidas;
+        }
+    }
+};
+
+#endif
@@ -5,7 +5,24 @@
 #ifndef SENSORBASE_H
 #define SENSORBASE_H
 
+#include <atomic>
+#include <cstddef>
 #include <cstring>
+#include <string_view>
+#include "AuxiliarCli.h"
+#include "ColumnaPersistente.h"
+#include "HistorialVentana.h"
+#include "IndiceTemporal.h"
+
+/**
+ * @brief Totales de una liberación en bloque: sensores, lecturas en memoria y bytes de sus historiales.
+ */
+struct ResumenLiberacion
+{
+    std::size_t sensores = 0;
+    std::size_t lecturas = 0;
+    std::size_t bytes = 0;
+};
 
 /**
  * @brief Clase base abstracta para cualquier sensor del sistema.
@@ -13,12 +30,16 @@
 class SensorBase
 {
 public:
-    SensorBase()
+    SensorBase() : ingestaConcurrente(false), historialLiberado(false), persistencia(nullptr), persistidasSinCargar(0)
     {
         nombre[0] = '\0';
     }
 
-    virtual ~SensorBase() {}
+    /// Cierra el historial en disco, si hay, después de que la clase derivada liberó el suyo.
+    virtual ~SensorBase()
+    {
+        delete persistencia;
+    }
 
     /**
      * @brief Asigna el identificador del sensor.
@@ -32,8 +53,13 @@ public:
             return;
         }
 
-        std::strncpy(nombre, nuevoNombre, sizeof(nombre) - 1);
-        nombre[sizeof(nombre) - 1] = '\0';
+        std::size_t largo = std::strlen(nuevoNombre);
+        if (largo >= sizeof(nombre))
+        {
+            largo = sizeof(nombre) - 1;
+        }
+        std::memcpy(nombre, nuevoNombre, largo);
+        nombre[largo] = '\0';
     }
 
     /**
@@ -45,16 +71,264 @@ public:
         return nombre;
     }
 
+    /// Letra del tipo de lectura del sensor ('T' float, 'P' int), la misma de las tramas binarias.
+    virtual char tipoLectura() const = 0;
+
     /// Muestra información legible del sensor.
     virtual void imprimirInfo() const = 0;
     /// Solicita una lectura desde la consola y la almacena.
     virtual void registrarLecturaInteractiva() = 0;
-    /// Interpreta una lectura recibida como texto (por ejemplo, por serial).
-    virtual void registrarLecturaDesdeCadena(const char* valorComoTexto) = 0;
+    /**
+     * @brief Interpreta una lectura recibida como texto (por ejemplo, por serial).
+     * @param valorComoTexto Vista al número; no necesita terminador nulo.
+     * @return false si el texto está vacío o no es un número válido para el sensor.
+     */
+    virtual bool registrarLecturaDesdeTexto(std::string_view valorComoTexto) = 0;
+
+    /// Variante para cadenas terminadas en nulo de registrarLecturaDesdeTexto().
+    bool registrarLecturaDesdeCadena(const char* valorComoTexto)
+    {
+        return registrarLecturaDesdeTexto(valorComoTexto ? std::string_view(valorComoTexto) : std::string_view());
+    }
+
+    /**
+     * @brief Registra una lectura que ya llegó como número (por ejemplo, en una trama binaria).
+     * @param valor Valor recibido; el sensor lo convierte a su tipo.
+     * @return false si el valor no es representable en el tipo del sensor.
+     */
+    bool registrarLecturaNumerica(double valor)
+    {
+        return registrarLecturaNumericaEn(valor, marcaMonotonica());
+    }
+
+    /**
+     * @brief Registra una lectura numérica con la marca de tiempo que indica el emisor.
+     * @param marcaNs Nanosegundos del reloj monotónico (ver marcaMonotonica()).
+     */
+    virtual bool registrarLecturaNumericaEn(double valor, std::int64_t marcaNs) = 0;
+
+    /**
+     * @brief Registra varias lecturas numéricas con una sola llamada virtual y un solo log.
+     * @param valores Valores recibidos, en orden de llegada; el sensor los convierte a su tipo.
+     * @param marcasNs Marca monotónica de cada valor.
+     * @return Lecturas aceptadas; las no representables se descartan con un solo aviso por lote.
+     */
+    virtual std::size_t registrarLoteNumericoEn(const double* valores, const std::int64_t* marcasNs,
+                                                std::size_t cantidad) = 0;
+
     /// Procesa las lecturas almacenadas aplicando la lógica específica.
     virtual void procesarLectura() = 0;
 
+    /**
+     * @brief Reporta cantidad, media, mínimo y máximo de las lecturas con marca en [desdeNs, hastaNs).
+     *
+     * Las marcas son del reloj monotónico; "hace s segundos" es
+     * marcaMonotonica() - s * 1e9.
+     */
+    virtual void procesarRango(std::int64_t desdeNs, std::int64_t hastaNs) = 0;
+
+    /**
+     * @brief Aplica una política de retención al historial del sensor.
+     * @param politica maxLecturas = 0 vuelve al historial ilimitado.
+     * @return false si maxLecturas supera PoliticaRetencion::MAX_LECTURAS o no hay memoria para
+     *         la ventana; el sensor conserva entonces la retención anterior.
+     */
+    virtual bool establecerRetencion(const PoliticaRetencion& politica) = 0;
+
+    /// Lecturas en memoria (historial o ventana), sin contar las que siguen solo en disco.
+    virtual std::size_t lecturasEnMemoria() const = 0;
+
+    /**
+     * @brief Libera de una sola vez las lecturas en memoria, sin log por lectura, y las suma al resumen.
+     *
+     * Pensada para el cierre: con un historial sobre PoolNodos los bloques se
+     * devuelven enteros sin recorrer los nodos, y el destructor ya no reporta
+     * nada. Las lecturas pendientes de consolidar se descartan.
+     */
+    virtual void liberarHistorial(ResumenLiberacion& resumen) = 0;
+
+    /// Incorpora al historial las lecturas que otros hilos dejaron pendientes.
+    virtual void consolidarPendientes() = 0;
+
+    /**
+     * @brief Activa o desactiva la ingesta desde varios hilos.
+     *
+     * Activa, las lecturas recibidas se agregan sin candados desde cualquier
+     * hilo y el hilo que procesa las incorpora al llamar a procesarLectura().
+     * Al desactivarla se consolidan las que quedaban pendientes, así que debe
+     * llamarse cuando los productores ya terminaron.
+     */
+    void establecerIngestaConcurrente(bool activa)
+    {
+        ingestaConcurrente.store(activa, std::memory_order_release);
+        if (!activa)
+        {
+            consolidarPendientes();
+        }
+    }
+
+    /**
+     * @brief Conecta el sensor a su historial en disco y toma posesión de la columna.
+     *
+     * Las lecturas que la columna ya tenía no se cargan aquí: quedan en disco
+     * hasta que el sensor las necesita (procesarLectura() o
+     * establecerRetencion()). Desde ahora cada lectura nueva también se anexa
+     * a la columna; las que ya estaban en memoria no se copian.
+     */
+    void adjuntarPersistencia(ColumnaPersistente* columna)
+    {
+        delete persistencia;
+        persistencia = columna;
+        persistidasSinCargar = columna ? columna->contar() : 0;
+    }
+
+    /// Indica si el sensor ya tiene un historial en disco.
+    bool tienePersistencia() const
+    {
+        return persistencia != nullptr;
+    }
+
+    /// Lecturas guardadas en disco (0 si el sensor no tiene historial persistente).
+    std::size_t lecturasPersistidas() const
+    {
+        return persistencia ? persistencia->contar() : 0;
+    }
+
 protected:
+    /// Lecturas que registrarLoteNumericoEn() convierte en la pila antes de anexarlas juntas.
+    static constexpr std::size_t TAM_TANDA = 256;
+
+    /// Indica si las lecturas deben agregarse por la vía concurrente.
+    std::atomic<bool> ingestaConcurrente;
+    /// true tras liberarHistorial(): el destructor omite el detalle por lectura.
+    bool historialLiberado;
+
+    /// Historial en disco; nullptr si no se abrió un almacén.
+    ColumnaPersistente* persistencia;
+    /// Lecturas anteriores al arranque que siguen solo en disco.
+    std::size_t persistidasSinCargar;
+
+    /**
+     * @brief Anexa la lectura al historial en disco, si hay uno.
+     * @param marcaNs Marca monotónica de la lectura; en disco se guarda como hora del sistema.
+     */
+    template <typename T>
+    void persistir(T valor, std::int64_t marcaNs, bool concurrente)
+    {
+        if (!persistencia)
+        {
+            return;
+        }
+        std::int64_t marca = marcaNs + desfaseEpoca();
+        if (concurrente)
+        {
+            persistencia->agregarConcurrente(valor, marca);
+        }
+        else
+        {
+            persistencia->agregar(valor, marca);
+        }
+    }
+
+    /// Variante por lotes de persistir(); a lo sumo TAM_TANDA lecturas.
+    template <typename T>
+    void persistirLote(const T* valores, const std::int64_t* marcasNs, std::size_t cantidad, bool concurrente)
+    {
+        if (!persistencia)
+        {
+            return;
+        }
+        std::int64_t marcas[TAM_TANDA];
+        std::int64_t desfase = desfaseEpoca();
+        for (std::size_t i = 0; i < cantidad; ++i)
+        {
+            marcas[i] = marcasNs[i] + desfase;
+        }
+        if (concurrente)
+        {
+            persistencia->agregarLoteConcurrente(valores, marcas, cantidad);
+        }
+        else
+        {
+            persistencia->agregarLote(valores, marcas, cantidad);
+        }
+    }
+
+    /**
+     * @brief Convierte un lote al tipo del sensor y lo entrega por tandas de hasta TAM_TANDA lecturas.
+     * @param convertir bool(double, T&); false descarta el valor.
+     * @param anexar void(const T*, const std::int64_t*, std::size_t) con cada tanda ya convertida.
+     * @param rechazadas Recibe cuántos valores descartó convertir.
+     * @return Lecturas entregadas a anexar.
+     */
+    template <typename T, typename Convertir, typename Anexar>
+    static std::size_t convertirPorTandas(const double* valores, const std::int64_t* marcasNs, std::size_t cantidad,
+                                          std::size_t& rechazadas, Convertir convertir, Anexar anexar)
+    {
+        T tanda[TAM_TANDA];
+        std::int64_t marcas[TAM_TANDA];
+        std::size_t aceptadas = 0;
+        rechazadas = 0;
+        std::size_t i = 0;
+        while (i < cantidad)
+        {
+            std::size_t enTanda = 0;
+            for (; i < cantidad && enTanda < TAM_TANDA; ++i)
+            {
+                if (!convertir(valores[i], tanda[enTanda]))
+                {
+                    ++rechazadas;
+                    continue;
+                }
+                marcas[enTanda] = marcasNs[i];
+                ++enTanda;
+            }
+            if (enTanda > 0)
+            {
+                anexar(tanda, marcas, enTanda);
+                aceptadas += enTanda;
+            }
+        }
+        return aceptadas;
+    }
+
+    /**
+     * @brief Trae del disco las lecturas anteriores al arranque y las antepone al historial.
+     *
+     * Se llama la primera vez que el sensor necesita su historial completo;
+     * las lecturas recibidas desde el arranque ya están en él y quedan detrás.
+     * La hora del sistema guardada en disco vuelve a la escala monotónica de
+     * este proceso, así que las consultas por intervalo también las cubren.
+     */
+    template <typename T, typename Lista>
+    void cargarPersistidas(Lista& historial)
+    {
+        if (persistidasSinCargar == 0)
+        {
+            return;
+        }
+
+        Lista cargadas;
+        std::int64_t desfase = desfaseEpoca();
+        persistencia->recorrer<T>(0, persistidasSinCargar, [&cargadas, desfase](std::int64_t marca, T valor)
+        {
+            cargadas.insertarAlFinal(valor, marca - desfase);
+        });
+        historial.empalmarDespues(nullptr, cargadas);
+
+        AuxiliarCli cli;
+        cli.imprimirLogFormato<NivelLog::Estado>("[%s] %zu lecturas cargadas desde disco.", nombre,
+                                                 persistidasSinCargar);
+        persistidasSinCargar = 0;
+    }
+
+    /// Diferencia entre la hora del sistema y el reloj monotónico, fijada en la primera llamada.
+    static std::int64_t desfaseEpoca()
+    {
+        static const std::int64_t desfase = marcaTiempoActual() - marcaMonotonica();
+        return desfase;
+    }
+
     /// Identificador del sensor (máximo 49 caracteres más terminador).
     char nombre[50];
 };
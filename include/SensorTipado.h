@@ -0,0 +1,432 @@
+/**
+ * @file SensorTipado.h
+ * @brief Base común de los sensores concretos: historial, ventana, persistencia y registro para un tipo de lectura.
+ */
+#ifndef SENSORTIPADO_H
+#define SENSORTIPADO_H
+
+#include <cstdio>
+#include <iostream>
+#include <new>
+#include "SensorBase.h"
+#include "ListaSensor.h"
+#include "HistorialVentana.h"
+#include "AuxiliarCli.h"
+#include "AnalizadorLineas.h"
+
+/**
+ * @brief Implementa SensorBase para lecturas de tipo T; lo propio de cada tipo lo aporta Politica.
+ *
+ * Politica es un struct sin estado con:
+ * - `LETRA`: letra del tipo de lectura ('T', 'P').
+ * - `TIPO`, `NODO`: nombre del tipo en los mensajes ("float") y en el log de inserción ("entero").
+ * - `ETIQUETA`, `MAGNITUD`: prefijo de los reportes ("[Sensor Temp]") y magnitud medida ("temperatura").
+ * - `RECHAZADOS`: por qué se descartan valores numéricos ("no finitos").
+ * - `DECIMALES`: decimales con que se muestran los valores.
+ * - `DESCARTAR_MINIMO`: si procesarLectura() elimina la lectura más baja antes de promediar.
+ * - `static bool convertir(double, T&)`: valida y convierte un valor numérico recibido.
+ */
+template <typename T, typename Politica>
+class SensorTipado : public SensorBase
+{
+public:
+    ~SensorTipado() override
+    {
+        // Tras liberarHistorial() no queda nada que recorrer ni reportar.
+        if (historialLiberado)
+        {
+            delete ventana;
+            return;
+        }
+
+        AuxiliarCli cli;
+        char encabezado[120];
+        std::snprintf(encabezado, sizeof(encabezado), "  [Destructor Sensor %s] Liberando Lista Interna...", nombre);
+        cli.imprimirLog(NivelLog::Estado, encabezado);
+
+        T valor = T();
+        if (ventana)
+        {
+            ventana->consolidarPendientes();
+            while (ventana->extraerPrimero(valor))
+            {
+                reportarLiberado(cli, valor);
+            }
+            delete ventana;
+        }
+        historial.consolidarPendientes();
+        while (historial.extraerPrimero(valor))
+        {
+            reportarLiberado(cli, valor);
+        }
+    }
+
+    /// Imprime un resumen del estado del sensor.
+    void imprimirInfo() const override
+    {
+        AuxiliarCli::sincronizar();
+        std::size_t enMemoria = lecturasEnMemoria();
+        std::cout << Politica::ETIQUETA << " " << nombre << " | lecturas almacenadas: "
+                  << enMemoria + persistidasSinCargar;
+        if (persistidasSinCargar > 0)
+        {
+            std::cout << " (" << persistidasSinCargar << " aún en disco)";
+        }
+        std::cout << std::endl;
+    }
+
+    /// Letra del tipo de lectura que define la política.
+    char tipoLectura() const override
+    {
+        return Politica::LETRA;
+    }
+
+    /// Registra una lectura pidiendo el dato al usuario.
+    void registrarLecturaInteractiva() override
+    {
+        AuxiliarCli cliLectura;
+        char pregunta[64];
+        std::snprintf(pregunta, sizeof(pregunta), "Valor de %s (%s)", Politica::MAGNITUD, Politica::TIPO);
+        T valor = T();
+        cliLectura.obtenerDato(pregunta, valor);
+        registrarLecturaInterna(valor, marcaMonotonica());
+    }
+
+    /// Registra una lectura recibida como texto (serial); rechaza valores mal formados.
+    bool registrarLecturaDesdeTexto(std::string_view valorComoTexto) override
+    {
+        AuxiliarCli cli;
+        if (valorComoTexto.empty())
+        {
+            cli.imprimirLogFormato<NivelLog::Advertencia>("Dato recibido vacío para sensor de %s.", Politica::MAGNITUD);
+            return false;
+        }
+
+        T valor = T();
+        if (!convertirValor(valorComoTexto, valor))
+        {
+            cli.imprimirLogFormato<NivelLog::Advertencia>(
+                "Valor '%.*s' inválido para el sensor %s (%s).",
+                static_cast<int>(valorComoTexto.size() > 40 ? 40 : valorComoTexto.size()), valorComoTexto.data(),
+                nombre, Politica::TIPO);
+            return false;
+        }
+
+        registrarLecturaInterna(valor, marcaMonotonica());
+        return true;
+    }
+
+    /// Registra una lectura numérica si Politica::convertir() la acepta.
+    bool registrarLecturaNumericaEn(double valor, std::int64_t marcaNs) override
+    {
+        T convertido = T();
+        if (!Politica::convertir(valor, convertido))
+        {
+            AuxiliarCli cli;
+            cli.imprimirLogFormato<NivelLog::Advertencia>("Valor %g inválido para el sensor %s (%s).", valor, nombre,
+                                                          Politica::TIPO);
+            return false;
+        }
+
+        registrarLecturaInterna(convertido, marcaNs);
+        return true;
+    }
+
+    /// Registra un lote con un solo log; los valores que Politica::convertir() rechaza se descartan con un solo aviso.
+    std::size_t registrarLoteNumericoEn(const double* valores, const std::int64_t* marcasNs,
+                                        std::size_t cantidad) override
+    {
+        std::size_t rechazadas = 0;
+        std::size_t aceptadas = convertirPorTandas<T>(
+            valores, marcasNs, cantidad, rechazadas, Politica::convertir,
+            [this](const T* tanda, const std::int64_t* marcas, std::size_t enTanda)
+            { anexarTanda(tanda, marcas, enTanda); });
+
+        AuxiliarCli cli;
+        if (rechazadas > 0)
+        {
+            cli.imprimirLogFormato<NivelLog::Advertencia>("Valores %s descartados para el sensor %s (%s): %zu.",
+                                                          Politica::RECHAZADOS, nombre, Politica::TIPO, rechazadas);
+        }
+        if (aceptadas > 0)
+        {
+            cli.imprimirLogFormato<NivelLog::Estado>("Insertando %zu nodo%s %s en %s.", aceptadas,
+                                                     (aceptadas == 1) ? "" : "s", Politica::NODO, nombre);
+        }
+        return aceptadas;
+    }
+
+    /// Promedia las lecturas almacenadas, descartando antes la más baja si la política lo indica.
+    void procesarLectura() override
+    {
+        if (ventana)
+        {
+            ventana->consolidarPendientes();
+            ventana->expirar();
+            procesarHistorial(*ventana);
+        }
+        else
+        {
+            historial.consolidarPendientes();
+            cargarPersistidas<T>(historial);
+            procesarHistorial(historial);
+        }
+    }
+
+    /**
+     * @brief Cambia la política de retención conservando las lecturas más recientes.
+     *
+     * Las lecturas trasladadas conservan su marca de tiempo. No debe llamarse
+     * mientras haya ingesta concurrente activa.
+     */
+    bool establecerRetencion(const PoliticaRetencion& politica) override
+    {
+        AuxiliarCli cli;
+        if (politica.maxLecturas > PoliticaRetencion::MAX_LECTURAS)
+        {
+            cli.imprimirLogFormato<NivelLog::Advertencia>("[%s] Retención de %zu lecturas rechazada (máximo %zu).",
+                                                          nombre, politica.maxLecturas,
+                                                          PoliticaRetencion::MAX_LECTURAS);
+            return false;
+        }
+
+        HistorialVentana<T>* nueva = nullptr;
+        if (politica.maxLecturas > 0)
+        {
+            try
+            {
+                nueva = new HistorialVentana<T>(politica);
+            }
+            catch (const std::bad_alloc&)
+            {
+                cli.imprimirLogFormato<NivelLog::Error>(
+                    "[%s] Sin memoria para una ventana de %zu lecturas; se conserva la retención anterior.", nombre,
+                    politica.maxLecturas);
+                return false;
+            }
+        }
+
+        cargarPersistidas<T>(historial);
+
+        HistorialVentana<T>* anterior = ventana;
+        ventana = nueva;
+
+        T valor = T();
+        std::int64_t marca = 0;
+        if (anterior)
+        {
+            anterior->consolidarPendientes();
+            while (anterior->extraerPrimero(valor, marca))
+            {
+                trasladarLectura(valor, marca);
+            }
+            delete anterior;
+        }
+        else if (ventana)
+        {
+            historial.consolidarPendientes();
+            while (historial.extraerPrimero(valor, marca))
+            {
+                trasladarLectura(valor, marca);
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Resume las lecturas recibidas en [desdeNs, hastaNs) del reloj monotónico.
+     *
+     * Solo consulta: a diferencia de procesarLectura() no elimina ninguna
+     * lectura. Con historial ilimitado usa el índice temporal de la lista.
+     */
+    void procesarRango(std::int64_t desdeNs, std::int64_t hastaNs) override
+    {
+        ResumenRango<T> resumen;
+        if (ventana)
+        {
+            ventana->consolidarPendientes();
+            ventana->expirar();
+            resumen = ventana->resumirRango(desdeNs, hastaNs);
+        }
+        else
+        {
+            historial.consolidarPendientes();
+            cargarPersistidas<T>(historial);
+            resumen = historial.resumirRango(desdeNs, hastaNs);
+        }
+        reportarRango(resumen);
+    }
+
+    /// Incorpora las lecturas pendientes de la ventana y del historial.
+    void consolidarPendientes() override
+    {
+        if (ventana)
+        {
+            ventana->consolidarPendientes();
+        }
+        historial.consolidarPendientes();
+    }
+
+    /// Lecturas en la ventana o en el historial ilimitado.
+    std::size_t lecturasEnMemoria() const override
+    {
+        return static_cast<std::size_t>(ventana ? ventana->contar() : historial.contar());
+    }
+
+    /// Devuelve el historial de una vez (limpiar() suelta los bloques del pool) y la ventana completa.
+    void liberarHistorial(ResumenLiberacion& resumen) override
+    {
+        ++resumen.sensores;
+        resumen.lecturas += lecturasEnMemoria();
+        resumen.bytes += historial.bytesReservados();
+        if (ventana)
+        {
+            resumen.bytes += ventana->bytesReservados();
+            delete ventana;
+            ventana = nullptr;
+        }
+        historial.limpiar();
+        historialLiberado = true;
+    }
+
+protected:
+    /// Inicializa el sensor con el identificador dado.
+    explicit SensorTipado(const char* id) : ventana(nullptr)
+    {
+        asignarNombre(id);
+    }
+
+private:
+    ListaSensor<T> historial;
+    /// Ventana acotada; si existe reemplaza al historial ilimitado.
+    HistorialVentana<T>* ventana;
+
+    /// Valor como double para imprimirlo con Politica::DECIMALES.
+    static double comoDecimal(T valor)
+    {
+        return static_cast<double>(valor);
+    }
+
+    /// Línea del destructor por cada lectura que se libera.
+    void reportarLiberado(AuxiliarCli& cli, T valor)
+    {
+        cli.imprimirLogFormato<NivelLog::Estado>("    Nodo<%s> %.*f liberado.", Politica::TIPO, Politica::DECIMALES,
+                                                 comoDecimal(valor));
+    }
+
+    /// Procesamiento común al historial ilimitado y a la ventana acotada.
+    template <typename Historial>
+    void procesarHistorial(Historial& lecturas)
+    {
+        AuxiliarCli cli;
+        if (lecturas.estaVacia())
+        {
+            cli.imprimirLogFormato<NivelLog::Advertencia>("[%s] No hay lecturas registradas.", nombre);
+            return;
+        }
+
+        if constexpr (Politica::DESCARTAR_MINIMO)
+        {
+            if (lecturas.contar() > 1)
+            {
+                T minimo = T();
+                if (lecturas.eliminarMinimo(minimo))
+                {
+                    cli.imprimirLogFormato<NivelLog::Estado>("[%s] Lectura más baja (%.*f) eliminada.", nombre,
+                                                             Politica::DECIMALES, comoDecimal(minimo));
+                }
+            }
+        }
+
+        int cantidad = lecturas.contar();
+        double promedio = lecturas.promedio();
+
+        cli.imprimirLogFormato<NivelLog::Estado>("%s Promedio calculado sobre %d lectura%s (%.1f).", Politica::ETIQUETA,
+                                                 cantidad, (cantidad == 1) ? "" : "s", promedio);
+    }
+
+    /// Reporta por log el resumen de un intervalo.
+    void reportarRango(const ResumenRango<T>& resumen)
+    {
+        AuxiliarCli cli;
+        if (resumen.cantidad == 0)
+        {
+            cli.imprimirLogFormato<NivelLog::Advertencia>("[%s] No hay lecturas en el intervalo.", nombre);
+            return;
+        }
+        cli.imprimirLogFormato<NivelLog::Estado>(
+            "%s %d lectura%s en el intervalo: promedio %.1f, mínimo %.*f, máximo %.*f.", Politica::ETIQUETA,
+            resumen.cantidad, (resumen.cantidad == 1) ? "" : "s", resumen.promedio(), Politica::DECIMALES,
+            comoDecimal(resumen.minimo), Politica::DECIMALES, comoDecimal(resumen.maximo));
+    }
+
+    /// Agrega sin log una lectura existente al almacenamiento vigente, con su marca original.
+    void trasladarLectura(T valor, std::int64_t marcaNs)
+    {
+        if (ventana)
+        {
+            ventana->insertarEn(valor, marcaNs);
+        }
+        else
+        {
+            historial.insertarAlFinal(valor, marcaNs);
+        }
+    }
+
+    /// Anexa sin log una tanda ya convertida por la vía vigente (ventana o historial, concurrente o no).
+    void anexarTanda(const T* valores, const std::int64_t* marcasNs, std::size_t cantidad)
+    {
+        bool concurrente = ingestaConcurrente.load(std::memory_order_acquire);
+        if (ventana)
+        {
+            if (concurrente)
+            {
+                ventana->insertarLoteConcurrente(valores, marcasNs, cantidad);
+            }
+            else
+            {
+                ventana->insertarLote(valores, marcasNs, cantidad);
+            }
+        }
+        else if (concurrente)
+        {
+            historial.insertarLoteConcurrente(valores, marcasNs, cantidad);
+        }
+        else
+        {
+            historial.insertarLote(valores, marcasNs, cantidad);
+        }
+        persistirLote(valores, marcasNs, cantidad, concurrente);
+    }
+
+    /// Inserta la lectura en el historial y reporta mediante log.
+    void registrarLecturaInterna(T valor, std::int64_t marcaNs)
+    {
+        AuxiliarCli cli;
+        bool concurrente = ingestaConcurrente.load(std::memory_order_acquire);
+        if (ventana)
+        {
+            if (concurrente)
+            {
+                ventana->insertarConcurrente(valor, marcaNs);
+            }
+            else
+            {
+                ventana->insertarEn(valor, marcaNs);
+            }
+        }
+        else if (concurrente)
+        {
+            historial.insertarConcurrente(valor, marcaNs);
+        }
+        else
+        {
+            historial.insertarAlFinal(valor, marcaNs);
+        }
+        persistir(valor, marcaNs, concurrente);
+
+        cli.imprimirLogFormato<NivelLog::Estado>("Insertando nodo %s en %s.", Politica::NODO, nombre);
+    }
+};
+
+#endif
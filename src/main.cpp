@@ -3,37 +3,69 @@
  * @brief Punto de entrada del sistema IoT polimórfico basado en listas enlazadas.
  */
 
+#include <atomic>
+#include <chrono>
 #include <iostream>
+#include <thread>
 #include <cstdio>
 #include <cstddef>
+#include <cstdlib>
 #include <cstring>
-#include <cerrno>
-#include <fcntl.h>
-#include <termios.h>
+#include <poll.h>
 #include <unistd.h>
-#include <sys/select.h>
+#include <sys/stat.h>
+#include "AlmacenHistorial.h"
 #include "AuxiliarCli.h"
+#include "ColaIngesta.h"
+#include "Instrumentacion.h"
 #include "ListaGeneral.h"
+#include "LectorSerial.h"
+#include "MotorIngesta.h"
+#include "RegistroAsincrono.h"
+#include "ReproductorCapturas.h"
 #include "SensorTemperatura.h"
 #include "SensorPresion.h"
 
-/// Longitud máxima permitida para el identificador de un sensor.
-constexpr std::size_t TAM_ID = 50;
-/// Tamaño del buffer usado para leer líneas desde la consola o el puerto serial.
-constexpr std::size_t TAM_SERIAL = 128;
+/// Lecturas en memoria por encima de las cuales el cierre libera en bloque y solo imprime un resumen.
+constexpr std::size_t LECTURAS_CIERRE_DETALLADO = 1000;
 
 void mostrarMenu();
-void recortarEspacios(char* texto);
-bool descomponerLineaSerial(const char* linea, char* id, std::size_t tamId, char* valor, std::size_t tamValor);
 bool registrarDesdeCadenaManual(ListaGeneral& lista, AuxiliarCli& cli);
-bool configurarPuertoSerial(int fd, AuxiliarCli& cli);
+void solicitarConfiguracionPuerto(AuxiliarCli& cli, ConfiguracionPuerto& configuracion);
+void informarTramas(AuxiliarCli& cli, long long recibidas, long long perdidas);
 bool escucharDispositivoSerial(ListaGeneral& lista, AuxiliarCli& cli);
+bool escucharVariosDispositivos(ListaGeneral& lista, AuxiliarCli& cli);
+bool escucharConProcesamientoConcurrente(ListaGeneral& lista, AuxiliarCli& cli);
+bool configurarRetencion(ListaGeneral& lista, AuxiliarCli& cli);
+bool consultarIntervalo(ListaGeneral& lista, AuxiliarCli& cli);
+void mostrarInstrumentacion(AuxiliarCli& cli);
+void abrirAlmacen(AlmacenHistorial& almacen, ListaGeneral& lista, const char* ruta, AuxiliarCli& cli);
+int ejecutarReproduccion(int argc, char** argv);
 
-/** @brief Función principal que gestiona el menú interactivo del sistema. */
-int main()
+/**
+ * @brief Función principal que gestiona el menú interactivo del sistema.
+ *
+ * Con un argumento, éste es el directorio del historial en disco: los
+ * sensores guardados ahí se restauran al arrancar y cada lectura nueva se
+ * anexa a su columna.
+ *
+ * Con --reproducir como primer argumento no hay menú: se reproducen los
+ * archivos de captura indicados (ver ejecutarReproduccion()).
+ */
+int main(int argc, char** argv)
 {
+    if (argc > 1 && std::strcmp(argv[1], "--reproducir") == 0)
+    {
+        return ejecutarReproduccion(argc - 2, argv + 2);
+    }
+
     AuxiliarCli cli;
     ListaGeneral lista;
+    AlmacenHistorial almacen;
+    if (argc > 1)
+    {
+        abrirAlmacen(almacen, lista, argv[1], cli);
+    }
 
     int opcion = 0;
     bool sistemaActivo = true;
@@ -55,6 +87,10 @@ int main()
             {
                 delete nuevo;
             }
+            else if (almacen.estaAbierto())
+            {
+                almacen.adjuntar(*nuevo);
+            }
             break;
         }
         case 2:
@@ -67,20 +103,27 @@ int main()
             {
                 delete nuevo;
             }
+            else if (almacen.estaAbierto())
+            {
+                almacen.adjuntar(*nuevo);
+            }
             break;
         }
         case 3:
         {
             if (lista.estaVacia())
             {
-                cli.imprimirLog("WARNING", "No hay sensores creados para registrar lecturas.");
+                cli.imprimirLog(NivelLog::Advertencia, "No hay sensores creados para registrar lecturas.");
                 break;
             }
 
             int modo = 0;
+            cli.sincronizar();
             std::cout << "\n1. Registrar lectura manual\n";
             std::cout << "2. Registrar lectura desde cadena serial (ingresada aquí)\n";
             std::cout << "3. Escuchar dispositivo serial (ESP32/Arduino)\n";
+            std::cout << "4. Escuchar varios dispositivos a la vez (seriales, pipes o FIFOs)\n";
+            std::cout << "5. Ingesta concurrente con procesamiento periódico\n";
             cli.obtenerDato("Seleccione modo", modo);
 
             if (modo == 1)
@@ -93,7 +136,7 @@ int main()
                 {
                     char mensaje[140];
                     std::snprintf(mensaje, sizeof(mensaje), "Sensor '%s' no se encuentra en la lista.", id);
-                    cli.imprimirLog("WARNING", mensaje);
+                    cli.imprimirLog(NivelLog::Advertencia, mensaje);
                 }
                 else
                 {
@@ -108,28 +151,68 @@ int main()
             {
                 escucharDispositivoSerial(lista, cli);
             }
+            else if (modo == 4)
+            {
+                escucharVariosDispositivos(lista, cli);
+            }
+            else if (modo == 5)
+            {
+                escucharConProcesamientoConcurrente(lista, cli);
+            }
             else
             {
-                cli.imprimirLog("WARNING", "Modo no reconocido.");
+                cli.imprimirLog(NivelLog::Advertencia, "Modo no reconocido.");
             }
             break;
         }
         case 4:
         {
-            cli.imprimirLog("STATUS", "--- Ejecutando Polimorfismo ---");
+            cli.imprimirLog(NivelLog::Estado, "--- Ejecutando Polimorfismo ---");
             lista.procesarSensores();
             break;
         }
         case 5:
         {
-            cli.imprimirLog("STATUS", "--- Liberación de Memoria en Cascada ---");
-            lista.liberar();
-            cli.imprimirLog("SUCCESS", "Sistema cerrado. Memoria limpia.");
+            // Con historiales grandes el detalle por lectura tardaría minutos en consola.
+            if (lista.lecturasEnMemoria() > LECTURAS_CIERRE_DETALLADO)
+            {
+                cli.imprimirLog(NivelLog::Estado, "--- Liberación de Memoria en Bloque ---");
+                lista.liberarEnBloque();
+            }
+            else
+            {
+                cli.imprimirLog(NivelLog::Estado, "--- Liberación de Memoria en Cascada ---");
+                lista.liberar();
+            }
+            cli.imprimirLog(NivelLog::Exito, "Sistema cerrado. Memoria limpia.");
             sistemaActivo = false;
             break;
         }
+        case 6:
+        {
+            PoolTrabajo pool;
+            cli.imprimirLogFormato<NivelLog::Estado>("--- Ejecutando Polimorfismo en paralelo (%u hilos) ---",
+                                                     pool.obtenerHilos());
+            lista.procesarSensoresEnParalelo(pool);
+            break;
+        }
+        case 7:
+        {
+            configurarRetencion(lista, cli);
+            break;
+        }
+        case 8:
+        {
+            consultarIntervalo(lista, cli);
+            break;
+        }
+        case 9:
+        {
+            mostrarInstrumentacion(cli);
+            break;
+        }
         default:
-            cli.imprimirLog("WARNING", "Opción fuera de rango.");
+            cli.imprimirLog(NivelLog::Advertencia, "Opción fuera de rango.");
             break;
         }
     }
@@ -142,84 +225,179 @@ int main()
  */
 void mostrarMenu()
 {
+    AuxiliarCli::sincronizar();
     std::cout << "\n--- Sistema IoT de Monitoreo Polimórfico ---\n";
     std::cout << "1. Crear Sensor (Tipo Temp - FLOAT)\n";
     std::cout << "2. Crear Sensor (Tipo Presion - INT)\n";
     std::cout << "3. Registrar Lectura (Manual o Serial)\n";
     std::cout << "4. Ejecutar Procesamiento Polimórfico\n";
     std::cout << "5. Cerrar Sistema (Liberar Memoria)\n";
+    std::cout << "6. Ejecutar Procesamiento Paralelo (todos los núcleos)\n";
+    std::cout << "7. Configurar Retención de un Sensor (últimas N lecturas / T segundos)\n";
+    std::cout << "8. Consultar Lecturas de un Sensor en un Intervalo de Tiempo\n";
+    std::cout << "9. Ver Instrumentación de la Ingesta (contadores y latencias por etapa)\n";
 }
 
 /**
- * @brief Elimina espacios iniciales y finales de una cadena in situ.
+ * @brief Abre el almacén en disco y restaura sus sensores sin cargar sus lecturas.
  */
-void recortarEspacios(char* texto)
+void abrirAlmacen(AlmacenHistorial& almacen, ListaGeneral& lista, const char* ruta, AuxiliarCli& cli)
 {
-    if (!texto)
+    if (!almacen.abrir(ruta))
     {
+        cli.imprimirLog(NivelLog::Advertencia, "Se continuará sin historial en disco.");
         return;
     }
 
-    std::size_t inicio = 0;
-    while (texto[inicio] == ' ' || texto[inicio] == '\t')
+    int restaurados = almacen.restaurar(lista);
+    if (restaurados >= 0)
     {
-        ++inicio;
+        cli.imprimirLogFormato<NivelLog::Exito>(
+            "Historial en disco '%s': %d sensor%s restaurado%s; sus lecturas se cargan al procesarlos.", ruta,
+            restaurados, (restaurados == 1) ? "" : "es", (restaurados == 1) ? "" : "s");
     }
+}
 
-    if (inicio > 0)
+/**
+ * @brief Modo sin menú: reproduce archivos de captura e imprime rendimiento y latencias.
+ *
+ * Uso: gestion_sensores --reproducir [--ritmo max|real|N] [--sensores T-001,P-105]
+ *                       [--almacen DIR] [--procesar] [--detalle] [--instrumentacion] captura...
+ *
+ * --ritmo max (predeterminado) entrega las lecturas tan rápido como se leen,
+ * N fija N elementos por segundo y real usa la directiva "# tasa:" de cada
+ * captura. Los sensores se crean a partir de --sensores y de las directivas
+ * "# sensores:" de las capturas. Salvo con --detalle, durante la reproducción
+ * solo se registran advertencias y errores para que el log por lectura no
+ * domine la medición; --procesar ejecuta después procesarSensores() con el
+ * nivel de log normal. --instrumentacion agrega al final el reporte por etapa
+ * de Instrumentacion.h.
+ *
+ * @return 0 si todas las capturas se leyeron completas, 1 si alguna falló y 2 ante argumentos inválidos.
+ */
+int ejecutarReproduccion(int argc, char** argv)
+{
+    AuxiliarCli cli;
+    const char* ritmo = "max";
+    const char* sensores = nullptr;
+    const char* rutaAlmacen = nullptr;
+    bool procesar = false;
+    bool detalle = false;
+    bool instrumentar = false;
+    int primeraCaptura = argc;
+    for (int i = 0; i < argc; ++i)
     {
-        std::size_t i = 0;
-        while (texto[inicio + i] != '\0')
+        bool conValor = i + 1 < argc;
+        if (std::strcmp(argv[i], "--ritmo") == 0 && conValor)
         {
-            texto[i] = texto[inicio + i];
-            ++i;
+            ritmo = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--sensores") == 0 && conValor)
+        {
+            sensores = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--almacen") == 0 && conValor)
+        {
+            rutaAlmacen = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--procesar") == 0)
+        {
+            procesar = true;
+        }
+        else if (std::strcmp(argv[i], "--detalle") == 0)
+        {
+            detalle = true;
+        }
+        else if (std::strcmp(argv[i], "--instrumentacion") == 0)
+        {
+            instrumentar = true;
+        }
+        else if (std::strncmp(argv[i], "--", 2) == 0)
+        {
+            cli.imprimirLogFormato<NivelLog::Error>("Opción '%s' desconocida o sin valor.", argv[i]);
+            return 2;
+        }
+        else
+        {
+            primeraCaptura = i;
+            break;
         }
-        texto[i] = '\0';
     }
-
-    int fin = static_cast<int>(std::strlen(texto)) - 1;
-    while (fin >= 0 && (texto[fin] == ' ' || texto[fin] == '\t'))
+    if (primeraCaptura == argc)
     {
-        texto[fin] = '\0';
-        --fin;
+        cli.imprimirLog(NivelLog::Error,
+                        "Uso: --reproducir [--ritmo max|real|N] [--sensores T-001,P-105] [--almacen DIR] "
+                        "[--procesar] [--detalle] [--instrumentacion] captura...");
+        return 2;
     }
-}
 
-/**
- * @brief Separa una línea con formato ID,valor en dos buffers.
- */
-bool descomponerLineaSerial(const char* linea, char* id, std::size_t tamId, char* valor, std::size_t tamValor)
-{
-    if (!linea || !id || !valor)
+    // Todos los argumentos se validan antes de tocar el nivel de log.
+    bool ritmoReal = (std::strcmp(ritmo, "real") == 0);
+    double elementosPorSegundo = 0.0;
+    if (!ritmoReal && std::strcmp(ritmo, "max") != 0)
     {
-        return false;
+        char* fin = nullptr;
+        elementosPorSegundo = std::strtod(ritmo, &fin);
+        if (fin == ritmo || *fin != '\0' || !ReproductorCapturas::ritmoValido(elementosPorSegundo))
+        {
+            cli.imprimirLogFormato<NivelLog::Error>("Ritmo '%s' inválido: use max, real o un número positivo y finito.", ritmo);
+            return 2;
+        }
     }
 
-    std::size_t i = 0;
-    std::size_t j = 0;
-    while (linea[i] != '\0' && linea[i] != ',' && j < tamId - 1)
+    RegistroAsincrono& registro = RegistroAsincrono::instancia();
+    NivelLog nivelAnterior = registro.obtenerNivelMinimo();
+    if (!detalle)
     {
-        id[j++] = linea[i++];
+        registro.establecerNivelMinimo(NivelLog::Advertencia);
     }
-    id[j] = '\0';
 
-    if (linea[i] != ',')
+    ListaGeneral lista;
+    AlmacenHistorial almacen;
+    if (rutaAlmacen)
     {
-        return false;
+        abrirAlmacen(almacen, lista, rutaAlmacen, cli);
     }
-    ++i;
 
-    std::size_t k = 0;
-    while (linea[i] != '\0' && k < tamValor - 1)
+    ReproductorCapturas reproductor(lista, cli, &almacen);
+    if (ritmoReal)
+    {
+        reproductor.usarTasaDeclarada();
+    }
+    else
+    {
+        reproductor.establecerRitmo(elementosPorSegundo);
+    }
+    if (sensores)
     {
-        valor[k++] = linea[i++];
+        reproductor.declararSensores(sensores);
     }
-    valor[k] = '\0';
 
-    recortarEspacios(id);
-    recortarEspacios(valor);
+    int fallidas = 0;
+    for (int i = primeraCaptura; i < argc; ++i)
+    {
+        if (!reproductor.reproducir(argv[i]))
+        {
+            ++fallidas;
+        }
+    }
+    reproductor.imprimirEstadisticas();
+    if (instrumentar)
+    {
+        std::printf("\n");
+        Instrumentacion::instancia().imprimir(stdout);
+        std::fflush(stdout);
+    }
 
-    return (id[0] != '\0' && valor[0] != '\0');
+    if (procesar)
+    {
+        registro.establecerNivelMinimo(nivelAnterior);
+        lista.procesarSensores();
+    }
+    lista.liberarEnBloque();
+    registro.establecerNivelMinimo(nivelAnterior);
+    AuxiliarCli::sincronizar();
+    return (fallidas == 0) ? 0 : 1;
 }
 
 /**
@@ -230,182 +408,459 @@ bool registrarDesdeCadenaManual(ListaGeneral& lista, AuxiliarCli& cli)
     char linea[TAM_SERIAL] = {0};
     cli.obtenerCadena("Cadena recibida (ID,valor)", linea, TAM_SERIAL);
 
-    char id[TAM_ID] = {0};
-    char valorCadena[40] = {0};
-    if (!descomponerLineaSerial(linea, id, TAM_ID, valorCadena, sizeof(valorCadena)))
+    LineaSerial campos;
+    if (!analizarLineaSerial(linea, std::strlen(linea), campos))
     {
-        cli.imprimirLog("WARNING", "Formato inválido. Usa el patrón ID,valor.");
+        cli.imprimirLog(NivelLog::Advertencia, "Formato inválido. Usa el patrón ID,valor.");
         return false;
     }
 
-    SensorBase* sensor = lista.buscarPorNombre(id);
+    SensorBase* sensor = lista.buscarPorNombre(campos.id.data(), campos.id.size());
     if (!sensor)
     {
         char mensaje[140];
-        std::snprintf(mensaje, sizeof(mensaje), "Sensor '%s' no registrado en la lista general.", id);
-        cli.imprimirLog("WARNING", mensaje);
+        std::snprintf(mensaje, sizeof(mensaje), "Sensor '%.*s' no registrado en la lista general.",
+                      static_cast<int>(campos.id.size()), campos.id.data());
+        cli.imprimirLog(NivelLog::Advertencia, mensaje);
         return false;
     }
 
-    sensor->registrarLecturaDesdeCadena(valorCadena);
-    return true;
+    return sensor->registrarLecturaDesdeTexto(campos.valor);
 }
 
 /**
- * @brief Configura un puerto serial abierto a 9600 baudios con parámetros básicos.
+ * @brief Pide un sensor y un intervalo relativo a ahora y reporta sus lecturas en él.
+ *
+ * El intervalo se indica en segundos hacia atrás: de "hace 300" a "hace 0"
+ * cubre los últimos cinco minutos.
  */
-bool configurarPuertoSerial(int fd, AuxiliarCli& cli)
+bool consultarIntervalo(ListaGeneral& lista, AuxiliarCli& cli)
 {
-    struct termios opciones;
-    if (tcgetattr(fd, &opciones) != 0)
+    char id[TAM_ID] = {0};
+    cli.obtenerCadena("ID del sensor", id, TAM_ID);
+
+    SensorBase* sensor = lista.buscarPorNombre(id);
+    if (!sensor)
     {
-        cli.imprimirLog("WARNING", "No se pudo obtener la configuración del puerto serial.");
+        cli.imprimirLogFormato<NivelLog::Advertencia>("Sensor '%s' no se encuentra en la lista.", id);
         return false;
     }
 
-    cfsetispeed(&opciones, B9600);
-    cfsetospeed(&opciones, B9600);
+    double haceInicio = -1.0;
+    cli.obtenerDato("Inicio: hace cuántos segundos", haceInicio);
+    double haceFin = -1.0;
+    cli.obtenerDato("Fin: hace cuántos segundos (0 = ahora)", haceFin);
+    if (haceInicio < 0.0 || haceFin < 0.0 || haceInicio <= haceFin)
+    {
+        cli.imprimirLog(NivelLog::Advertencia, "El inicio debe ser anterior al fin y ninguno negativo.");
+        return false;
+    }
+
+    // El fin es exclusivo; con "hace 0" se suma un nanosegundo para incluir la lectura recién llegada.
+    std::int64_t ahora = marcaMonotonica();
+    std::int64_t desde = ahora - static_cast<std::int64_t>(haceInicio * 1e9);
+    std::int64_t hasta = ahora - static_cast<std::int64_t>(haceFin * 1e9) + 1;
+    sensor->procesarRango(desde, hasta);
+    return true;
+}
+
+/**
+ * @brief Pide al usuario la política de retención de un sensor y la aplica.
+ */
+bool configurarRetencion(ListaGeneral& lista, AuxiliarCli& cli)
+{
+    char id[TAM_ID] = {0};
+    cli.obtenerCadena("ID del sensor", id, TAM_ID);
 
-    opciones.c_cflag = CS8 | CLOCAL | CREAD;
-    opciones.c_iflag = IGNPAR;
-    opciones.c_oflag = 0;
-    opciones.c_lflag = 0;
-    opciones.c_cc[VMIN] = 0;
-    opciones.c_cc[VTIME] = 10;
+    SensorBase* sensor = lista.buscarPorNombre(id);
+    if (!sensor)
+    {
+        char mensaje[140];
+        std::snprintf(mensaje, sizeof(mensaje), "Sensor '%s' no se encuentra en la lista.", id);
+        cli.imprimirLog(NivelLog::Advertencia, mensaje);
+        return false;
+    }
 
-    if (tcsetattr(fd, TCSANOW, &opciones) != 0)
+    long long maxLecturas = -1;
+    cli.obtenerDato("Lecturas a conservar (0 = sin límite)", maxLecturas);
+    double maxSegundos = -1.0;
+    cli.obtenerDato("Antigüedad máxima en segundos (0 = sin límite)", maxSegundos);
+    if (maxLecturas < 0 || maxSegundos < 0.0)
     {
-        cli.imprimirLog("WARNING", "No se pudo establecer la configuración del puerto serial.");
+        cli.imprimirLog(NivelLog::Advertencia, "Los límites de retención no pueden ser negativos.");
+        return false;
+    }
+    if (maxLecturas == 0 && maxSegundos > 0.0)
+    {
+        cli.imprimirLog(NivelLog::Advertencia, "La retención por tiempo requiere también un máximo de lecturas.");
+        return false;
+    }
+    if (static_cast<unsigned long long>(maxLecturas) > PoliticaRetencion::MAX_LECTURAS)
+    {
+        cli.imprimirLogFormato<NivelLog::Advertencia>("Se pueden conservar como máximo %zu lecturas por sensor.",
+                                                      PoliticaRetencion::MAX_LECTURAS);
         return false;
     }
 
-    tcflush(fd, TCIOFLUSH);
+    PoliticaRetencion politica;
+    politica.maxLecturas = static_cast<std::size_t>(maxLecturas);
+    politica.maxSegundos = maxSegundos;
+    if (!sensor->establecerRetencion(politica))
+    {
+        return false;
+    }
+
+    if (maxLecturas == 0)
+    {
+        cli.imprimirLogFormato<NivelLog::Exito>("Sensor %s sin límite de retención.", id);
+    }
+    else if (maxSegundos > 0.0)
+    {
+        cli.imprimirLogFormato<NivelLog::Exito>("Sensor %s conserva las últimas %lld lecturas de los últimos %.1f s.",
+                                                id, maxLecturas, maxSegundos);
+    }
+    else
+    {
+        cli.imprimirLogFormato<NivelLog::Exito>("Sensor %s conserva las últimas %lld lecturas.", id, maxLecturas);
+    }
     return true;
 }
 
+/**
+ * @brief Imprime contadores y latencias por etapa y permite activar o detener su volcado periódico a archivo.
+ */
+void mostrarInstrumentacion(AuxiliarCli& cli)
+{
+    Instrumentacion& instrumentacion = Instrumentacion::instancia();
+    AuxiliarCli::sincronizar();
+    instrumentacion.imprimir(stdout);
+    std::fflush(stdout);
+    if (!Instrumentacion::compilada())
+    {
+        return;
+    }
+
+    if (instrumentacion.volcadoActivo())
+    {
+        cli.imprimirLogFormato<NivelLog::Estado>("Volcado periódico activo en '%s'.", instrumentacion.obtenerRutaVolcado());
+    }
+    int segundos = -1;
+    cli.obtenerDato("Volcado periódico: segundos entre reportes (0 = detener o no activar)", segundos);
+    if (segundos <= 0)
+    {
+        if (instrumentacion.volcadoActivo())
+        {
+            instrumentacion.detenerVolcado();
+            cli.imprimirLog(NivelLog::Exito, "Volcado periódico detenido.");
+        }
+        return;
+    }
+
+    char ruta[256] = {0};
+    cli.obtenerCadena("Archivo de volcado (se anexa)", ruta, sizeof(ruta));
+    if (!instrumentacion.iniciarVolcado(ruta, segundos))
+    {
+        cli.imprimirLogFormato<NivelLog::Advertencia>("No se pudo iniciar el volcado en '%s'.", ruta);
+        return;
+    }
+    cli.imprimirLogFormato<NivelLog::Exito>("Instrumentación anexada a '%s' cada %d s.", ruta, segundos);
+}
+
+/**
+ * @brief Pide la velocidad, VMIN/VTIME y el modo de baja latencia para un puerto serial.
+ *
+ * Un VMIN o VTIME fuera de 0..255 no cabe en c_cc; se avisa y se conserva el
+ * valor por omisión.
+ */
+void solicitarConfiguracionPuerto(AuxiliarCli& cli, ConfiguracionPuerto& configuracion)
+{
+    int baudios = 0;
+    cli.obtenerDato("Velocidad en baudios (9600, 115200, 230400, 921600...)", baudios);
+
+    speed_t velocidad;
+    if (velocidadTermios(baudios, velocidad))
+    {
+        configuracion.baudios = baudios;
+    }
+    else
+    {
+        cli.imprimirLog(NivelLog::Advertencia, "Velocidad no estándar; se usarán 9600 baudios.");
+        configuracion.baudios = 9600;
+    }
+
+    int vmin = -1;
+    cli.obtenerDato("VMIN: bytes mínimos por lectura (0-255)", vmin);
+    if (vmin >= 0 && vmin <= ConfiguracionPuerto::MAX_VMIN_VTIME)
+    {
+        configuracion.vmin = vmin;
+    }
+    else
+    {
+        cli.imprimirLogFormato<NivelLog::Advertencia>("VMIN fuera de rango; se usará %d.", configuracion.vmin);
+    }
+
+    int vtime = -1;
+    cli.obtenerDato("VTIME: espera máxima en décimas de segundo (0-255)", vtime);
+    if (vtime >= 0 && vtime <= ConfiguracionPuerto::MAX_VMIN_VTIME)
+    {
+        configuracion.vtime = vtime;
+    }
+    else
+    {
+        cli.imprimirLogFormato<NivelLog::Advertencia>("VTIME fuera de rango; se usará %d.", configuracion.vtime);
+    }
+
+    int bajaLatencia = 0;
+    cli.obtenerDato("Modo de baja latencia (1 = sí, 0 = no)", bajaLatencia);
+    configuracion.bajaLatencia = (bajaLatencia == 1);
+}
+
+/**
+ * @brief Resume las tramas binarias recibidas, si las hubo.
+ */
+void informarTramas(AuxiliarCli& cli, long long recibidas, long long perdidas)
+{
+    if (recibidas == 0 && perdidas == 0)
+    {
+        return;
+    }
+    cli.imprimirLogFormato<NivelLog::Estado>("Tramas binarias: %lld recibidas, %lld perdidas según la secuencia.",
+                                             recibidas, perdidas);
+}
+
 /**
  * @brief Lee lecturas continuas desde un puerto serial hasta que se pulse ENTER o se desconecte.
+ *
+ * Este hilo lee, analiza y enruta; las lecturas pasan por una ColaIngesta a
+ * un hilo consumidor que las inserta, para que un log o una inserción lentos
+ * no dejen de vaciar el buffer del tty.
  */
 bool escucharDispositivoSerial(ListaGeneral& lista, AuxiliarCli& cli)
 {
     char ruta[80] = {0};
     cli.obtenerCadena("Ruta del puerto serial (ej. /dev/ttyUSB0)", ruta, sizeof(ruta));
 
-    int fd = open(ruta, O_RDONLY | O_NOCTTY | O_NONBLOCK);
-    if (fd == -1)
+    ConfiguracionPuerto configuracion;
+    solicitarConfiguracionPuerto(cli, configuracion);
+
+    MotorIngesta motor(lista, cli);
+    if (!motor.agregarDispositivo(ruta, configuracion))
     {
-        cli.imprimirLog("WARNING", "No se pudo abrir el puerto. Cierra otros monitores y verifica la ruta.");
         return false;
     }
+    ColaIngesta cola;
+    ConsumidorIngesta consumidor(cola);
+    ColaIngesta* destino = colaParaLectores(cola, consumidor, cli);
+    motor.establecerCola(destino);
+
+    cli.imprimirLog(NivelLog::Advertencia, "Cierra cualquier monitor serial antes de continuar.");
+    cli.imprimirLog(NivelLog::Estado, "Leyendo datos del puerto. Pulsa ENTER para detener o desconecta el dispositivo.");
+
+    motor.vigilarDetencion(STDIN_FILENO);
+    motor.ejecutar();
+    consumidor.detener();
+    informarTramas(cli, motor.obtenerTramasRecibidas(), motor.obtenerTramasPerdidas());
+    if (destino)
+    {
+        informarCola(cli, cola, consumidor);
+    }
+    return true;
+}
 
-    if (!configurarPuertoSerial(fd, cli))
+/**
+ * @brief Atiende varios puertos, pipes o FIFOs a la vez hasta que se pulse ENTER o se cierren todos.
+ *
+ * Como en escucharDispositivoSerial(), la inserción ocurre en un hilo consumidor aparte.
+ */
+bool escucharVariosDispositivos(ListaGeneral& lista, AuxiliarCli& cli)
+{
+    int cantidad = 0;
+    cli.obtenerDato("Número de dispositivos", cantidad);
+    if (cantidad <= 0 || cantidad > MotorIngesta::MAX_FUENTES)
     {
-        close(fd);
+        cli.imprimirLog(NivelLog::Advertencia, "Cantidad de dispositivos fuera de rango.");
         return false;
     }
 
-    cli.imprimirLog("WARNING", "Cierra cualquier monitor serial antes de continuar.");
-    cli.imprimirLog("STATUS", "Leyendo datos del puerto. Pulsa ENTER para detener o desconecta el dispositivo.");
+    MotorIngesta motor(lista, cli);
+    for (int i = 0; i < cantidad; ++i)
+    {
+        char ruta[80] = {0};
+        cli.obtenerCadena("Ruta del dispositivo", ruta, sizeof(ruta));
 
-    bool leyendo = true;
-    char linea[TAM_SERIAL] = {0};
-    std::size_t posicion = 0;
+        ConfiguracionPuerto configuracion;
+        struct stat info;
+        if (stat(ruta, &info) == 0 && S_ISCHR(info.st_mode))
+        {
+            solicitarConfiguracionPuerto(cli, configuracion);
+        }
+        motor.agregarDispositivo(ruta, configuracion);
+    }
 
-    while (leyendo)
+    if (motor.fuentesActivas() == 0)
     {
-        fd_set conjuntoLectura;
-        FD_ZERO(&conjuntoLectura);
-        FD_SET(fd, &conjuntoLectura);
-        FD_SET(STDIN_FILENO, &conjuntoLectura);
-        int maximo = (fd > STDIN_FILENO) ? fd : STDIN_FILENO;
+        cli.imprimirLog(NivelLog::Advertencia, "No se pudo abrir ningún dispositivo.");
+        return false;
+    }
 
-        int resultado = select(maximo + 1, &conjuntoLectura, nullptr, nullptr, nullptr);
-        if (resultado < 0)
+    ColaIngesta cola;
+    ConsumidorIngesta consumidor(cola);
+    ColaIngesta* destino = colaParaLectores(cola, consumidor, cli);
+    motor.establecerCola(destino);
+
+    char mensaje[140];
+    std::snprintf(mensaje, sizeof(mensaje), "Escuchando %d dispositivo%s. Pulsa ENTER para detener.",
+                  motor.fuentesActivas(), (motor.fuentesActivas() == 1) ? "" : "s");
+    cli.imprimirLog(NivelLog::Estado, mensaje);
+
+    motor.vigilarDetencion(STDIN_FILENO);
+    motor.ejecutar();
+    consumidor.detener();
+    long long lineas =
+        destino ? static_cast<long long>(consumidor.obtenerRegistradas()) : motor.obtenerLineasTotales();
+
+    std::snprintf(mensaje, sizeof(mensaje), "Ingesta finalizada: %lld lectura%s registrada%s.",
+                  lineas, (lineas == 1) ? "" : "s", (lineas == 1) ? "" : "s");
+    cli.imprimirLog(NivelLog::Exito, mensaje);
+    informarTramas(cli, motor.obtenerTramasRecibidas(), motor.obtenerTramasPerdidas());
+    if (destino)
+    {
+        informarCola(cli, cola, consumidor);
+    }
+    return true;
+}
+
+/**
+ * @brief Ingiere de cada dispositivo en un hilo propio mientras este hilo procesa a intervalos.
+ *
+ * Cada hilo lee y enruta su dispositivo y publica las lecturas en una
+ * ColaIngesta común; un hilo consumidor las inserta por lotes sin candados
+ * (ListaSensor::insertarConcurrente) y procesarSensores() las consolida en
+ * cada ciclo, así que ni la lectura espera a la inserción ni ésta al
+ * procesamiento. Termina con ENTER o cuando se cierran todas las fuentes.
+ */
+bool escucharConProcesamientoConcurrente(ListaGeneral& lista, AuxiliarCli& cli)
+{
+    int cantidad = 0;
+    cli.obtenerDato("Número de dispositivos", cantidad);
+    if (cantidad <= 0 || cantidad > MotorIngesta::MAX_FUENTES)
+    {
+        cli.imprimirLog(NivelLog::Advertencia, "Cantidad de dispositivos fuera de rango.");
+        return false;
+    }
+
+    int intervalo = 0;
+    cli.obtenerDato("Segundos entre procesamientos", intervalo);
+    if (intervalo <= 0)
+    {
+        cli.imprimirLog(NivelLog::Advertencia, "El intervalo debe ser positivo; se usará 1 segundo.");
+        intervalo = 1;
+    }
+
+    MotorIngesta* motores[MotorIngesta::MAX_FUENTES];
+    int abiertos = 0;
+    for (int i = 0; i < cantidad; ++i)
+    {
+        char ruta[80] = {0};
+        cli.obtenerCadena("Ruta del dispositivo", ruta, sizeof(ruta));
+
+        ConfiguracionPuerto configuracion;
+        struct stat info;
+        if (stat(ruta, &info) == 0 && S_ISCHR(info.st_mode))
         {
-            if (errno == EINTR)
-            {
-                continue;
-            }
-            cli.imprimirLog("WARNING", "Select interrumpido, se detiene la lectura serial.");
-            break;
+            solicitarConfiguracionPuerto(cli, configuracion);
         }
 
-        if (FD_ISSET(STDIN_FILENO, &conjuntoLectura))
+        MotorIngesta* motor = new MotorIngesta(lista, cli);
+        if (motor->agregarDispositivo(ruta, configuracion))
         {
-            char descarte[8];
-            if (fgets(descarte, sizeof(descarte), stdin) != nullptr)
-            {
-                cli.imprimirLog("STATUS", "Lectura serial detenida por el usuario.");
-                leyendo = false;
-            }
+            motores[abiertos++] = motor;
         }
+        else
+        {
+            delete motor;
+        }
+    }
 
-        if (!leyendo)
+    int control[2];
+    if (abiertos == 0 || pipe(control) != 0)
+    {
+        cli.imprimirLog(NivelLog::Advertencia, "No se pudo abrir ningún dispositivo.");
+        for (int i = 0; i < abiertos; ++i)
         {
-            break;
+            delete motores[i];
         }
+        return false;
+    }
 
-        if (FD_ISSET(fd, &conjuntoLectura))
+    // Cerrar el extremo de escritura deja el de lectura en fin de archivo para
+    // todos los motores a la vez; así se detienen los hilos de ingesta.
+    lista.establecerIngestaConcurrente(true);
+    ColaIngesta cola;
+    ConsumidorIngesta consumidor(cola);
+    ColaIngesta* destino = colaParaLectores(cola, consumidor, cli);
+    std::atomic<int> hilosActivos(abiertos);
+    std::thread hilos[MotorIngesta::MAX_FUENTES];
+    for (int i = 0; i < abiertos; ++i)
+    {
+        motores[i]->establecerCola(destino);
+        motores[i]->vigilarDetencion(control[0]);
+        MotorIngesta* motor = motores[i];
+        hilos[i] = std::thread([motor, &hilosActivos]()
         {
-            char byteLeido = 0;
-            ssize_t cantidad = read(fd, &byteLeido, 1);
-            if (cantidad > 0)
-            {
-                if (byteLeido == '\r')
-                {
-                    continue;
-                }
+            motor->ejecutar();
+            hilosActivos.fetch_sub(1, std::memory_order_release);
+        });
+    }
 
-                if (byteLeido == '\n')
-                {
-                    if (posicion > 0)
-                    {
-                        linea[posicion] = '\0';
-                        char id[TAM_ID] = {0};
-                        char valorCadena[40] = {0};
-
-                        if (descomponerLineaSerial(linea, id, TAM_ID, valorCadena, sizeof(valorCadena)))
-                        {
-                            SensorBase* sensor = lista.buscarPorNombre(id);
-                            if (sensor)
-                            {
-                                sensor->registrarLecturaDesdeCadena(valorCadena);
-                            }
-                            else
-                            {
-                                char mensaje[160];
-                                std::snprintf(mensaje, sizeof(mensaje), "Sensor '%s' no se encuentra en la lista.", id);
-                                cli.imprimirLog("WARNING", mensaje);
-                            }
-                        }
-                        else
-                        {
-                            cli.imprimirLog("WARNING", "Lectura serial ignorada: formato incorrecto.");
-                        }
-                    }
-                    posicion = 0;
-                }
-                else
-                {
-                    if (posicion < sizeof(linea) - 1)
-                    {
-                        linea[posicion++] = byteLeido;
-                    }
-                }
-            }
-            else if (cantidad == 0)
-            {
-                cli.imprimirLog("STATUS", "No se reciben datos; posible desconexión del dispositivo.");
-                leyendo = false;
-            }
-            else if (errno != EAGAIN && errno != EWOULDBLOCK)
+    cli.imprimirLogFormato<NivelLog::Estado>("Ingesta concurrente en %d hilo%s; procesamiento cada %d s. Pulsa ENTER para detener.",
+                                             abiertos, (abiertos == 1) ? "" : "s", intervalo);
+
+    auto siguienteCiclo = std::chrono::steady_clock::now() + std::chrono::seconds(intervalo);
+    struct pollfd entrada = {STDIN_FILENO, POLLIN, 0};
+    while (hilosActivos.load(std::memory_order_acquire) > 0)
+    {
+        if (poll(&entrada, 1, 200) > 0)
+        {
+            char descarte[64];
+            if (!fgets(descarte, sizeof(descarte), stdin))
             {
-                cli.imprimirLog("WARNING", "Lectura serial interrumpida por un error.");
-                leyendo = false;
+                clearerr(stdin);
             }
+            break;
+        }
+
+        if (std::chrono::steady_clock::now() >= siguienteCiclo)
+        {
+            cli.imprimirLog(NivelLog::Estado, "--- Procesamiento periódico ---");
+            lista.procesarSensores();
+            siguienteCiclo += std::chrono::seconds(intervalo);
         }
     }
 
-    close(fd);
+    close(control[1]);
+    long long tramasRecibidas = 0;
+    long long tramasPerdidas = 0;
+    long long lineasDirectas = 0;
+    for (int i = 0; i < abiertos; ++i)
+    {
+        hilos[i].join();
+        tramasRecibidas += motores[i]->obtenerTramasRecibidas();
+        tramasPerdidas += motores[i]->obtenerTramasPerdidas();
+        lineasDirectas += motores[i]->obtenerLineasTotales();
+        delete motores[i];
+    }
+    close(control[0]);
+    consumidor.detener();
+    lista.establecerIngestaConcurrente(false);
+    long long lineas = destino ? static_cast<long long>(consumidor.obtenerRegistradas()) : lineasDirectas;
+
+    cli.imprimirLogFormato<NivelLog::Exito>("Ingesta concurrente finalizada: %lld lectura%s registrada%s.",
+                                            lineas, (lineas == 1) ? "" : "s", (lineas == 1) ? "" : "s");
+    informarTramas(cli, tramasRecibidas, tramasPerdidas);
+    if (destino)
+    {
+        informarCola(cli, cola, consumidor);
+    }
     return true;
 }